@@ -10,12 +10,14 @@ if( "${CMAKE_BUILD_TYPE}" STREQUAL "" )
 endif()
 
 define_default( PLUGIN_VERSION  4 )
+define_default( CMS_MAXNODES    64 )
 define_default( ENABLE_FUSE     TRUE )
 define_default( ENABLE_CRYPTO   TRUE )
 define_default( ENABLE_KRB5     TRUE )
 define_default( ENABLE_READLINE TRUE )
 define_default( ENABLE_XRDCL    TRUE )
 define_default( ENABLE_TESTS    FALSE )
+define_default( ENABLE_BENCHMARKS FALSE )
 define_default( ENABLE_HTTP     TRUE )
 define_default( ENABLE_CEPH     TRUE )
 define_default( ENABLE_PYTHON   TRUE )
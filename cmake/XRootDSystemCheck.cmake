@@ -80,6 +80,12 @@ if( NOT MacOSX )
   endif()
 endif()
 
+#-------------------------------------------------------------------------------
+# Sendmmsg
+#-------------------------------------------------------------------------------
+check_function_exists( sendmmsg HAVE_SENDMMSG )
+compiler_define_if_found( HAVE_SENDMMSG HAVE_SENDMMSG )
+
 #-------------------------------------------------------------------------------
 # Check for libcrypt
 #-------------------------------------------------------------------------------
@@ -94,6 +100,14 @@ if( NOT HAVE_CRYPT AND NOT HAVE_CRYPT_IN_CRYPT )
   set( CRYPT_LIBRARY "" )
 endif()
 
+#-------------------------------------------------------------------------------
+# io_uring (we use the system calls directly, liburing is not needed)
+#-------------------------------------------------------------------------------
+if( Linux )
+  check_include_file( linux/io_uring.h HAVE_IO_URING )
+  compiler_define_if_found( HAVE_IO_URING HAVE_IO_URING )
+endif()
+
 check_include_file( et/com_err.h HAVE_ET_COM_ERR_H )
 compiler_define_if_found( HAVE_ET_COM_ERR_H HAVE_ET_COM_ERR_H )
 
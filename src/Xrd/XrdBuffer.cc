@@ -34,6 +34,8 @@
 #endif
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sched.h>
 #include <sys/types.h>
 
 #include "XrdOuc/XrdOucUtils.hh"
@@ -46,6 +48,63 @@
 #define XRD_TRACE XrdTrace->
 #include "Xrd/XrdTrace.hh"
 
+/******************************************************************************/
+/*                            X r d B u f f M a g                             */
+/******************************************************************************/
+
+// A per-thread magazine of buffers. Magazines are used by the owning thread
+// and are registered with the manager so that the reshaper can take their
+// buffers back when memory must be trimmed. The magazine lock is therefore
+// only contended while the reshaper runs. When the thread exits the magazine
+// is unregistered and its buffers are given back to the shared pools.
+//
+class XrdBuffMag
+{
+public:
+
+XrdSysMutex     mMutex;
+XrdBuffMag     *prev;     // Registry of magazines, protected by magMutex
+XrdBuffMag     *next;
+XrdBuffManager *bMgr;
+XrdBuffer      *bnext[XRD_BUCKETS];
+int             numbuf[XRD_BUCKETS];
+int             numreq[XRD_BUCKETS];
+long long       numbytes; // Bytes held over all buckets
+int             nreq;     // Requests since last fold
+int             nhit;     // Hits     since last fold
+
+static void     Retire(void *magP);
+
+                XrdBuffMag(XrdBuffManager *bmP)
+                          : prev(0), next(0), bMgr(bmP), numbytes(0),
+                            nreq(0), nhit(0)
+                          {memset(bnext,  0, sizeof(bnext));
+                           memset(numbuf, 0, sizeof(numbuf));
+                           memset(numreq, 0, sizeof(numreq));
+                          }
+               ~XrdBuffMag() {}
+};
+
+/******************************************************************************/
+
+void XrdBuffMag::Retire(void *magP)
+{
+   XrdBuffMag *mP = static_cast<XrdBuffMag *>(magP);
+
+// The thread is going away, remove the magazine from the registry so that
+// nobody else can get at it and return all of its buffers and statistics.
+//
+   mP->bMgr->magMutex.Lock();
+   if (mP->prev) mP->prev->next = mP->next;
+      else mP->bMgr->magList = mP->next;
+   if (mP->next) mP->next->prev = mP->prev;
+   mP->bMgr->magMutex.UnLock();
+
+   mP->bMgr->Flush(mP);
+   mP->bMgr->Fold(mP);
+   delete mP;
+}
+  
 /******************************************************************************/
 /*                     E x t e r n a l   L i n k a g e s                      */
 /******************************************************************************/
@@ -66,6 +125,14 @@ const char *XrdBuffManager::TraceID = "BuffManager";
 namespace
 {
 static const int minBuffSz = 1 << XRD_BUSHIFT;
+
+// A magazine holds up to magMax buffers of a bucket but no more than magBytes
+// worth of buffers over all buckets so that a thread cannot hoard memory.
+//
+static const int magMax   = 8;
+static const int magBytes = 2*1024*1024;
+static const int magFold  = 16;   // Requests between statistics folds
+static const int maxNodes = 64;
 }
 
 namespace XrdGlobal
@@ -95,6 +162,8 @@ XrdBuffManager::XrdBuffManager(XrdSysError *lP, XrdOucTrace *tP, int minrst) :
    totreq   = 0;
    totalo   = 0;
    totadj   = 0;
+   totmreq  = 0;
+   totmhit  = 0;
 #ifdef _SC_PHYS_PAGES
    maxalo   = static_cast<long long>(pagsz)/8
               * static_cast<long long>(sysconf(_SC_PHYS_PAGES));
@@ -103,7 +172,22 @@ XrdBuffManager::XrdBuffManager(XrdSysError *lP, XrdOucTrace *tP, int minrst) :
 #endif
    rsinprog = 0;
    minrsw   = minrst;
-   memset(static_cast<void *>(bucket), 0, sizeof(bucket));
+   memset(static_cast<void *>(numreq), 0, sizeof(numreq));
+
+// Create one pool per NUMA node
+//
+   NumaInit();
+   pool = new BuffPool[numNodes];
+   for (int n = 0; n < numNodes; n++)
+       {memset(static_cast<void *>(pool[n].bucket), 0, sizeof(pool[n].bucket));
+        pool[n].numrmt = 0;
+       }
+
+// Create the key for the per-thread magazines. Without it all requests are
+// handled by the pools.
+//
+   magList = 0;
+   magOn   = (pthread_key_create(&magKey, XrdBuffMag::Retire) == 0);
 }
 
 /******************************************************************************/
@@ -114,13 +198,16 @@ XrdBuffManager::~XrdBuffManager()
 {
    XrdBuffer *bP;
 
+   for (int n = 0; n < numNodes; n++)
    for (int i = 0; i < XRD_BUCKETS; i++)
-       {while((bP = bucket[i].bnext))
-             {bucket[i].bnext = bP->next;
+       {while((bP = pool[n].bucket[i].bnext))
+             {pool[n].bucket[i].bnext = bP->next;
               delete bP;
              }
-        bucket[i].numbuf = 0;
+        pool[n].bucket[i].numbuf = 0;
        }
+   delete [] pool;
+   if (cpu2node) delete [] cpu2node;
 }
 
 /******************************************************************************/
@@ -132,6 +219,16 @@ void XrdBuffManager::Init()
    pthread_t tid;
    int rc;
 
+// Tell everyone how we are organized
+//
+   if (numNodes > 1)
+      {char buff[32];
+       snprintf(buff, sizeof(buff), "%d", numNodes);
+       XrdLog->Say("Config using ", buff, " NUMA node buffer pools.");
+      }
+   if (!magOn)
+      XrdLog->Say("Config warning: per-thread buffer caching disabled.");
+
 // Start the reshaper thread
 //
    if ((rc = XrdSysThread::Run(&tid, XrdReshaper, static_cast<void *>(this), 0,
@@ -145,9 +242,10 @@ void XrdBuffManager::Init()
   
 XrdBuffer *XrdBuffManager::Obtain(int sz)
 {
+   XrdBuffMag *mP;
    XrdBuffer *bp;
    char *memp;
-   int mk, pk, bindex;
+   int mk, pk, bindex, bnode;
 
 // Make sure the request is within our limits
 //
@@ -162,20 +260,34 @@ XrdBuffer *XrdBuffManager::Obtain(int sz)
    if (mk < sz) {bindex++; mk = mk << 1;}
    if (bindex >= slots) return 0;    // Should never happen!
 
-// Obtain a lock on the bucket array and try to give away an existing buffer
+// Try to give away a buffer from this thread's magazine. Its lock is only
+// contended while the reshaper reclaims buffers. Statistics are kept locally
+// and periodically folded into the global ones.
 //
-    Reshaper.Lock();
-    totreq++;
-    bucket[bindex].numreq++;
-    if ((bp = bucket[bindex].bnext))
-       {bucket[bindex].bnext = bp->next; bucket[bindex].numbuf--;}
-    Reshaper.UnLock();
+   if ((mP = getMag()))
+      {mP->mMutex.Lock();
+       mP->numreq[bindex]++;
+       if ((bp = mP->bnext[bindex]))
+          {mP->bnext[bindex] = bp->next; mP->numbuf[bindex]--;
+           mP->numbytes -= bp->bsize;    mP->nhit++;
+          }
+       if (++mP->nreq >= magFold) Fold(mP);
+       mP->mMutex.UnLock();
+       if (bp) return bp;
+      } else {
+       Reshaper.Lock();
+       totreq++;
+       numreq[bindex]++;
+       Reshaper.UnLock();
+      }
 
-// Check if we really allocated a buffer
+// Try to give away an existing buffer from the pool of our node
 //
-   if (bp) return bp;
+   bnode = getNode();
+   if ((bp = Pool(bnode, bindex))) return bp;
 
-// Allocate a chunk of aligned memory
+// Allocate a chunk of aligned memory. It will be placed on our node when we
+// first touch it.
 //
    pk = (mk < pagsz ? mk : pagsz);
    if (!(memp = static_cast<char *>(memalign(pk, mk)))) return 0;
@@ -183,6 +295,7 @@ XrdBuffer *XrdBuffManager::Obtain(int sz)
 // Wrap the memory with a buffer object
 //
    if (!(bp = new XrdBuffer(memp, mk, bindex))) {free(memp); return 0;}
+   bp->bnode = bnode;
 
 // Update statistics
 //
@@ -226,19 +339,45 @@ int XrdBuffManager::Recalc(int sz)
   
 void XrdBuffManager::Release(XrdBuffer *bp)
 {
+   XrdBuffMag *mP;
    int bindex = bp->bindex;
 
 // Check if we should release this via the big buffer object
 //
    if (bindex >= slots) {xlBuff.Release(bp); return;}
 
-// Obtain a lock on the bucket array and reclaim the buffer
+// Buffers obtained on another node are sent home, otherwise they would slowly
+// migrate to the nodes doing most of the releasing.
 //
-    Reshaper.Lock();
-    bp->next = bucket[bp->bindex].bnext;
-    bucket[bp->bindex].bnext = bp;
-    bucket[bindex].numbuf++;
-    Reshaper.UnLock();
+   if (numNodes > 1 && bp->bnode != getNode())
+      {BuffPool *pP = &pool[bp->bnode];
+       pP->pMutex.Lock();
+       bp->next = pP->bucket[bindex].bnext;
+       pP->bucket[bindex].bnext = bp;
+       pP->bucket[bindex].numbuf++;
+       pP->numrmt++;
+       pP->pMutex.UnLock();
+       return;
+      }
+
+// Keep the buffer in this thread's magazine if there is room for it
+//
+   if ((mP = getMag()))
+      {mP->mMutex.Lock();
+       if (mP->numbuf[bindex] < magMax && mP->numbytes + bp->bsize <= magBytes)
+          {bp->next = mP->bnext[bindex];
+           mP->bnext[bindex] = bp;
+           mP->numbuf[bindex]++;
+           mP->numbytes += bp->bsize;
+           mP->mMutex.UnLock();
+           return;
+          }
+       mP->mMutex.UnLock();
+      }
+
+// Reclaim the buffer into the pool
+//
+   Pool(bp);
 }
  
 /******************************************************************************/
@@ -247,12 +386,12 @@ void XrdBuffManager::Release(XrdBuffer *bp)
   
 void XrdBuffManager::Reshape()
 {
-int i, bufprof[XRD_BUCKETS], numfreed;
+int i, n, nlim, nfree, bufprof[XRD_BUCKETS], numfreed;
 time_t delta, lastshape = time(0);
 long long memslot, memhave, memtarget = (long long)(.80*(float)maxalo);
 XrdSysTimer Timer;
 float requests, buffers;
-XrdBuffer *bp;
+XrdBuffer *bp, *fp;
 
 // This is an endless loop to periodically reshape the buffer pool
 //
@@ -272,27 +411,43 @@ while(1)
          {requests = (float)totreq;
           buffers  = (float)totbuf;
           for (i = 0; i < slots; i++)
-              {bufprof[i] = (int)(buffers*(((float)bucket[i].numreq)/requests));
-               bucket[i].numreq = 0;
+              {bufprof[i] = (int)(buffers*(((float)numreq[i])/requests));
+               numreq[i] = 0;
               }
           totreq = 0; memhave = totalo;
          } else memhave = 0;
+
       Reshaper.UnLock();
 
-      // Reshape the buffer pool to agree with the request profile
+      // If we need to free memory take back the buffers held in the thread
+      // magazines as we can only trim buffers that are in the pools.
+      //
+      if (memhave > memtarget) Reclaim();
+
+      // Reshape the buffer pool to agree with the request profile. Each node
+      // gets an equal share of the buffers.
       //
       memslot = maxsz; numfreed = 0;
       for (i = slots-1; i >= 0 && memhave > memtarget; i--)
-          {Reshaper.Lock();
-           while(bucket[i].numbuf > bufprof[i])
-                if ((bp = bucket[i].bnext))
-                   {bucket[i].bnext = bp->next;
-                    delete bp;
-                    bucket[i].numbuf--; numfreed++;
-                    memhave -= memslot; totalo  -= memslot;
-                    totbuf--;
-                   } else {bucket[i].numbuf = 0; break;}
-           Reshaper.UnLock();
+          {nlim = (bufprof[i] + numNodes - 1) / numNodes;
+           for (n = 0; n < numNodes; n++)
+               {fp = 0; nfree = 0;
+                pool[n].pMutex.Lock();
+                while(pool[n].bucket[i].numbuf > nlim)
+                     if ((bp = pool[n].bucket[i].bnext))
+                        {pool[n].bucket[i].bnext = bp->next;
+                         pool[n].bucket[i].numbuf--;
+                         bp->next = fp; fp = bp; nfree++;
+                        } else {pool[n].bucket[i].numbuf = 0; break;}
+                pool[n].pMutex.UnLock();
+                while((bp = fp)) {fp = bp->next; delete bp;}
+                if (nfree)
+                   {Reshaper.Lock();
+                    totalo -= memslot*nfree; totbuf -= nfree;
+                    Reshaper.UnLock();
+                    memhave -= memslot*nfree; numfreed += nfree;
+                   }
+               }
            memslot = memslot>>1;
           }
 
@@ -329,19 +484,202 @@ void XrdBuffManager::Set(int maxmem, int minw)
 int XrdBuffManager::Stats(char *buff, int blen, int do_sync)
 {
     static char statfmt[] = "<stats id=\"buff\"><reqs>%d</reqs>"
-                "<mem>%lld</mem><buffs>%d</buffs><adj>%d</adj>%s</stats>";
+                "<mem>%lld</mem><buffs>%d</buffs><adj>%d</adj>"
+                "<cache><reqs>%lld</reqs><hits>%lld</hits></cache>"
+                "<numa><nodes>%d</nodes><rmt>%lld</rmt></numa>%s</stats>";
     char xlStats[1024];
+    long long numrmt = 0;
     int nlen;
 
 // If only size wanted, return it
 //
-   if (!buff) return sizeof(statfmt) + 16*4 + xlBuff.Stats(0,0);
+   if (!buff) return sizeof(statfmt) + 16*8 + xlBuff.Stats(0,0);
 
-// Return formatted stats
+// Note that request counts lag behind as threads fold their magazine counts
+// into ours every few requests.
 //
+
+   for (int n = 0; n < numNodes; n++)
+       {if (do_sync) pool[n].pMutex.Lock();
+        numrmt += pool[n].numrmt;
+        if (do_sync) pool[n].pMutex.UnLock();
+       }
    if (do_sync) Reshaper.Lock();
    xlBuff.Stats(xlStats, sizeof(xlStats), do_sync);
-   nlen = snprintf(buff,blen,statfmt,totreq,totalo,totbuf,totadj,xlStats);
+   nlen = snprintf(buff,blen,statfmt,totreq,totalo,totbuf,totadj,
+                   totmreq,totmhit,numNodes,numrmt,xlStats);
    if (do_sync) Reshaper.UnLock();
    return nlen;
 }
+
+/******************************************************************************/
+/*                       P r i v a t e   M e t h o d s                        */
+/******************************************************************************/
+/******************************************************************************/
+/*                                 F l u s h                                  */
+/******************************************************************************/
+
+// Return all buffers held by a magazine to their pools. The caller must hold
+// the magazine lock or own the magazine outright.
+
+void XrdBuffManager::Flush(XrdBuffMag *mP)
+{
+   XrdBuffer *bp;
+
+   for (int i = 0; i < slots; i++)
+       {while((bp = mP->bnext[i])) {mP->bnext[i] = bp->next; Pool(bp);}
+        mP->numbuf[i] = 0;
+       }
+   mP->numbytes = 0;
+}
+
+/******************************************************************************/
+/*                                  F o l d                                   */
+/******************************************************************************/
+
+void XrdBuffManager::Fold(XrdBuffMag *mP)
+{
+   Reshaper.Lock();
+   for (int i = 0; i < slots; i++)
+       {numreq[i] += mP->numreq[i]; mP->numreq[i] = 0;}
+   totreq  += mP->nreq;
+   totmreq += mP->nreq;
+   totmhit += mP->nhit;
+   Reshaper.UnLock();
+   mP->nreq = mP->nhit = 0;
+}
+
+/******************************************************************************/
+/*                               R e c l a i m                                */
+/******************************************************************************/
+
+// Move the buffers of every registered magazine back to the pools. Threads
+// keep using their magazines, they simply find them empty.
+
+void XrdBuffManager::Reclaim()
+{
+   XrdBuffMag *mP;
+
+   magMutex.Lock();
+   for (mP = magList; mP; mP = mP->next)
+       {mP->mMutex.Lock();
+        Flush(mP);
+        mP->mMutex.UnLock();
+       }
+   magMutex.UnLock();
+}
+
+/******************************************************************************/
+/*                                g e t M a g                                 */
+/******************************************************************************/
+
+XrdBuffMag *XrdBuffManager::getMag()
+{
+   XrdBuffMag *mP;
+
+   if (!magOn) return 0;
+   if (!(mP = static_cast<XrdBuffMag *>(pthread_getspecific(magKey))))
+      {mP = new XrdBuffMag(this);
+       if (pthread_setspecific(magKey, mP)) {delete mP; return 0;}
+       magMutex.Lock();
+       if ((mP->next = magList)) magList->prev = mP;
+       magList = mP;
+       magMutex.UnLock();
+      }
+   return mP;
+}
+
+/******************************************************************************/
+/*                               g e t N o d e                                */
+/******************************************************************************/
+
+int XrdBuffManager::getNode()
+{
+#if defined(__linux__)
+   if (numNodes > 1)
+      {int cpu = sched_getcpu();
+       if (cpu >= 0 && cpu < numCPU) return cpu2node[cpu];
+      }
+#endif
+   return 0;
+}
+
+/******************************************************************************/
+/*                              N u m a I n i t                               */
+/******************************************************************************/
+
+// Map each cpu to its NUMA node. We only use more than one pool if there is
+// more than one node.
+
+void XrdBuffManager::NumaInit()
+{
+   numNodes = 1;
+   numCPU   = 0;
+   cpu2node = 0;
+
+#if defined(__linux__)
+   char path[64], line[4096], *cp, *ep;
+   long ncpu = sysconf(_SC_NPROCESSORS_CONF), beg, end;
+   short *c2n;
+   FILE *fp;
+   int node;
+
+   if (ncpu <= 0) return;
+   c2n = new short[ncpu];
+   memset(c2n, 0, sizeof(short)*ncpu);
+
+   for (node = 0; node < maxNodes; node++)
+       {snprintf(path, sizeof(path),
+                 "/sys/devices/system/node/node%d/cpulist", node);
+        if (!(fp = fopen(path, "r"))) break;
+        if (fgets(line, sizeof(line), fp))
+           {cp = line;
+            while(*cp && *cp != '\n')
+                 {beg = strtol(cp, &ep, 10);
+                  if (ep == cp) break;
+                  end = beg;
+                  if (*ep == '-')
+                     {cp = ep+1; end = strtol(cp, &ep, 10);
+                      if (ep == cp) break;
+                     }
+                  for (; beg <= end; beg++)
+                      if (beg >= 0 && beg < ncpu) c2n[beg] = node;
+                  cp = (*ep == ',' ? ep+1 : ep);
+                 }
+           }
+        fclose(fp);
+       }
+
+   if (node > 1) {numNodes = node; numCPU = ncpu; cpu2node = c2n;}
+      else delete [] c2n;
+#endif
+}
+
+/******************************************************************************/
+/*                                  P o o l                                   */
+/******************************************************************************/
+
+XrdBuffer *XrdBuffManager::Pool(int node, int bindex)
+{
+   BuffPool  *pP = &pool[node];
+   XrdBuffer *bp;
+
+   pP->pMutex.Lock();
+   if ((bp = pP->bucket[bindex].bnext))
+      {pP->bucket[bindex].bnext = bp->next; pP->bucket[bindex].numbuf--;}
+   pP->pMutex.UnLock();
+   return bp;
+}
+
+/******************************************************************************/
+
+void XrdBuffManager::Pool(XrdBuffer *bp)
+{
+   BuffPool *pP = &pool[bp->bnode];
+
+   pP->pMutex.Lock();
+   bp->next = pP->bucket[bp->bindex].bnext;
+   pP->bucket[bp->bindex].bnext = bp;
+   pP->bucket[bp->bindex].numbuf++;
+   pP->pMutex.UnLock();
+}
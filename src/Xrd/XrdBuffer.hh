@@ -46,7 +46,7 @@ char *   buff;     // -> buffer
 int      bsize;    // size of this buffer
 
          XrdBuffer(char *bp, int sz, int ix)
-                      {buff = bp; bsize = sz; bindex = ix; next = 0;}
+                      {buff = bp; bsize = sz; bindex = ix; bnode = 0; next = 0;}
 
         ~XrdBuffer() {if (buff) free(buff);}
 
@@ -55,6 +55,7 @@ int      bsize;    // size of this buffer
 private:
 
 int        bindex;
+int        bnode;    // NUMA node the buffer was obtained on
 XrdBuffer *next;
 static int pagesz;
 };
@@ -68,6 +69,13 @@ static int pagesz;
 
 // There should be only one instance of this class per buffer pool.
 //
+// Each thread keeps a small magazine of recently released buffers per bucket
+// so that most Obtain()/Release() pairs only take the thread's own lock. The
+// reshaper takes magazine buffers back when memory must be trimmed. Misses go
+// to the shared buckets of the NUMA node the thread is running on; buffers
+// are always returned to the node they were obtained on.
+//
+class XrdBuffMag;
 class XrdOucTrace;
 class XrdSysError;
   
@@ -96,6 +104,25 @@ int         Stats(char *buff, int blen, int do_sync=0);
            ~XrdBuffManager();   // The buffmanager is never deleted
 
 private:
+friend class XrdBuffMag;
+
+struct BuffPool
+      {XrdSysMutex   pMutex;
+       struct {XrdBuffer *bnext;
+               int        numbuf;
+              }      bucket[XRD_BUCKETS];
+       long long     numrmt;           // Buffers returned by other nodes
+       char          pad[64];          // Keep pool locks in separate lines
+      };
+
+void        Flush(XrdBuffMag *mP);
+void        Fold(XrdBuffMag *mP);
+void        Reclaim();
+XrdBuffMag *getMag();
+int         getNode();
+void        NumaInit();
+XrdBuffer  *Pool(int node, int bindex);
+void        Pool(XrdBuffer *bp);
 
 XrdOucTrace *XrdTrace;
 XrdSysError *XrdLog;
@@ -105,10 +132,17 @@ const int  shift;
 const int  pagsz;
 const int  maxsz;
 
-struct {XrdBuffer *bnext;
-        int         numbuf;
-        int         numreq;
-       } bucket[XRD_BUCKETS];          // 1K to 1<<(szshift+slots-1)M buffers
+BuffPool *pool;                        // One per NUMA node
+int       numreq[XRD_BUCKETS];         // 1K to 1<<(szshift+slots-1)M buffers
+int       numNodes;
+int       numCPU;
+short    *cpu2node;
+pthread_key_t magKey;
+XrdSysMutex magMutex;                  // Protects magList
+XrdBuffMag *magList;                   // All thread magazines
+bool      magOn;                       // Set once by the constructor
+long long totmreq;                     // Requests seen by magazines
+long long totmhit;                     // Requests satisfied by magazines
 
 int       totreq;
 int       totbuf;
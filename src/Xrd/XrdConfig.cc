@@ -168,6 +168,7 @@ XrdConfig::XrdConfig() : Log(&Logger, "Xrd"), Trace(&Log), Sched(&Log, &Trace),
    repInt     = 600;
    repOpts    = 0;
    ppNet      = 0;
+   pollEdge   = 0;
    NetTCPlep  = -1;
    NetADM     = 0;
    coreV      = 1;
@@ -957,7 +958,7 @@ int XrdConfig::Setup(char *dfltp)
    XrdLink::Init(&Log, &Trace, &Sched);
    XrdPoll::Init(&Log, &Trace, &Sched);
    if (!XrdLink::Setup(ProtInfo.ConnMax, ProtInfo.idleWait)
-   ||  !XrdPoll::Setup(ProtInfo.ConnMax)) return 1;
+   ||  !XrdPoll::Setup(ProtInfo.ConnMax, pollEdge != 0)) return 1;
 
 // Modify the AdminPath to account for any instance name. Note that there is
 // a negligible memory leak under ceratin path combinations. Not enough to
@@ -1252,7 +1253,7 @@ int XrdConfig::xbuf(XrdSysError *eDest, XrdOucStream &Config)
    Purpose:  To parse directive: network [wan] [[no]keepalive] [buffsz <blen>]
                                          [kaparms parms] [cache <ct>] [[no]dnr]
                                          [routes <rtype> [use <ifn1>,<ifn2>]]
-                                         [[no]rpipa]
+                                         [[no]rpipa] [[no]edgepoll]
 
              <rtype>: split | common | local
 
@@ -1264,6 +1265,9 @@ int XrdConfig::xbuf(XrdSysError *eDest, XrdOucStream &Config)
              [no]dnr   do [not] perform a reverse DNS lookup if not needed.
              routes    specifies the network configuration (see reference)
              [no]rpipa do [not] resolve private IP addresses.
+             [no]edgepoll do [not] use edge triggered polling of links. This
+                       avoids re-arming a link after each request and is
+                       only available on Linux.
 
    Output: 0 upon success or !0 upon failure.
 */
@@ -1272,7 +1276,7 @@ int XrdConfig::xnet(XrdSysError *eDest, XrdOucStream &Config)
 {
     char *val;
     int  i, n, V_keep = -1, V_nodnr = 0, V_iswan = 0, V_blen = -1, V_ct = -1, V_assumev4;
-    int  v_rpip = -1;
+    int  v_rpip = -1, v_edge = -1;
     long long llp;
     struct netopts {const char *opname; int hasarg; int opval;
                            int *oploc;  const char *etxt;}
@@ -1285,6 +1289,8 @@ int XrdConfig::xnet(XrdSysError *eDest, XrdOucStream &Config)
         {"buffsz",     1, 0, &V_blen,   "network buffsz"},
         {"cache",      2, 0, &V_ct,     "cache time"},
         {"dnr",        0, 0, &V_nodnr,  "option"},
+        {"edgepoll",   0, 1, &v_edge,   "option"},
+        {"noedgepoll", 0, 0, &v_edge,   "option"},
         {"nodnr",      0, 1, &V_nodnr,  "option"},
         {"routes",     3, 1, 0,         "routes"},
         {"rpipa",      0, 1, &v_rpip,   "rpipa"},
@@ -1361,6 +1367,7 @@ int XrdConfig::xnet(XrdSysError *eDest, XrdOucStream &Config)
 
      if (V_ct >= 0) XrdNetAddr::SetCache(V_ct);
      if (v_rpip >= 0) XrdInet::netIF.SetRPIPA(v_rpip != 0);
+     if (v_edge >= 0) pollEdge = static_cast<char>(v_edge);
      if (V_assumev4 >= 0) XrdInet::SetAssumeV4(true);
      return 0;
 }
@@ -1667,6 +1674,7 @@ int XrdConfig::xrep(XrdSysError *eDest, XrdOucStream &Config)
 
    Purpose:  To parse directive: sched [mint <mint>] [maxt <maxt>] [avlt <at>]
                                        [idle <idle>] [stksz <qnt>] [core <cv>]
+                                       [runq {cpu | <nq>}]
 
              <mint>   is the minimum number of threads that we need. Once
                       this number of threads is created, it does not decrease.
@@ -1683,6 +1691,11 @@ int XrdConfig::xrep(XrdSysError *eDest, XrdOucStream &Config)
              <idle>   The time (in time spec) between checks for underused
                       threads. Those found will be terminated. Default is 780.
              <qnt>    The thread stack size in bytes or K, M, or G.
+             <nq>     The number of run queues. Each worker is homed on a
+                      queue and takes work from others when its own is empty.
+                      Jobs for the same link always go to the same queue.
+                      Specify cpu for one queue per core. The default, 0,
+                      uses a single queue shared by all workers.
 
    Output: 0 upon success or 1 upon failure.
 */
@@ -1692,7 +1705,7 @@ int XrdConfig::xsched(XrdSysError *eDest, XrdOucStream &Config)
     char *val;
     long long lpp;
     int  i, ppp = 0;
-    int  V_mint = -1, V_maxt = -1, V_idle = -1, V_avlt = -1;
+    int  V_mint = -1, V_maxt = -1, V_idle = -1, V_avlt = -1, V_runq = 0;
     struct schedopts {const char *opname; int minv; int *oploc;
                       const char *opmsg;} scopts[] =
        {
@@ -1701,7 +1714,8 @@ int XrdConfig::xsched(XrdSysError *eDest, XrdOucStream &Config)
         {"maxt",       1, &V_maxt, "sched maxt"},
         {"avlt",       1, &V_avlt, "sched avlt"},
         {"core",       1,       0, "sched core"},
-        {"idle",       0, &V_idle, "sched idle"}
+        {"idle",       0, &V_idle, "sched idle"},
+        {"runq",       0, &V_runq, "sched runq"}
        };
     int numopts = sizeof(scopts)/sizeof(struct schedopts);
 
@@ -1728,6 +1742,12 @@ int XrdConfig::xsched(XrdSysError *eDest, XrdOucStream &Config)
                                   return 1;
                                  }
                            }
+                   else if (*scopts[i].opname == 'r')
+                           {if (!strcmp("cpu", val)) ppp = -1;
+                               else if (XrdOuca2x::a2i(*eDest, scopts[i].opmsg,
+                                        val, &ppp, scopts[i].minv,
+                                        MAX_SCHED_RUNQ)) return 1;
+                           }
                    else if (*scopts[i].opname == 's')
                            {if (XrdOuca2x::a2sz(*eDest, scopts[i].opmsg, val,
                                                 &lpp, scopts[i].minv)) return 1;
@@ -1760,6 +1780,7 @@ int XrdConfig::xsched(XrdSysError *eDest, XrdOucStream &Config)
 // Establish scheduler options
 //
    Sched.setParms(V_mint, V_maxt, V_avlt, V_idle);
+   if (V_runq) Sched.setRunQ(V_runq);
    return 0;
 }
 
@@ -120,6 +120,7 @@ int                 HomeMode;
 int                 repInt;
 char                repOpts;
 char                ppNet;
+char                pollEdge;
 signed char         coreV;
 };
 #endif
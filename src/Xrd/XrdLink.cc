@@ -181,6 +181,7 @@ void XrdLink::Reset()
   isEnabled= 0;
   isIdle   = 0;
   inQ      = 0;
+  edgeState= 0;
   isBridged= 0;
   BytesOut = BytesIn = BytesOutTot = BytesInTot = 0;
   doPost   = 0;
@@ -803,9 +804,14 @@ int XrdLink::Send(const sfVec *sfP, int sfN)
 #if !defined(HAVE_SENDFILE) || defined(__APPLE__)
    return -1;
 #else
-// Make sure we have valid vector count
+// Make sure we have valid vector count. Only sendfilev() limits the number of
+// elements, on Linux the vector is sent element by element.
 //
+#ifdef __solaris__
    if (sfN < 1 || sfN > XrdOucSFVec::sfMax)
+#else
+   if (sfN < 1)
+#endif
       {XrdLog->Emsg("Link", EINVAL, "send file to", ID);
        return -1;
       }
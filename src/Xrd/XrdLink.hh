@@ -328,6 +328,7 @@ char                KeepFD;
 char                isEnabled;
 char                isIdle;
 char                inQ;    // Only used by PollPoll.icc
+char                edgeState;      // Only used by PollE.icc in edge mode
 char                isBridged;
 char                KillCnt;        // Protected by opMutex!
 static const char   KillMax =   60;
@@ -86,6 +86,8 @@ int           Stats(char *buff, int blen, int do_sync=0) {return 0;}
        XrdSysError  *XrdPoll::XrdLog   = 0;
        XrdScheduler *XrdPoll::XrdSched = 0;
 
+       bool          XrdPoll::wantEdge = false;
+
 /******************************************************************************/
 /*              T h r e a d   S t a r t u p   I n t e r f a c e               */
 /******************************************************************************/
@@ -117,6 +119,7 @@ XrdPoll::XrdPoll()
 
    TID=0;
    numAttached=numEnabled=numEvents=numInterrupts=0;
+   numPolls=numCtls=numProbes=0;
 
    if (XrdSysFD_Pipe(fildes) == 0)
       {CmdFD = fildes[1];
@@ -286,12 +289,16 @@ char *XrdPoll::Poll2Text(short events)
 /*                                 S e t u p                                  */
 /******************************************************************************/
   
-int XrdPoll::Setup(int numfd)
+int XrdPoll::Setup(int numfd, bool edge)
 {
    pthread_t tid;
    int maxfd, retc, i;
    struct XrdPollArg PArg;
 
+// Record the polling mode, the implementation decides if it can honor it
+//
+   wantEdge = edge;
+
 // Calculate the number of table entries per poller
 //
    maxfd  = (numfd / XRD_NUMPOLLERS) + 16;
@@ -330,13 +337,15 @@ int XrdPoll::Setup(int numfd)
 int XrdPoll::Stats(char *buff, int blen, int do_sync)
 {
    static const char statfmt[] = "<stats id=\"poll\"><att>%d</att>"
-   "<en>%d</en><ev>%d</ev><int>%d</int></stats>";
+   "<en>%d</en><ev>%d</ev><int>%d</int><wt>%d</wt><ctl>%d</ctl><pk>%d</pk>"
+   "</stats>";
    int i, numatt = 0, numen = 0, numev = 0, numint = 0;
+   int numwt = 0, numctl = 0, numpk = 0;
    XrdPoll *pp;
 
 // Return number of bytes if so wanted
 //
-   if (!buff) return (sizeof(statfmt)+(4*16))*XRD_NUMPOLLERS;
+   if (!buff) return (sizeof(statfmt)+(7*16))*XRD_NUMPOLLERS;
 
 // Get statistics. While we wish we could honor do_sync, doing so would be
 // costly and hardly worth it. So, we do not include code such as:
@@ -348,11 +357,15 @@ int XrdPoll::Stats(char *buff, int blen, int do_sync)
         numen  += pp->numEnabled;
         numev  += pp->numEvents;
         numint += pp->numInterrupts;
+        numwt  += pp->numPolls;
+        numctl += pp->numCtls;
+        numpk  += pp->numProbes;
        }
 
 // Format and return
 //
-   return snprintf(buff, blen, statfmt, numatt, numen, numev, numint);
+   return snprintf(buff, blen, statfmt, numatt, numen, numev, numint,
+                   numwt, numctl, numpk);
 }
   
 /******************************************************************************/
@@ -73,9 +73,11 @@ static  void  Init(XrdSysError *eP, XrdOucTrace *tP, XrdScheduler *sP)
 //
 static  char *Poll2Text(short events); // Implementation supplied
 
-// Setup() is called at config time to perform poller configuration
+// Setup() is called at config time to perform poller configuration. When edge
+//         is true, implementations that support it keep links permanently in
+//         the poll set and track readiness themselves instead of re-arming.
 //
-static  int   Setup(int numfd);        // Implementation supplied
+static  int   Setup(int numfd, bool edge=false); // Implementation supplied
 
 // Start() is called via a thread for each poller that was created
 //
@@ -103,6 +105,7 @@ static     const char   *TraceID;                  // For tracing
 static     XrdOucTrace  *XrdTrace;
 static     XrdSysError  *XrdLog;
 static     XrdScheduler *XrdSched;
+static     bool          wantEdge;                 // Setup(edge) value
 
 // Gets the next request on the poll pipe. This is common to all implentations.
 //
@@ -143,6 +146,9 @@ int           PipeBlen;
            int         numEnabled;     // Count of Enable() calls
            int         numEvents;      // Count of poll fd's dispatched
            int         numInterrupts;  // Number of interrupts (e.g., signals)
+           int         numPolls;       // Number of poll waits
+           int         numCtls;        // Number of poll set modifications
+           int         numProbes;      // Number of readiness probes
 
 private:
 
@@ -48,7 +48,13 @@ public:
        void Start(XrdSysSemaphore *syncp, int &rc);
 
             XrdPollE(struct epoll_event *ptab, int numfd, int pfd)
-                       {PollTab = ptab; PollMax = numfd; PollDfd = pfd;}
+                       {PollTab = ptab; PollMax = numfd; PollDfd = pfd;
+#ifdef HAVE_ATOMICS
+                        Edge = wantEdge;
+#else
+                        Edge = false; // Needs a real compare and swap
+#endif
+                       }
            ~XrdPollE();
 
 protected:
@@ -57,6 +63,8 @@ protected:
 const  char *x2Text(unsigned int evf, char *buff);
 
 private:
+int  Edge2Job(XrdLink *lp);
+int  EnableEdge(XrdLink *lp);
 void remFD(XrdLink *lp, unsigned int events);
 
 #ifdef EPOLLONESHOT
@@ -67,8 +75,25 @@ void remFD(XrdLink *lp, unsigned int events);
    static const int ePollEvents = EPOLLIN  | EPOLLHUP | EPOLLPRI | EPOLLERR |
                                   EPOLLRDHUP | ePollOneShot;
 
+// In edge mode a link stays in the poll set for its whole life and its
+// edgeState says whether the link waits for an event (Armed) or is being
+// serviced (zero). The state is only changed with compare and swap, so edge
+// mode is never used without atomics.
+//
+   static const uint32_t ePollEdge = EPOLLIN  | EPOLLHUP | EPOLLPRI | EPOLLERR |
+                                    EPOLLRDHUP | EPOLLET;
+   static const char edgeArmed  = 1;
+
+#ifdef HAVE_ATOMICS
+   static bool edgeCAS(char &state, char oldS, char newS)
+                      {return __sync_bool_compare_and_swap(&state, oldS, newS);}
+#else
+   static bool edgeCAS(char &, char, char) {return false;}
+#endif
+
 struct epoll_event *PollTab;
        int          PollDfd;
        int          PollMax;
+       bool         Edge;
 };
 #endif
@@ -30,6 +30,7 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <signal.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <sys/resource.h>
 #include <sys/stat.h>
@@ -41,6 +42,7 @@
 
 #include "Xrd/XrdJob.hh"
 #include "Xrd/XrdScheduler.hh"
+#include "XrdSys/XrdSysAtomics.hh"
 #include "XrdSys/XrdSysError.hh"
 
 #define XRD_TRACE XrdTrace->
@@ -65,6 +67,49 @@ class XrdSchedulerPID
                         {next = prev; pid = newpid;}
      ~XrdSchedulerPID() {}
      };
+
+// A run queue is used when per-core queues have been requested. Each worker
+// is homed on one of them and waits on its semaphore when there is no work
+// in any queue. The queues are padded so that they don't share cache lines.
+//
+class XrdSchedulerQ
+     {public:
+      XrdSysMutex      qMutex;
+      XrdJob          *First;     // qMutex: Pending work
+      XrdJob          *Last;      // qMutex
+      int              numInQ;    // qMutex: Number of jobs in this queue
+      int              maxInQ;    // qMutex: Longest length of this queue
+      int              numJobs;   // qMutex: Number of jobs scheduled here
+      int              numIdle;   // qMutex: Unclaimed idle workers on qReady
+      int              numHomed;  // SchedMutex: Workers homed on this queue
+      XrdSysSemaphore  qReady;
+      char             qPad[64];
+
+      XrdJob *Pop()
+             {XrdJob *jp;
+              if ((jp = First))
+                 {if (!(First = jp->NextJob)) Last = 0;
+                  numInQ--;
+                 }
+              return jp;
+             }
+
+      void    Push(XrdJob *jfirst, XrdJob *jlast, int num)
+             {jlast->NextJob = 0;
+              if (Last) Last->NextJob = jfirst;
+                 else   First        = jfirst;
+              Last = jlast;
+              if ((numInQ += num) > maxInQ) maxInQ = numInQ;
+             }
+
+      XrdSchedulerQ() : First(0), Last(0), numInQ(0), maxInQ(0), numJobs(0),
+                        numIdle(0), numHomed(0), qReady(0, "sched runq") {}
+     ~XrdSchedulerQ() {}
+     };
+
+// The maximum number of jobs that a worker takes from another run queue
+//
+#define MAX_SCHED_STEAL 16
   
 /******************************************************************************/
 /*            E x t e r n a l   T h r e a d   I n t e r f a c e s             */
@@ -114,7 +159,10 @@ XrdScheduler::XrdScheduler(XrdSysError *eP, XrdOucTrace *tP,
     num_TDestroy=  0;
     num_Layoffs =  0;
     num_Limited =  0;
+    num_Stolen  =  0;
     firstPID    =  0;
+    runQ        =  0;
+    num_RunQ    =  0;
     WorkFirst = WorkLast = TimerQueue = 0;
 
 // Make sure we are using the maximum number of threads allowed (Linux only)
@@ -210,7 +258,7 @@ void XrdScheduler::DoIt()
 
 // Now check if there are too many idle threads (kill them if there are)
 //
-   if (!num_JobsinQ)
+   if (!(runQ ? inQueue() : num_JobsinQ))
       {DispatchMutex.Lock(); num_idle = idl_Workers; DispatchMutex.UnLock();
        num_kill = num_idle - min_Workers;
        TRACE(SCHED, num_Workers <<" threads; " <<num_idle <<" idle");
@@ -218,7 +266,8 @@ void XrdScheduler::DoIt()
           {if (num_kill > 1) num_kill = num_kill/2;
            SchedMutex.Lock();
            num_Layoffs = num_kill;
-           while(num_kill--) WorkAvail.Post();
+           if (runQ) wakeIdle(num_kill, 0);
+              else while(num_kill--) WorkAvail.Post();
            SchedMutex.UnLock();
           }
       }
@@ -323,6 +372,10 @@ void XrdScheduler::Run()
    int waiting;
    XrdJob *jp;
 
+// Run queues have their own dispatch loop
+//
+   if (runQ) {runQueued(); return;}
+
 // Wait for work then do it (an endless task for a worker thread)
 //
    do {do {DispatchMutex.Lock();          idl_Workers++;DispatchMutex.UnLock();
@@ -364,6 +417,19 @@ void XrdScheduler::Run()
   
 void XrdScheduler::Schedule(XrdJob *jp)
 {
+// If we have run queues, place the job on its queue and wake up a worker
+//
+   if (runQ)
+      {int qnum = pickQ(jp);
+       XrdSchedulerQ *qP = &runQ[qnum];
+       qP->qMutex.Lock();
+       qP->Push(jp, jp, 1);
+       qP->numJobs++;
+       qP->qMutex.UnLock();
+       wakeIdle(1, qnum);
+       return;
+      }
+
 // Lock down our data area
 //
    SchedMutex.Lock();
@@ -396,6 +462,20 @@ void XrdScheduler::Schedule(XrdJob *jp)
 void XrdScheduler::Schedule(int numjobs, XrdJob *jfirst, XrdJob *jlast)
 {
 
+// If we have run queues, place the whole list on the first job's queue. Any
+// idle workers we wake up that are homed elsewhere will steal from it.
+//
+   if (runQ)
+      {int qnum = pickQ(jfirst);
+       XrdSchedulerQ *qP = &runQ[qnum];
+       qP->qMutex.Lock();
+       qP->Push(jfirst, jlast, numjobs);
+       qP->numJobs += numjobs;
+       qP->qMutex.UnLock();
+       wakeIdle(numjobs, qnum);
+       return;
+      }
+
 // Lock down our data area
 //
    SchedMutex.Lock();
@@ -505,6 +585,28 @@ void XrdScheduler::setParms(int minw, int maxw, int avlw, int maxi, int once)
    TRACE(SCHED,"Set stk_Workers=" <<stk_Workers <<" max_Workidl=" <<max_Workidl);
 }
 
+/******************************************************************************/
+/*                               s e t R u n Q                                */
+/******************************************************************************/
+  
+void XrdScheduler::setRunQ(int numq)
+{
+// Use one queue per online cpu if so wanted
+//
+   if (numq < 0)
+      {long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+       numq = (ncpu > 0 ? static_cast<int>(ncpu) : 1);
+      }
+   if (numq > MAX_SCHED_RUNQ) numq = MAX_SCHED_RUNQ;
+
+// Run queues are allocated when we start
+//
+   SchedMutex.Lock();
+   if (!runQ) num_RunQ = numq;
+   SchedMutex.UnLock();
+   TRACE(SCHED, "Set num_RunQ=" <<num_RunQ);
+}
+
 /******************************************************************************/
 /*                                 S t a r t                                  */
 /******************************************************************************/
@@ -514,6 +616,21 @@ void XrdScheduler::Start() // Serialized one time call!
     int retc, numw;
     pthread_t tid;
 
+// Allocate the run queues, if wanted. Anything scheduled before we started
+// is moved to the first queue. This must be done before any thread can call
+// Schedule() so it precedes starting the time scheduler.
+//
+   if (num_RunQ > 0)
+      {runQ = new XrdSchedulerQ[num_RunQ];
+       if (WorkFirst)
+          {runQ[0].Push(WorkFirst, WorkLast, num_JobsinQ);
+           runQ[0].numJobs = num_JobsinQ;
+           WorkFirst = WorkLast = 0;
+           num_JobsinQ = 0;
+          }
+       TRACE(SCHED, "Using " <<num_RunQ <<" run queues");
+      }
+
 // Start a time based scheduler
 //
    if ((retc = XrdSysThread::Run(&tid, XrdStartTSched, (void *)this,
@@ -541,21 +658,22 @@ void XrdScheduler::Start() // Serialized one time call!
 int XrdScheduler::Stats(char *buff, int blen, int do_sync)
 {
     int cnt_Jobs, cnt_JobsinQ, xam_QLength, cnt_Workers, cnt_idl;
-    int cnt_TCreate, cnt_TDestroy, cnt_Limited;
+    int cnt_TCreate, cnt_TDestroy, cnt_Limited, cnt_Stolen;
     static char statfmt[] = "<stats id=\"sched\"><jobs>%d</jobs>"
                 "<inq>%d</inq><maxinq>%d</maxinq>"
                 "<threads>%d</threads><idle>%d</idle>"
                 "<tcr>%d</tcr><tde>%d</tde>"
-                "<tlimr>%d</tlimr></stats>";
+                "<tlimr>%d</tlimr><stl>%d</stl></stats>";
 
 // If only length wanted, do so
 //
-   if (!buff) return sizeof(statfmt) + 16*8;
+   if (!buff) return sizeof(statfmt) + 16*9;
 
 // Get values protected by the Dispatch lock (avoid lock if no sync needed)
 //
    if (do_sync) DispatchMutex.Lock();
    cnt_idl = idl_Workers;
+   cnt_Stolen = AtomicGet(num_Stolen);
    if (do_sync) DispatchMutex.UnLock();
 
 // Get values protected by the Scheduler lock (avoid lock if no sync needed)
@@ -570,11 +688,25 @@ int XrdScheduler::Stats(char *buff, int blen, int do_sync)
    cnt_Limited = num_Limited;
    if (do_sync) SchedMutex.UnLock();
 
+// With run queues the job counts are kept per queue. The maximum reported is
+// the longest that any one of the queues has been.
+//
+   if (runQ)
+      {cnt_Jobs = cnt_JobsinQ = xam_QLength = 0;
+       for (int i = 0; i < num_RunQ; i++)
+           {if (do_sync) runQ[i].qMutex.Lock();
+            cnt_Jobs    += runQ[i].numJobs;
+            cnt_JobsinQ += runQ[i].numInQ;
+            if (runQ[i].maxInQ > xam_QLength) xam_QLength = runQ[i].maxInQ;
+            if (do_sync) runQ[i].qMutex.UnLock();
+           }
+      }
+
 // Format the stats and return them
 //
    return snprintf(buff, blen, statfmt, cnt_Jobs, cnt_JobsinQ, xam_QLength,
                    cnt_Workers, cnt_idl, cnt_TCreate, cnt_TDestroy,
-                   cnt_Limited);
+                   cnt_Limited, cnt_Stolen);
 }
 
 /******************************************************************************/
@@ -648,6 +780,180 @@ void XrdScheduler::hireWorker(int dotrace)
       } else if (dotrace) TRACE(SCHED, "Now have " <<num_Workers <<" workers" );
 }
  
+/******************************************************************************/
+/*                               i n Q u e u e                                */
+/******************************************************************************/
+  
+// The result is only used for statistics and decisions that tolerate a stale
+// value, so the queues are not locked.
+//
+int XrdScheduler::inQueue()
+{
+   int i, numjobs = 0;
+
+   for (i = 0; i < num_RunQ; i++) numjobs += runQ[i].numInQ;
+   return numjobs;
+}
+
+/******************************************************************************/
+/*                                 p i c k Q                                  */
+/******************************************************************************/
+  
+// Jobs are placed on a run queue by address. Since a link is always the same
+// job object, all of its requests are queued on the same run queue and are
+// mostly handled by the workers homed there, keeping its state in their cache.
+//
+int XrdScheduler::pickQ(XrdJob *jp)
+{
+   unsigned long long hval = static_cast<unsigned long long>((uintptr_t)jp)>>4;
+
+   return static_cast<int>(((hval * 0x9e3779b97f4a7c15ULL) >> 40) % num_RunQ);
+}
+
+/******************************************************************************/
+/*                             r u n Q u e u e d                              */
+/******************************************************************************/
+  
+void XrdScheduler::runQueued()
+{
+   XrdSchedulerQ *myQ;
+   XrdJob *jp;
+   int i, qnum, undo, idle;
+
+// Home this worker on the run queue that has the fewest workers
+//
+   SchedMutex.Lock();
+   for (qnum = 0, i = 1; i < num_RunQ; i++)
+       if (runQ[i].numHomed < runQ[qnum].numHomed) qnum = i;
+   myQ = &runQ[qnum];
+   myQ->numHomed++;
+   SchedMutex.UnLock();
+
+// Take work from our queue and then from any other queue. When there is none
+// we declare ourselves idle and look once more before waiting. Schedule()
+// adds the job before looking for idle workers and we do the converse, so
+// one of us is bound to see the other. Idle workers are claimed by whoever
+// posts them, so after a wakeup there is nothing to undo.
+//
+   do {myQ->qMutex.Lock(); jp = myQ->Pop(); myQ->qMutex.UnLock();
+       if (!jp && !(jp = stealJob(myQ, 0)))
+          {AtomicBeg(DispatchMutex); AtomicInc(idl_Workers);
+           AtomicEnd(DispatchMutex);
+           myQ->qMutex.Lock();
+           if (!(jp = myQ->Pop())) myQ->numIdle++;
+           myQ->qMutex.UnLock();
+           if (!jp && (jp = stealJob(myQ, 1)))
+              {myQ->qMutex.Lock();
+               if ((undo = (myQ->numIdle > 0))) myQ->numIdle--;
+               myQ->qMutex.UnLock();
+              } else undo = (jp != 0);
+           if (undo)
+              {AtomicBeg(DispatchMutex); AtomicDec(idl_Workers);
+               AtomicEnd(DispatchMutex);
+              }
+           if (!jp)
+              {myQ->qReady.Wait();
+               SchedMutex.Lock();
+               if (num_Layoffs > 0)
+                  {num_Layoffs--;
+                   AtomicBeg(DispatchMutex); idle = AtomicGet(idl_Workers);
+                   AtomicEnd(DispatchMutex);
+                   if (idle > 0)
+                      {num_TDestroy++; num_Workers--; myQ->numHomed--;
+                       TRACE(SCHED, "terminating thread; workers=" <<num_Workers);
+                       SchedMutex.UnLock();
+                       return;
+                      }
+                  }
+               SchedMutex.UnLock();
+               continue;
+              }
+          }
+
+    // Check if we should hire a new worker (we always want 1 idle thread)
+    // before running this job.
+    //
+       AtomicBeg(DispatchMutex); idle = AtomicGet(idl_Workers);
+       AtomicEnd(DispatchMutex);
+       if (idle <= 0) hireWorker();
+       if (TRACING(TRACE_SCHED) && *(jp->Comment) != '.')
+          {TRACE(SCHED, "running " <<jp->Comment <<" inq=" <<myQ->numInQ);}
+       jp->DoIt();
+      } while(1);
+}
+
+/******************************************************************************/
+/*                              s t e a l J o b                               */
+/******************************************************************************/
+  
+// Take the first job from the next run queue that has any. A few more jobs
+// are moved to our own queue so that we need not come back right away. Unless
+// dolock is set, busy queues are skipped rather than waited for.
+//
+XrdJob *XrdScheduler::stealJob(XrdSchedulerQ *myQ, int dolock)
+{
+   XrdSchedulerQ *qP;
+   XrdJob *jp, *jfirst, *jlast;
+   int i, n, qnum = myQ - runQ;
+
+   for (i = 1; i < num_RunQ; i++)
+       {qP = &runQ[(qnum+i) % num_RunQ];
+        if (dolock) qP->qMutex.Lock();
+           else if (!qP->numInQ || !qP->qMutex.CondLock()) continue;
+        if (!(jp = qP->Pop())) {qP->qMutex.UnLock(); continue;}
+        if ((n = qP->numInQ/2) > MAX_SCHED_STEAL) n = MAX_SCHED_STEAL;
+        if (n)
+           {jfirst = jlast = qP->First;
+            for (int k = 1; k < n; k++) jlast = jlast->NextJob;
+            if (!(qP->First = jlast->NextJob)) qP->Last = 0;
+            qP->numInQ -= n;
+           }
+        qP->qMutex.UnLock();
+        if (n)
+           {myQ->qMutex.Lock(); myQ->Push(jfirst, jlast, n); myQ->qMutex.UnLock();
+            wakeIdle(n, qnum);
+           }
+        AtomicBeg(DispatchMutex); AtomicAdd(num_Stolen, n+1);
+        AtomicEnd(DispatchMutex);
+        return jp;
+       }
+   return 0;
+}
+
+/******************************************************************************/
+/*                              w a k e I d l e                               */
+/******************************************************************************/
+  
+// Claim and post up to num idle workers, preferring those homed on queue qnum.
+// The common case, when all workers are busy, costs a single atomic fetch.
+//
+int XrdScheduler::wakeIdle(int num, int qnum)
+{
+   XrdSchedulerQ *qP;
+   int i, n, idle, numw = 0;
+
+   AtomicBeg(DispatchMutex); idle = AtomicGet(idl_Workers);
+   AtomicEnd(DispatchMutex);
+   if (idle <= 0) return 0;
+
+   for (i = 0; i < num_RunQ && numw < num; i++)
+       {qP = &runQ[(qnum+i) % num_RunQ];
+        if (!qP->numIdle) continue;
+        qP->qMutex.Lock();
+        if ((n = qP->numIdle) > num - numw) n = num - numw;
+        qP->numIdle -= n;
+        qP->qMutex.UnLock();
+        numw += n;
+        while(n-- > 0) qP->qReady.Post();
+       }
+
+   if (numw)
+      {AtomicBeg(DispatchMutex); AtomicSub(idl_Workers, numw);
+       AtomicEnd(DispatchMutex);
+      }
+   return numw;
+}
+
 /******************************************************************************/
 /*                             t r a c e E x i t                              */
 /******************************************************************************/
@@ -37,15 +37,18 @@
 
 class XrdOucTrace;
 class XrdSchedulerPID;
+class XrdSchedulerQ;
 class XrdSysError;
 
 #define MAX_SCHED_PROCS 30000
+#define MAX_SCHED_RUNQ    256
 
 class XrdScheduler : public XrdJob
 {
 public:
 
-int           Active() {return num_Workers - idl_Workers + num_JobsinQ;}
+int           Active() {return num_Workers - idl_Workers
+                                + (runQ ? inQueue() : num_JobsinQ);}
 
 void          Cancel(XrdJob *jp);
 
@@ -66,6 +69,12 @@ void          Schedule(XrdJob *jp, time_t atime);
 
 void          setParms(int minw, int maxw, int avlt, int maxi, int once=0);
 
+// setRunQ() selects per-core run queues with work stealing instead of the
+// single global queue. It must be called before Start(). A value of zero
+// keeps the global queue, a negative value uses one queue per online cpu.
+//
+void          setRunQ(int numq);
+
 void          Start();
 
 int           Stats(char *buff, int blen, int do_sync=0);
@@ -79,6 +88,7 @@ int        num_TDestroy;// Number of threads destroyed
 int        num_Jobs;    // Number of jobs scheduled
 int        max_QLength; // Longest queue length we had
 int        num_Limited; // Number of times max was reached
+int        num_Stolen;  // Number of jobs taken from another run queue
 
 // Constructor and destructor
 //
@@ -114,7 +124,15 @@ XrdSysMutex            TimerMutex; // Protects scheduler area
 XrdSchedulerPID       *firstPID;
 XrdSysMutex            ReaperMutex;
 
+XrdSchedulerQ         *runQ;       // Per-core run queues (0 -> WorkFirst)
+int                    num_RunQ;   // Number of run queues requested/in runQ
+
 void hireWorker(int dotrace=1);
+int  inQueue();
+int  pickQ(XrdJob *jp);
+void runQueued();
+XrdJob *stealJob(XrdSchedulerQ *myQ, int dolock);
+int  wakeIdle(int num, int qnum);
 void Monitor();
 void traceExit(pid_t pid, int status);
 static const char *TraceID;
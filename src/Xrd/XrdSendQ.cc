@@ -81,7 +81,7 @@ XrdSendQ::XrdSendQ(XrdLink &lP, XrdSysMutex &mP)
                   : XrdJob("sendQ runner"),
                     mLink(lP), wMutex(mP),
                     fMsg(0), lMsg(0), delQ(0), theFD(lP.FDnum()),
-                    inQ(0), qWmsg(qWarn), discards(0),
+                    inQ(0), inFlight(0), qWmsg(qWarn), discards(0),
                     active(false), terminate(false) {}
   
 /******************************************************************************/
@@ -91,8 +91,8 @@ XrdSendQ::XrdSendQ(XrdLink &lP, XrdSysMutex &mP)
 void XrdSendQ::DoIt()
 {
    mBuff   *theMsg;
-   int      myFD, rc;
-   bool     theEnd;
+   int      myFD;
+   bool     theEnd, isOK;
 
 // Obtain the lock
 //
@@ -102,16 +102,18 @@ void XrdSendQ::DoIt()
 //
    if (delQ) {RelMsgs(delQ); delQ = 0;}
 
-// Send all queued messages (we can use a blocking send here)
+// Send all queued messages (we can use a blocking send here). We take the
+// whole queue at once so that the lock is not needed while the messages are
+// combined into as few writes as possible. New messages queue up behind them.
 //
    while(!terminate && (theMsg = fMsg))
-        {if (!(fMsg = fMsg->next)) lMsg = 0;
-         inQ--; myFD = theFD;
+        {fMsg = lMsg = 0;
+         inFlight = inQ; inQ = 0; myFD = theFD;
          wMutex.UnLock();
-         rc = send(myFD, theMsg->mData, theMsg->mLen, 0);
-         free(theMsg);
+         isOK = SendAll(myFD, theMsg);
          wMutex.Lock();
-         if (rc < 0) {Scuttle(); break;}
+         inFlight = 0;
+         if (!isOK) {Scuttle(); break;}
         }
 
 // Before we exit check if we should delete any messages
@@ -137,7 +139,7 @@ bool XrdSendQ::QMsg(XrdSendQ::mBuff *theMsg)
 {
 // Check if we reached the max number of messages
 //
-   if (inQ >= qMax)
+   if (inQ + inFlight >= qMax)
       {discards++;
        if ((discards & 0xff) == 0x01)
           {char qBuff[80];
@@ -210,6 +212,59 @@ void XrdSendQ::Scuttle() // qMutex must be locked!
       }
 }
 
+/******************************************************************************/
+/* Private:                      S e n d A l l                                */
+/******************************************************************************/
+
+// Called with wMutex unlocked. All the messages are freed upon return.
+
+bool XrdSendQ::SendAll(int fd, XrdSendQ::mBuff *mP)
+{
+   struct iovec iov[maxIOV], *ioV;
+   mBuff  *xP, *freeMP;
+   ssize_t retc;
+   int     ioN, numSent = 0;
+   bool    isDone;
+
+// Write out the messages, up to maxIOV of them at a time. A writev() to a
+// socket may stop short at any point, so we resume where it left off. Before
+// each write we briefly take the lock to account for the messages sent so far
+// and to stop should the queue have been terminated or the link closed, as
+// the file descriptor may then be reused for something else.
+//
+   while(mP)
+        {wMutex.Lock();
+         inFlight -= numSent; numSent = 0;
+         isDone = terminate || theFD != fd;
+         wMutex.UnLock();
+         if (isDone) {RelMsgs(mP); return true;}
+         for (xP = mP, ioN = 0; xP && ioN < maxIOV; xP = xP->next, ioN++)
+             {iov[ioN].iov_base = xP->mData;
+              iov[ioN].iov_len  = xP->mLen;
+             }
+         ioV = iov;
+         while(ioN)
+              {do {retc = writev(fd, ioV, ioN);}
+                  while(retc < 0 && errno == EINTR);
+               if (retc < 0) {RelMsgs(mP); return false;}
+               while(ioN && retc >= static_cast<ssize_t>(ioV->iov_len))
+                    {retc -= ioV->iov_len; ioV++; ioN--;}
+               if (ioN)
+                  {ioV->iov_base = (char *)ioV->iov_base + retc;
+                   ioV->iov_len -= retc;
+                  }
+              }
+         while(mP != xP)
+              {freeMP = mP; mP = mP->next;
+               free(freeMP); numSent++;
+              }
+        }
+
+// All done, the caller accounts for the last batch
+//
+   return true;
+}
+
 /******************************************************************************/
 /*                                  S e n d                                   */
 /******************************************************************************/
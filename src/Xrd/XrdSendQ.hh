@@ -43,7 +43,7 @@ class XrdSendQ : public XrdJob
 {
 public:
 
-unsigned int  Backlog() {return inQ;}
+unsigned int  Backlog() {return inQ + inFlight;}
 
 virtual  void DoIt();
 
@@ -80,6 +80,9 @@ char   mData[4]; // Always made long enough
 bool     QMsg(mBuff *theMsg);
 void     RelMsgs(mBuff *mP);
 void     Scuttle();
+bool     SendAll(int fd, mBuff *mP);
+
+static const int     maxIOV = 256; // Max messages per writev()
 
 static XrdScheduler *Sched;
 static XrdSysError  *Say;
@@ -94,6 +97,7 @@ mBuff               *lMsg;
 mBuff               *delQ;
 int                  theFD;
 unsigned int         inQ;
+unsigned int         inFlight;     // Taken by DoIt() but not yet sent (wMutex)
 unsigned int         qWmsg;
 unsigned short       discards;
 bool                 active;
@@ -90,6 +90,11 @@ XrdAccAccess::XrdAccAccess(XrdSysError *erp)
 // Get the audit option that we should use
 //
    Auditor = XrdAccAuditObject(erp);
+
+// Start with empty tables
+//
+   CPP_ATOMIC_STORE(Atab, new XrdAccAccess_Tables, std::memory_order_release);
+   Retired = 0;
 }
 
 /******************************************************************************/
@@ -106,23 +111,24 @@ XrdAccPrivs XrdAccAccess::Access(const XrdSecEntity    *Entity,
    XrdAccGroupList *glp;
    XrdAccPrivCaps caps;
    XrdAccCapability *cp;
+   XrdAccAccess_Tables *tP;
    const int plen  = strlen(path);
    const long phash = XrdOucHashVal2(path, plen);
    const char *id   = (Entity->name ? (const char *)Entity->name : "*");
    const char *host = 0;
    int n, isuser = (*id && (*id != '*' || id[1]));
 
-// Get a shared context for these potentially long running routines
+// Get hold of the current tables for these potentially long running routines
 //
-   Access_Context.Lock(xs_Shared);
+   tP = Attach();
 
 // Run through the exclusive list first as only one rule will apply
 //
-   XrdAccAccess_ID *xlP = Atab.SXList;
+   XrdAccAccess_ID *xlP = tP->SXList;
    while (xlP)
          {if (xlP->Applies(Entity))
              {xlP->caps->Privs(caps, path, plen, phash);
-              Access_Context.UnLock(xs_Shared);
+              Detach(tP);
               return Access(caps, Entity, path, oper);
              }
           xlP = xlP->next;
@@ -130,45 +136,45 @@ XrdAccPrivs XrdAccAccess::Access(const XrdSecEntity    *Entity,
 
 // Check if we really need to resolve the host name
 //
-   if (Atab.D_List || Atab.H_Hash || Atab.N_Hash) host = Resolve(Entity);
+   if (tP->D_List || tP->H_Hash || tP->N_Hash) host = Resolve(Entity);
 
 // Establish default privileges
 //
-   if (Atab.Z_List) Atab.Z_List->Privs(caps, path, plen, phash);
+   if (tP->Z_List) tP->Z_List->Privs(caps, path, plen, phash);
 
 // Next add in the host domain privileges
 //
-   if (Atab.D_List && host && (cp = Atab.D_List->Find(host)))
+   if (tP->D_List && host && (cp = tP->D_List->Find(host)))
       cp->Privs(caps, path, plen, phash);
 
 // Next add in the host-specific privileges
 //
-   if (Atab.H_Hash && host && (cp = Atab.H_Hash->Find(host)))
+   if (tP->H_Hash && host && (cp = tP->H_Hash->Find(host)))
       cp->Privs(caps, path, plen, phash);
 
 // Check for user fungible privileges
 //
-   if (isuser && Atab.X_List) Atab.X_List->Privs(caps, path, plen, phash, id);
+   if (isuser && tP->X_List) tP->X_List->Privs(caps, path, plen, phash, id);
 
 // Add in specific user privileges
 //
-   if (isuser && Atab.U_Hash && (cp = Atab.U_Hash->Find(id)))
+   if (isuser && tP->U_Hash && (cp = tP->U_Hash->Find(id)))
       cp->Privs(caps, path, plen, phash);
 
 // Next add in the group privileges. The group list either comes from the
 // credentials, in which case we need not have a username, or from the
 // standard unix-username group mapping.
 //
-   if (Atab.G_Hash)
+   if (tP->G_Hash)
       {if (Entity->grps)
           {xP = Entity->grps;
            while((n = XrdOucUtils::Token(&xP, ' ', xBuff, sizeof(xBuff))))
-                {if (n < (int)sizeof(xBuff) && (cp = Atab.G_Hash->Find(xBuff)))
+                {if (n < (int)sizeof(xBuff) && (cp = tP->G_Hash->Find(xBuff)))
                     cp->Privs(caps, path, plen, phash);
                 }
           } else if (isuser && (glp=XrdAccConfiguration.GroupMaster.Groups(id)))
                     {while((gname = (char *)glp->Next()))
-                          if ((cp = Atab.G_Hash->Find((const char *)gname)))
+                          if ((cp = tP->G_Hash->Find((const char *)gname)))
                              cp->Privs(caps, path, plen, phash);
                      delete glp;
                     }
@@ -176,45 +182,45 @@ XrdAccPrivs XrdAccAccess::Access(const XrdSecEntity    *Entity,
 
 // Now add in the netgroup privileges
 //
-   if (Atab.N_Hash && id && host && 
+   if (tP->N_Hash && id && host && 
        (glp = XrdAccConfiguration.GroupMaster.NetGroups(id, host)))
       {while((gname = (char *)glp->Next()))
-            if ((cp = Atab.N_Hash->Find((const char *)gname)))
+            if ((cp = tP->N_Hash->Find((const char *)gname)))
                cp->Privs(caps, path, plen, phash);
        delete glp;
       }
 
 // Next add in the org-specific privileges
 //
-   if (Atab.O_Hash && Entity->vorg)
+   if (tP->O_Hash && Entity->vorg)
       {xP = Entity->vorg;
        while((n = XrdOucUtils::Token(&xP, ' ', xBuff, sizeof(xBuff))))
-            {if (n < (int)sizeof(xBuff) && (cp = Atab.O_Hash->Find(xBuff)))
+            {if (n < (int)sizeof(xBuff) && (cp = tP->O_Hash->Find(xBuff)))
                 cp->Privs(caps, path, plen, phash);
             }
       }
 
 // Next add in the role-specific privileges
 //
-   if (Atab.R_Hash && Entity->role)
+   if (tP->R_Hash && Entity->role)
       {xP = Entity->role;
        while((n = XrdOucUtils::Token(&xP, ' ', xBuff, sizeof(xBuff))))
-            {if (n < (int)sizeof(xBuff) && (cp = Atab.R_Hash->Find(xBuff)))
+            {if (n < (int)sizeof(xBuff) && (cp = tP->R_Hash->Find(xBuff)))
                 cp->Privs(caps, path, plen, phash);
             }
       }
 
 // Finally run through the inclusive list and apply arr relevant rules
 //
-   XrdAccAccess_ID *ylP = Atab.SYList;
+   XrdAccAccess_ID *ylP = tP->SYList;
    while (ylP)
          {if (ylP->Applies(Entity)) ylP->caps->Privs(caps, path, plen, phash);
           ylP = ylP->next;
          }
 
-// We are now done with looking at changeable data
+// We are now done with looking at the tables
 //
-   Access_Context.UnLock(xs_Shared);
+   Detach(tP);
 
 // Return the privileges as needed
 //
@@ -313,41 +319,57 @@ const char *XrdAccAccess::Resolve(const XrdSecEntity *Entity)
 /*                              S w a p T a b s                               */
 /******************************************************************************/
 
-#define XrdAccSWAP(x) oldtab.x = Atab.x;   Atab.x  =  newtab.x; \
-                      newtab.x = oldtab.x; oldtab.x = 0;
+#define XrdAccMOVE(x) tP->x = newtab.x; newtab.x = 0;
 
 void XrdAccAccess::SwapTabs(struct XrdAccAccess_Tables &newtab)
 {
-     struct XrdAccAccess_Tables oldtab;
-
-// Get an exclusive context to change the table pointers
-//
-   Access_Context.Lock(xs_Exclusive);
+   XrdAccAccess_Tables *tP = new XrdAccAccess_Tables, *oldP, *rP, **pP;
+   int n;
+
+// Move the new tables into their own object leaving newtab empty
+//
+   XrdAccMOVE(D_List);
+   XrdAccMOVE(E_List);
+   XrdAccMOVE(G_Hash);
+   XrdAccMOVE(H_Hash);
+   XrdAccMOVE(N_Hash);
+   XrdAccMOVE(O_Hash);
+   XrdAccMOVE(R_Hash);
+   XrdAccMOVE(S_Hash);
+   XrdAccMOVE(T_Hash);
+   XrdAccMOVE(U_Hash);
+   XrdAccMOVE(X_List);
+   XrdAccMOVE(Z_List);
+   XrdAccMOVE(SXList);
+   XrdAccMOVE(SYList);
+
+// Compile the capability lists before anyone can see them
+//
+   tP->Compile();
+
+// Delete the tables retired by previous swaps that nobody uses anymore. Swaps
+// are at least an authrefresh interval (a minute or more) apart, so whoever
+// picked up such tables before they were retired has long since registered
+// as a reader.
+//
+   pP = &Retired;
+   while((rP = *pP))
+        {AtomicBeg(tabMutex);
+         n = AtomicGet(rP->Readers);
+         AtomicEnd(tabMutex);
+         if (n) pP = &(rP->Next);
+            else {*pP = rP->Next; delete rP;}
+        }
 
-// Save the old pointer while replacing it with the new pointer
+// Publish the new tables and retire the old ones
 //
-   XrdAccSWAP(D_List);
-   XrdAccSWAP(E_List);
-   XrdAccSWAP(G_Hash);
-   XrdAccSWAP(H_Hash);
-   XrdAccSWAP(N_Hash);
-   XrdAccSWAP(O_Hash);
-   XrdAccSWAP(R_Hash);
-   XrdAccSWAP(S_Hash);
-   XrdAccSWAP(T_Hash);
-   XrdAccSWAP(U_Hash);
-   XrdAccSWAP(X_List);
-   XrdAccSWAP(Z_List);
-   XrdAccSWAP(SXList);
-   XrdAccSWAP(SYList);
+   oldP = CPP_ATOMIC_LOAD(Atab, std::memory_order_acquire);
+   CPP_ATOMIC_STORE(Atab, tP, std::memory_order_seq_cst);
+   oldP->Next = Retired; Retired = oldP;
 
 // When we set new access tables, we should purge the group cache
 //
    XrdAccConfiguration.GroupMaster.PurgeCache();
-
-// We can now let loose new table searchers
-//
-   Access_Context.UnLock(xs_Exclusive);
 }
 
 /******************************************************************************/
@@ -377,6 +399,42 @@ int XrdAccAccess::Test(const XrdAccPrivs priv,const Access_Operation oper)
    return (int)(need[oper] & priv) == need[oper];
 }
 
+/******************************************************************************/
+/*          X r d A c c A c c e s s _ T a b l e s : : C o m p i l e           */
+/******************************************************************************/
+
+namespace
+{
+int CompileCaps(const char *, XrdAccCapability *cP, void *)
+{
+   cP->Compile();
+   return 0;
+}
+
+int CompileIDs(const char *, XrdAccAccess_ID *idP, void *)
+{
+   if (idP->caps) idP->caps->Compile();
+   return 0;
+}
+}
+
+// The fungible list is not compiled as it is always searched with the user
+// name substituted into its paths.
+//
+void XrdAccAccess_Tables::Compile()
+{
+   if (G_Hash) G_Hash->Apply(CompileCaps, 0);
+   if (H_Hash) H_Hash->Apply(CompileCaps, 0);
+   if (N_Hash) N_Hash->Apply(CompileCaps, 0);
+   if (O_Hash) O_Hash->Apply(CompileCaps, 0);
+   if (R_Hash) R_Hash->Apply(CompileCaps, 0);
+   if (S_Hash) S_Hash->Apply(CompileIDs,  0);
+   if (T_Hash) T_Hash->Apply(CompileCaps, 0);
+   if (U_Hash) U_Hash->Apply(CompileCaps, 0);
+   if (D_List) D_List->Compile();
+   if (Z_List) Z_List->Compile();
+}
+
 /******************************************************************************/
 /*              X r d A c c A c c e s s _ I D : : A p p l i e s               */
 /******************************************************************************/
@@ -35,8 +35,9 @@
 #include "XrdAcc/XrdAccCapability.hh"
 #include "XrdSec/XrdSecEntity.hh"
 #include "XrdOuc/XrdOucHash.hh"
-#include "XrdSys/XrdSysXSLock.hh"
+#include "XrdSys/XrdSysAtomics.hh"
 #include "XrdSys/XrdSysPlatform.hh"
+#include "XrdSys/XrdSysPthread.hh"
 
 /******************************************************************************/
 /*                     S e t T a b s   P a r a m e t e r                      */
@@ -95,6 +96,10 @@ struct XrdAccAccess_Tables
                   XrdAccCapability  *Z_List;  // Default  capbailities
                   XrdAccAccess_ID   *SXList;  // 's' exclusive list
                   XrdAccAccess_ID   *SYList;  // 's' inclusive list
+                  XrdAccAccess_Tables *Next;  // Retired tables
+                  int                Readers; // Threads using the tables
+
+        void      Compile();
 
         XrdAccAccess_Tables() {G_Hash = 0; H_Hash = 0; N_Hash = 0;
                                O_Hash = 0; R_Hash = 0;
@@ -102,6 +107,7 @@ struct XrdAccAccess_Tables
                                D_List = 0; E_List = 0;
                                X_List = 0; Z_List = 0;
                                SXList = 0; SYList = 0;
+                               Next   = 0; Readers = 0;
                               }
        ~XrdAccAccess_Tables() {if (G_Hash) delete G_Hash;
                                if (H_Hash) delete H_Hash;
@@ -143,7 +149,9 @@ static
 const char       *Resolve(const XrdSecEntity *Entity);
 
 // SwapTabs() is used by the configuration object to establish new access
-// control tables. It may be called whenever the tables change.
+// control tables. It may be called whenever the tables change, though by a
+// single thread at a time. The tables are compiled and then published with a
+// single pointer store, so Access() never waits for a swap.
 //
 void              SwapTabs(struct XrdAccAccess_Tables &newtab);
 
@@ -160,9 +168,35 @@ XrdAccPrivs Access(      XrdAccPrivCaps  &caps,
                    const char            *path,
                    const Access_Operation oper);
 
-struct XrdAccAccess_Tables Atab;
-
-XrdSysXSLock Access_Context;
+// Tables once published are never changed. Each Access() registers itself as
+// a reader of the tables it picked up, and tables replaced by a swap are only
+// deleted by a later swap once they have no readers left. Once registered we
+// make sure the tables are still current. If a swap came in between we let go
+// of them and try again, so the tables we use were retired, if at all, after
+// we registered and can't be deleted under us.
+//
+XrdAccAccess_Tables *Attach()
+                    {XrdAccAccess_Tables *tP;
+                     do {tP = CPP_ATOMIC_LOAD(Atab, std::memory_order_acquire);
+                         AtomicBeg(tabMutex);
+                         AtomicInc(tP->Readers);
+                         AtomicEnd(tabMutex);
+                         if (tP == CPP_ATOMIC_LOAD(Atab, std::memory_order_seq_cst))
+                            return tP;
+                         Detach(tP);
+                        } while(1);
+                    }
+
+void                 Detach(XrdAccAccess_Tables *tP)
+                    {AtomicBeg(tabMutex);
+                     AtomicDec(tP->Readers);
+                     AtomicEnd(tabMutex);
+                    }
+
+CPP_ATOMIC_TYPE(XrdAccAccess_Tables *) Atab;
+XrdAccAccess_Tables *Retired;
+
+XrdSysMutex tabMutex;
 
 XrdAccAudit *Auditor;
 };
@@ -28,6 +28,8 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <algorithm>
+
 #include "XrdAcc/XrdAccCapability.hh"
 
 /******************************************************************************/
@@ -46,7 +48,7 @@ XrdAccCapability::XrdAccCapability(char *pathval, XrdAccPrivCaps &privval)
 
 // Do common initialization
 //
-   next = 0; ctmp = 0;
+   next = 0; ctmp = 0; trie = 0;
    priv.pprivs = privval.pprivs; priv.nprivs = privval.nprivs;
    plen = strlen(pathval); pins = 0; prem = 0;
    pkey = XrdOucHashVal2((const char *)pathval, plen);
@@ -71,10 +73,20 @@ XrdAccCapability::~XrdAccCapability()
      XrdAccCapability *cp, *np = next;
 
      if (path) {free(path); path = 0;}
+     if (trie) {delete trie; trie = 0;}
 
      while(np) {cp = np; np = np->next; cp->next = 0; delete cp;}
      next = 0;
 }
+/******************************************************************************/
+/*                               C o m p i l e                                */
+/******************************************************************************/
+
+void XrdAccCapability::Compile()
+{
+   if (!trie) trie = new XrdAccCapTrie(this);
+}
+
 /******************************************************************************/
 /*                                 P r i v s                                  */
 /******************************************************************************/
@@ -87,6 +99,8 @@ int XrdAccCapability::Privs(      XrdAccPrivCaps &pathpriv,
 {XrdAccCapability *cp=this;
  const int psl = (pathsub ? strlen(pathsub) : 0);
 
+ if (trie && !pathsub) return trie->Privs(pathpriv, pathname, pathlen);
+
  do {if (cp->ctmp)
        {if (cp->ctmp->Privs(pathpriv,pathname,pathlen,pathhash,pathsub))
            return 1;
@@ -153,6 +167,18 @@ XrdAccCapName::~XrdAccCapName()
    while(np) {cp = np; np = np->next; cp->next = 0; delete cp;}
 }
   
+/******************************************************************************/
+/*                               C o m p i l e                                */
+/******************************************************************************/
+
+void XrdAccCapName::Compile()
+{
+   XrdAccCapName *ncp = this;
+
+   do {if (ncp->C_List) ncp->C_List->Compile();
+      } while((ncp = ncp->next));
+}
+
 /******************************************************************************/
 /*                                  F i n d                                   */
 /******************************************************************************/
@@ -168,3 +194,159 @@ XrdAccCapability *XrdAccCapName::Find(const char *name)
       } while(ncp);
    return (XrdAccCapability *)0;
 }
+
+/******************************************************************************/
+/*                         X r d A c c C a p T r i e                          */
+/******************************************************************************/
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdAccCapTrie::XrdAccCapTrie(XrdAccCapability *caps) : Nodes(0), Pool(0)
+{
+   std::vector<Rule>  rules;
+   std::vector<TNode> nodes;
+   char *pP;
+   int i, j, n, psz = 0;
+
+// Flatten the list, templates included, in the order Privs() looks at it
+//
+   Flatten(caps, rules);
+   n = rules.size();
+   for (i = 0; i < n; i++) rules[i].rank = i;
+
+// Sort the rules by path. Of identical paths only the first one can ever
+// match so the others are dropped.
+//
+   std::sort(rules.begin(), rules.end(), Before);
+   for (i = j = 0; i < n; i++)
+       {if (j && rules[i].plen == rules[j-1].plen
+        &&  !memcmp(rules[i].path, rules[j-1].path, rules[i].plen)) continue;
+        rules[j++] = rules[i];
+       }
+   rules.resize(j); n = j;
+
+// Copy the paths into a single pool so that edge labels are just offsets
+//
+   for (i = 0; i < n; i++) psz += rules[i].plen;
+   pP = Pool = (char *)malloc(psz ? psz : 1);
+   for (i = 0; i < n; i++)
+       {memcpy(pP, rules[i].path, rules[i].plen);
+        rules[i].path = pP; pP += rules[i].plen;
+       }
+
+// Build the tree under an empty root and copy it into its final place
+//
+   nodes.resize(1);
+   Build(nodes, rules, 0, 0, n, 0);
+   Nodes = new TNode[nodes.size()];
+   std::copy(nodes.begin(), nodes.end(), Nodes);
+}
+
+/******************************************************************************/
+/*                                 P r i v s                                  */
+/******************************************************************************/
+
+int XrdAccCapTrie::Privs(      XrdAccPrivCaps &pathpriv,
+                         const char           *pathname,
+                         const int             pathlen)
+{
+   const TNode *np = Nodes, *kp, *best = 0;
+   int pos = 0, lo, hi, mid;
+   unsigned char c;
+
+// Walk down the tree as far as the path goes, remembering the earliest rule
+//
+   while(1)
+        {if (np->rule >= 0 && (!best || np->rule < best->rule)) best = np;
+         if (pos >= pathlen || !np->nkid) break;
+         c = (unsigned char)pathname[pos];
+         lo = np->kid; hi = lo + np->nkid - 1; kp = 0;
+         while(lo <= hi)
+              {mid = (lo + hi) >> 1;
+                    if (Nodes[mid].key < c) lo = mid + 1;
+               else if (Nodes[mid].key > c) hi = mid - 1;
+               else {kp = &Nodes[mid]; break;}
+              }
+         if (!kp || kp->llen > pathlen - pos
+         ||  memcmp(Pool + kp->lab, pathname + pos, kp->llen)) break;
+         pos += kp->llen; np = kp;
+        }
+
+// Return the privileges of the rule that would have been found first
+//
+   if (!best) return 0;
+   pathpriv.pprivs = (XrdAccPrivs)(pathpriv.pprivs | best->priv.pprivs);
+   pathpriv.nprivs = (XrdAccPrivs)(pathpriv.nprivs | best->priv.nprivs);
+   return 1;
+}
+
+/******************************************************************************/
+/* Private:                       B e f o r e                                 */
+/******************************************************************************/
+
+bool XrdAccCapTrie::Before(const Rule &a, const Rule &b)
+{
+   int rc = memcmp(a.path, b.path, (a.plen < b.plen ? a.plen : b.plen));
+
+   if (rc) return rc < 0;
+   if (a.plen != b.plen) return a.plen < b.plen;
+   return a.rank < b.rank;
+}
+
+/******************************************************************************/
+/* Private:                        B u i l d                                  */
+/******************************************************************************/
+
+// Fill in node 'slot' for the sorted rules [lo,hi) which all share their first
+// 'depth' bytes. A rule ending right here sorts first. The remaining rules
+// form one child per distinct next byte; the children are placed next to
+// each other so that a lookup can binary search them.
+//
+void XrdAccCapTrie::Build(std::vector<TNode> &nodes, std::vector<Rule> &rules,
+                          int slot, int lo, int hi, int depth)
+{
+   int a, b, k, kid, lcp;
+
+   if (lo < hi && rules[lo].plen == depth)
+      {nodes[slot].rule = rules[lo].rank;
+       nodes[slot].priv = rules[lo].priv;
+       lo++;
+      }
+
+   for (k = 0, a = lo; a < hi; k++, a = b)
+       for (b = a+1; b < hi && rules[b].path[depth] == rules[a].path[depth];) b++;
+   if (!k) return;
+
+   kid = nodes.size();
+   nodes.resize(kid + k);
+   nodes[slot].kid = kid; nodes[slot].nkid = k;
+
+   for (a = lo; a < hi; a = b, kid++)
+       {for (b = a+1; b < hi && rules[b].path[depth] == rules[a].path[depth];)
+            b++;
+        const Rule &fr = rules[a], &lr = rules[b-1];
+        for (lcp = depth; lcp < fr.plen && lcp < lr.plen
+                       && fr.path[lcp] == lr.path[lcp];) lcp++;
+        nodes[kid].key  = (unsigned char)fr.path[depth];
+        nodes[kid].lab  = (fr.path - Pool) + depth;
+        nodes[kid].llen = lcp - depth;
+        Build(nodes, rules, kid, a, b, lcp);
+       }
+}
+
+/******************************************************************************/
+/* Private:                      F l a t t e n                                */
+/******************************************************************************/
+
+void XrdAccCapTrie::Flatten(XrdAccCapability *cp, std::vector<Rule> &rules)
+{
+   Rule r;
+
+   do {if (cp->ctmp) Flatten(cp->ctmp, rules);
+          else {r.path = cp->path; r.plen = cp->plen; r.rank = 0;
+                r.priv = cp->priv;
+                rules.push_back(r);
+               }
+      } while((cp = cp->next));
+}
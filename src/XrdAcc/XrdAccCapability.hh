@@ -33,9 +33,12 @@
 #include <stdlib.h>
 #include <string.h>
 #include <strings.h>
+#include <vector>
 
 #include "XrdAcc/XrdAccPrivs.hh"
 
+class XrdAccCapTrie;
+
 /******************************************************************************/
 /*                      X r d A c c C a p a b i l i t y                       */
 /******************************************************************************/
@@ -45,6 +48,12 @@ class XrdAccCapability
 public:
 void                Add(XrdAccCapability *newcap) {next = newcap;}
 
+// Compile() turns the list headed by this capability into a prefix trie that
+// Privs() then uses for lookups without a substitution. It must be called
+// before the list becomes visible to other threads.
+//
+void                Compile();
+
 XrdAccCapability   *Next() {return next;}
 
 // Privs() searches the associated capability for a prefix matching path. If one
@@ -79,14 +88,17 @@ int                 Subcomp(const char *pathname, const int pathlen,
                   XrdAccCapability(char *pathval, XrdAccPrivCaps &privval);
 
                   XrdAccCapability(XrdAccCapability *taddr)
-                        {next = 0; ctmp = taddr;
+                        {next = 0; ctmp = taddr; trie = 0;
                          pkey = 0; path = 0; plen = 0; pins = 0; prem = 0;
                         }
 
                  ~XrdAccCapability();
 private:
+friend class XrdAccCapTrie;
+
 XrdAccCapability *next;      // -> Next capability
 XrdAccCapability *ctmp;      // -> Capability template
+XrdAccCapTrie    *trie;      // -> Compiled list (list head only)
 
 /*----------- The below fields are valid when template is zero -----------*/
 
@@ -107,6 +119,8 @@ class XrdAccCapName
 public:
 void              Add(XrdAccCapName *cnp) {next = cnp;}
 
+void              Compile();
+
 XrdAccCapability *Find(const char *name);
 
        XrdAccCapName(char *name, XrdAccCapability *cap)
@@ -120,4 +134,55 @@ char             *CapName;
 int               CNlen;
 XrdAccCapability *C_List;
 };
+
+/******************************************************************************/
+/*                         X r d A c c C a p T r i e                          */
+/******************************************************************************/
+
+// A capability list is compiled into a radix tree of its paths, templates
+// expanded in place. Each node records the earliest rule in list order that
+// ends there, so walking down the tree along a path and keeping the earliest
+// rule seen yields exactly what scanning the list for the first matching
+// prefix would. The tree is built once and never changed afterwards.
+//
+class XrdAccCapTrie
+{
+public:
+
+int               Privs(      XrdAccPrivCaps &pathpriv,
+                        const char           *pathname,
+                        const int             pathlen);
+
+                  XrdAccCapTrie(XrdAccCapability *caps);
+
+                 ~XrdAccCapTrie() {if (Nodes) delete [] Nodes;
+                                   if (Pool)  free(Pool);
+                                  }
+private:
+
+struct Rule  {const char     *path;
+              int             plen;
+              int             rank;
+              XrdAccPrivCaps  priv;
+             };
+
+struct TNode {int             lab;    // Offset in Pool of the edge label
+              int             llen;   // Length of the edge label
+              int             kid;    // Index of first child
+              int             nkid;   // Number of children
+              int             rule;   // Rank of the rule ending here or -1
+              XrdAccPrivCaps  priv;   // Its privileges
+              unsigned char   key;    // First byte of the edge label
+
+              TNode() : lab(0), llen(0), kid(0), nkid(0), rule(-1), key(0) {}
+             };
+
+static bool       Before(const Rule &a, const Rule &b);
+void              Build(std::vector<TNode> &nodes, std::vector<Rule> &rules,
+                        int slot, int lo, int hi, int depth);
+static void       Flatten(XrdAccCapability *cp, std::vector<Rule> &rules);
+
+TNode            *Nodes;
+char             *Pool;
+};
 #endif
@@ -141,6 +141,7 @@ std::map<const char *, const char *, vCmp> vnMap {
 {"sched.tcr",       "Threads created:"},
 {"sched.tde",       "Threads deleted:"},
 {"sched.tlimr",     "Threads unavail:"},
+{"sched.stl",       "Tasks stolen:    "},
 {"sgen.as",         "Unsynchronized stats:"},
 {"sgen.et",         "Mills to collect stats:"},
 {"sgen.toe",        "~Time when stats collected:"},
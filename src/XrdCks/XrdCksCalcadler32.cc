@@ -0,0 +1,127 @@
+/******************************************************************************/
+/*                                                                            */
+/*                  X r d C k s C a l c a d l e r 3 2 . c c                   */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include "XrdCks/XrdCksCalcadler32.hh"
+#include "XrdSys/XrdSysCPU.hh"
+
+#ifdef XRDSYS_CPU_X86
+#include <immintrin.h>
+#endif
+
+/* The scalar implementation of adler32 was derived from zlib, see the zlib
+   license terms in XrdCksCalcadler32.hh.
+*/
+
+#define DO1(buf)  {unSum1 += *buf++; unSum2 += unSum1;}
+#define DO2(buf)  DO1(buf); DO1(buf);
+#define DO4(buf)  DO2(buf); DO2(buf);
+#define DO8(buf)  DO4(buf); DO4(buf);
+#define DO16(buf) DO8(buf); DO8(buf);
+
+/******************************************************************************/
+/*                     H a r d w a r e   A s s i s t s                        */
+/******************************************************************************/
+
+namespace
+{
+#ifdef XRDSYS_CPU_X86
+
+__attribute__((target("avx2")))
+inline unsigned int HSum(__m256i v)
+{
+   __m128i x = _mm_add_epi32(_mm256_castsi256_si128(v),
+                             _mm256_extracti128_si256(v, 1));
+   x = _mm_add_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(1,0,3,2)));
+   x = _mm_add_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(2,3,0,1)));
+   return (unsigned int)_mm_cvtsi128_si32(x);
+}
+
+// Update the adler32 sums with blen bytes, a multiple of 32, using AVX2. For
+// each 32 byte block s1 is incremented by the sum of the bytes and s2 by 32
+// times the previous s1 plus the bytes weighted 32, 31, ... 1. At most nmax
+// bytes are summed before the sums are reduced modulo base.
+//
+__attribute__((target("avx2")))
+void Adler32AVX2(unsigned int &s1, unsigned int &s2, const unsigned char *p,
+                 int blen, unsigned int base, int nmax)
+{
+   const __m256i tap  = _mm256_setr_epi8(32,31,30,29,28,27,26,25,
+                                         24,23,22,21,20,19,18,17,
+                                         16,15,14,13,12,11,10, 9,
+                                          8, 7, 6, 5, 4, 3, 2, 1);
+   const __m256i zero = _mm256_setzero_si256();
+   const __m256i ones = _mm256_set1_epi16(1);
+   __m256i bytes, vps, vs1, vs2;
+   int n, blocks = blen / 32;
+
+   while(blocks)
+        {n = (blocks < nmax/32 ? blocks : nmax/32);
+         blocks -= n;
+         s2 += s1 * n * 32;
+         vps = vs1 = vs2 = zero;
+         do {bytes = _mm256_loadu_si256((const __m256i *)p);
+             vps   = _mm256_add_epi32(vps, vs1);
+             vs1   = _mm256_add_epi32(vs1, _mm256_sad_epu8(bytes, zero));
+             vs2   = _mm256_add_epi32(vs2, _mm256_madd_epi16(
+                                     _mm256_maddubs_epi16(bytes, tap), ones));
+             p += 32;
+            } while(--n);
+         vs2 = _mm256_add_epi32(vs2, _mm256_slli_epi32(vps, 5));
+         s1 += HSum(vs1); s2 += HSum(vs2);
+         s1 %= base; s2 %= base;
+        }
+}
+#endif
+}
+
+/******************************************************************************/
+/*                                U p d a t e                                 */
+/******************************************************************************/
+  
+void XrdCksCalcadler32::Update(const char *Buff, int BLen)
+{
+   unsigned char *buff = (unsigned char *)Buff;
+   int k;
+
+// Sum whole 32 byte blocks with AVX2 when we can
+//
+#ifdef XRDSYS_CPU_X86
+   if (BLen >= 64 && XrdSysCPU::Has(XrdSysCPU::AVX2))
+      {k = BLen & ~31;
+       Adler32AVX2(unSum1, unSum2, buff, k, AdlerBase, AdlerNMax);
+       buff += k; BLen -= k;
+      }
+#endif
+
+// Process the remaining bytes
+//
+   while(BLen > 0)
+        {k = (BLen < AdlerNMax ? BLen : AdlerNMax);
+         BLen -= k;
+         while(k >= 16) {DO16(buff); k -= 16;}
+         if (k != 0) do {DO1(buff);} while (--k);
+         unSum1 %= AdlerBase; unSum2 %= AdlerBase;
+        }
+}
@@ -29,6 +29,11 @@
 /******************************************************************************/
 
 #include "XrdCks/XrdCksCalccrc32.hh"
+#include "XrdSys/XrdSysCPU.hh"
+
+#ifdef XRDSYS_CPU_X86
+#include <immintrin.h>
+#endif
 
 /*
    C++ implementation of CRC-32 checksums.  Code is based
@@ -141,6 +146,93 @@ unsigned int XrdCksCalccrc32::crctable[256] =
 /*                   End of CRC Lookup Table                     */
 /*****************************************************************/
 
+/******************************************************************************/
+/*                     H a r d w a r e   A s s i s t s                        */
+/******************************************************************************/
+
+namespace
+{
+#ifdef XRDSYS_CPU_X86
+
+// Folding constants for the non-reflected CRC-32 polynomial. A 128 bit block
+// is moved D bits ahead by multiplying its high half by x^(D+64) mod P and
+// its low half by x^D mod P. The low quadword of each pair is x^D mod P.
+//
+const unsigned long long crc32K512[2] = {0xe6228b11ULL,   // D = 512
+                                         0x8833794cULL};
+const unsigned long long crc32K128[2] = {0xe8a45605ULL,   // D = 128
+                                         0xc5b9cd4cULL};
+
+// Fold blen bytes (a multiple of 16 and at least 64) using PCLMULQDQ. Input
+// blocks are byte reversed so that the first bit of the data is the most
+// significant one of the register. The crc register is folded into the first
+// block. What is left is a 16 byte block whose CRC, started from a zero
+// register, equals the crc register over the whole input; it is returned in
+// rem to be finished by the table.
+//
+__attribute__((target("ssse3,pclmul")))
+void Fold32(unsigned int crc, const unsigned char *p, size_t blen,
+            unsigned char rem[16])
+{
+   const __m128i bswap = _mm_set_epi8( 0, 1, 2, 3, 4, 5, 6, 7,
+                                       8, 9,10,11,12,13,14,15);
+   __m128i k, x0, x1, x2, x3, y0, y1, y2, y3;
+
+#define LOADR(x) _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(x)), bswap)
+
+   x0 = LOADR(p);
+   x1 = LOADR(p + 16);
+   x2 = LOADR(p + 32);
+   x3 = LOADR(p + 48);
+   x0 = _mm_xor_si128(x0, _mm_slli_si128(_mm_cvtsi32_si128(crc), 12));
+   p += 64; blen -= 64;
+
+// Fold four blocks at a time, this keeps the multipliers busy
+//
+   k = _mm_loadu_si128((const __m128i *)crc32K512);
+   while(blen >= 64)
+        {y0 = _mm_clmulepi64_si128(x0, k, 0x00);
+         y1 = _mm_clmulepi64_si128(x1, k, 0x00);
+         y2 = _mm_clmulepi64_si128(x2, k, 0x00);
+         y3 = _mm_clmulepi64_si128(x3, k, 0x00);
+         x0 = _mm_clmulepi64_si128(x0, k, 0x11);
+         x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+         x2 = _mm_clmulepi64_si128(x2, k, 0x11);
+         x3 = _mm_clmulepi64_si128(x3, k, 0x11);
+         x0 = _mm_xor_si128(_mm_xor_si128(x0, y0), LOADR(p));
+         x1 = _mm_xor_si128(_mm_xor_si128(x1, y1), LOADR(p + 16));
+         x2 = _mm_xor_si128(_mm_xor_si128(x2, y2), LOADR(p + 32));
+         x3 = _mm_xor_si128(_mm_xor_si128(x3, y3), LOADR(p + 48));
+         p += 64; blen -= 64;
+        }
+
+// Reduce the four accumulators to one and fold any remaining blocks
+//
+   k  = _mm_loadu_si128((const __m128i *)crc32K128);
+   y0 = _mm_clmulepi64_si128(x0, k, 0x00);
+   x0 = _mm_clmulepi64_si128(x0, k, 0x11);
+   x0 = _mm_xor_si128(_mm_xor_si128(x0, y0), x1);
+   y0 = _mm_clmulepi64_si128(x0, k, 0x00);
+   x0 = _mm_clmulepi64_si128(x0, k, 0x11);
+   x0 = _mm_xor_si128(_mm_xor_si128(x0, y0), x2);
+   y0 = _mm_clmulepi64_si128(x0, k, 0x00);
+   x0 = _mm_clmulepi64_si128(x0, k, 0x11);
+   x0 = _mm_xor_si128(_mm_xor_si128(x0, y0), x3);
+
+   while(blen >= 16)
+        {y0 = _mm_clmulepi64_si128(x0, k, 0x00);
+         x0 = _mm_clmulepi64_si128(x0, k, 0x11);
+         x0 = _mm_xor_si128(_mm_xor_si128(x0, y0), LOADR(p));
+         p += 16; blen -= 16;
+        }
+
+#undef LOADR
+
+   _mm_storeu_si128((__m128i *)rem, _mm_shuffle_epi8(x0, bswap));
+}
+#endif
+}
+
 /* Calculate CRC-32 Checksum for NAACCR Record,
    skipping area of record containing checksum field.
 
@@ -169,9 +261,24 @@ unsigned int XrdCksCalccrc32::crctable[256] =
 void XrdCksCalccrc32::Update(const char *p, int reclen)
 {
 
-// Process each byte
+// Fold large buffers with carry-less multiplication when we can. Only the
+// folded remainder and the trailing bytes go through the table.
 //
    TotLen += reclen;
+#ifdef XRDSYS_CPU_X86
+   if (reclen >= 64 && XrdSysCPU::Has(XrdSysCPU::SSSE3 | XrdSysCPU::PCLMUL))
+      {unsigned char rem[16];
+       int i, blen = reclen & ~15;
+       Fold32(C32Result, (const unsigned char *)p, blen, rem);
+       C32Result = 0;
+       for (i = 0; i < 16; i++)
+           C32Result = (C32Result<<8) ^ crctable[(C32Result>>24)^rem[i]];
+       p += blen; reclen -= blen;
+      }
+#endif
+
+// Process each byte
+//
    while(reclen-- > 0)
         C32Result = (C32Result<<8) 
                   ^ crctable[(unsigned char)((C32Result>>24)^*p++)];
@@ -0,0 +1,70 @@
+#ifndef __XRDCKSCALCCRC32C_HH__
+#define __XRDCKSCALCCRC32C_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                   X r d C k s C a l c c r c 3 2 C . h h                    */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <sys/types.h>
+#include <netinet/in.h>
+#include <inttypes.h>
+
+#include "XrdCks/XrdCksCalc.hh"
+#include "XrdOuc/XrdOucCRC.hh"
+#include "XrdSys/XrdSysPlatform.hh"
+
+//-----------------------------------------------------------------------------
+//! Calculator for the CRC-32C (Castagnoli) checksum, as used by iSCSI and
+//! many object stores. The result is returned in network byte order.
+//-----------------------------------------------------------------------------
+  
+class XrdCksCalccrc32C : public XrdCksCalc
+{
+public:
+
+char *Final() {TheResult = C32CResult;
+#ifndef Xrd_Big_Endian
+               TheResult = htonl(TheResult);
+#endif
+               return (char *)&TheResult;
+              }
+
+void        Init() {C32CResult = 0;}
+
+XrdCksCalc *New() {return (XrdCksCalc *)new XrdCksCalccrc32C;}
+
+void        Update(const char *Buff, int BLen)
+                  {if (BLen > 0)
+                      C32CResult = XrdOucCRC::Calc32C(Buff, BLen, C32CResult);
+                  }
+
+const char *Type(int &csSz) {csSz = sizeof(TheResult); return "crc32c";}
+
+            XrdCksCalccrc32C() {Init();}
+virtual    ~XrdCksCalccrc32C() {}
+
+private:
+             unsigned int C32CResult;
+             unsigned int TheResult;
+};
+#endif
@@ -34,9 +34,14 @@
 #include "XrdCl/XrdClUglyHacks.hh"
 #include "XrdCl/XrdClRedirectorRegistry.hh"
 #include "XrdCl/XrdClZipArchiveReader.hh"
+#include "XrdCl/XrdClCopyProcess.hh"
+#include "XrdSys/XrdSysPthread.hh"
 #include <memory>
 #include <iostream>
 #include <queue>
+#include <list>
+#include <set>
+#include <vector>
 #include <algorithm>
 
 #include <sys/types.h>
@@ -163,6 +168,291 @@ namespace
       XrdCksCalc  *pCksCalcObj;
   };
 
+  //----------------------------------------------------------------------------
+  //! Data pipeline shared by the source and the destination of a copy job.
+  //!
+  //! Owns a fixed set of reusable chunk buffers, allocated when first needed.
+  //! The source takes a buffer for every chunk it reads and the destination
+  //! gives it back once the chunk has been written, so the number of chunks
+  //! being read or written at the same time is bounded by the number of
+  //! buffers. Buffers that were not obtained from the pipeline (ie. those
+  //! allocated by the XCp context) are deleted when given back.
+  //----------------------------------------------------------------------------
+  class CopyPipeline
+  {
+    public:
+      //------------------------------------------------------------------------
+      //! Constructor
+      //!
+      //! @param chunkSize  size of a chunk buffer
+      //! @param maxBuffers number of chunk buffers
+      //! @param ordered    true if the destination needs chunks in order
+      //------------------------------------------------------------------------
+      CopyPipeline( uint32_t chunkSize, uint32_t maxBuffers, bool ordered ):
+        pCond( 0 ), pChunkSize( chunkSize ), pOrdered( ordered )
+      {
+        pInfo.buffersMax = maxBuffers;
+        gettimeofday( &pStart, 0 );
+      }
+
+      //------------------------------------------------------------------------
+      //! Destructor, all the buffers must have been given back by now
+      //------------------------------------------------------------------------
+      ~CopyPipeline()
+      {
+        std::set<char*>::iterator it;
+        for( it = pBuffers.begin(); it != pBuffers.end(); ++it )
+          delete [] *it;
+      }
+
+      //------------------------------------------------------------------------
+      //! Get a free chunk buffer
+      //!
+      //! @param wait if true wait for a buffer to be given back when all of
+      //!             them are in use, otherwise return 0
+      //------------------------------------------------------------------------
+      char *GetBuffer( bool wait )
+      {
+        XrdSysCondVarHelper lck( pCond );
+        char *buffer = 0;
+        while( pFree.empty() && pBuffers.size() >= pInfo.buffersMax )
+        {
+          if( !wait ) return 0;
+          ++pInfo.bufferStalls;
+          pCond.Wait();
+        }
+        if( pFree.empty() )
+        {
+          buffer = new char[pChunkSize];
+          pBuffers.insert( buffer );
+        }
+        else
+        {
+          buffer = pFree.back();
+          pFree.pop_back();
+        }
+        ++pInfo.buffersInUse;
+        return buffer;
+      }
+
+      //------------------------------------------------------------------------
+      //! Give back a chunk buffer
+      //------------------------------------------------------------------------
+      void Release( void *buffer )
+      {
+        if( !buffer ) return;
+        XrdSysCondVarHelper lck( pCond );
+        if( pBuffers.find( (char*)buffer ) == pBuffers.end() )
+        {
+          delete [] (char*)buffer;
+          return;
+        }
+        pFree.push_back( (char*)buffer );
+        --pInfo.buffersInUse;
+        pCond.Signal();
+      }
+
+      //------------------------------------------------------------------------
+      //! Account for data delivered by the source
+      //------------------------------------------------------------------------
+      void ReadDone( uint32_t length )
+      {
+        XrdSysCondVarHelper lck( pCond );
+        pInfo.bytesRead += length;
+      }
+
+      //------------------------------------------------------------------------
+      //! Account for data written to the destination
+      //------------------------------------------------------------------------
+      void WriteDone( uint32_t length )
+      {
+        XrdSysCondVarHelper lck( pCond );
+        pInfo.bytesWritten += length;
+      }
+
+      //------------------------------------------------------------------------
+      //! Get the state of the pipeline
+      //------------------------------------------------------------------------
+      void GetInfo( XrdCl::CopyPipelineInfo &info )
+      {
+        timeval now;
+        gettimeofday( &now, 0 );
+        XrdSysCondVarHelper lck( pCond );
+        info = pInfo;
+        info.elapsed = XrdCl::Utils::GetElapsedMicroSecs( pStart, now );
+      }
+
+      //------------------------------------------------------------------------
+      //! Number of chunk buffers
+      //------------------------------------------------------------------------
+      uint32_t GetMaxBuffers() const
+      {
+        return pInfo.buffersMax;
+      }
+
+      //------------------------------------------------------------------------
+      //! True if the destination needs the chunks in order
+      //------------------------------------------------------------------------
+      bool IsOrdered() const
+      {
+        return pOrdered;
+      }
+
+    private:
+      CopyPipeline(const CopyPipeline &other);
+      CopyPipeline &operator = (const CopyPipeline &other);
+
+      XrdSysCondVar            pCond;
+      uint32_t                 pChunkSize;
+      bool                     pOrdered;
+      std::set<char*>          pBuffers;
+      std::vector<char*>       pFree;
+      XrdCl::CopyPipelineInfo  pInfo;
+      timeval                  pStart;
+  };
+
+  //----------------------------------------------------------------------------
+  //! Chunks being read asynchronously by a source. The chunks are handed out
+  //! in the order in which the reads complete unless they have to be handed
+  //! out in order of issue.
+  //----------------------------------------------------------------------------
+  class ReadQueue
+  {
+    public:
+      //------------------------------------------------------------------------
+      //! Asynchronous chunk handler
+      //------------------------------------------------------------------------
+      class ChunkHandler: public XrdCl::ResponseHandler
+      {
+        public:
+          ChunkHandler( ReadQueue *queue ): pQueue( queue ), pDone( false ) {}
+          virtual ~ChunkHandler() {}
+          virtual void HandleResponse( XrdCl::XRootDStatus *statusval,
+                                       XrdCl::AnyObject    *response )
+          {
+            this->status = *statusval;
+            delete statusval;
+            if( response )
+            {
+              XrdCl::ChunkInfo *resp = 0;
+              response->Get( resp );
+              if( resp )
+                chunk = *resp;
+              delete response;
+            }
+            pQueue->Done( this );
+          }
+
+          XrdCl::ChunkInfo     chunk;
+          XrdCl::XRootDStatus  status;
+
+        private:
+          friend class ReadQueue;
+          ReadQueue *pQueue;
+          bool       pDone;
+      };
+
+      //------------------------------------------------------------------------
+      //! Constructor
+      //------------------------------------------------------------------------
+      ReadQueue( CopyPipeline *pipeline, bool ordered ):
+        pPipeline( pipeline ), pOrdered( ordered ), pCond( 0 )
+      {
+      }
+
+      //------------------------------------------------------------------------
+      //! Destructor
+      //------------------------------------------------------------------------
+      ~ReadQueue()
+      {
+        CleanUp();
+      }
+
+      //------------------------------------------------------------------------
+      //! Create a handler for a chunk about to be read into the buffer
+      //------------------------------------------------------------------------
+      ChunkHandler *Add( uint64_t offset, uint32_t length, char *buffer )
+      {
+        ChunkHandler *ch = new ChunkHandler( this );
+        ch->chunk.offset = offset;
+        ch->chunk.length = length;
+        ch->chunk.buffer = buffer;
+        XrdSysCondVarHelper lck( pCond );
+        pChunks.push_back( ch );
+        return ch;
+      }
+
+      //------------------------------------------------------------------------
+      //! Mark the read of a chunk as done, called by the handler or by the
+      //! source if the read could not be issued
+      //------------------------------------------------------------------------
+      void Done( ChunkHandler *ch )
+      {
+        XrdSysCondVarHelper lck( pCond );
+        ch->pDone = true;
+        pCond.Signal();
+      }
+
+      //------------------------------------------------------------------------
+      //! Wait for the next chunk, the caller deletes the returned handler
+      //!
+      //! @return the handler of the chunk or 0 if no chunks are being read
+      //------------------------------------------------------------------------
+      ChunkHandler *Next()
+      {
+        XrdSysCondVarHelper lck( pCond );
+        std::list<ChunkHandler*>::iterator it;
+        while( !pChunks.empty() )
+        {
+          if( pOrdered )
+            it = pChunks.front()->pDone ? pChunks.begin() : pChunks.end();
+          else
+            for( it = pChunks.begin(); it != pChunks.end(); ++it )
+              if( (*it)->pDone ) break;
+
+          if( it != pChunks.end() )
+          {
+            ChunkHandler *ch = *it;
+            pChunks.erase( it );
+            return ch;
+          }
+          pCond.Wait();
+        }
+        return 0;
+      }
+
+      //------------------------------------------------------------------------
+      //! Number of chunks being read
+      //------------------------------------------------------------------------
+      bool Empty()
+      {
+        XrdSysCondVarHelper lck( pCond );
+        return pChunks.empty();
+      }
+
+      //------------------------------------------------------------------------
+      //! Wait for the chunks that are flying and give back their buffers
+      //------------------------------------------------------------------------
+      void CleanUp()
+      {
+        ChunkHandler *ch;
+        while( ( ch = Next() ) )
+        {
+          pPipeline->Release( ch->chunk.buffer );
+          delete ch;
+        }
+      }
+
+    private:
+      ReadQueue(const ReadQueue &other);
+      ReadQueue &operator = (const ReadQueue &other);
+
+      CopyPipeline              *pPipeline;
+      bool                       pOrdered;
+      XrdSysCondVar              pCond;
+      std::list<ChunkHandler*>   pChunks;
+  };
+
   //----------------------------------------------------------------------------
   //! Abstract chunk source
   //----------------------------------------------------------------------------
@@ -295,8 +585,10 @@ namespace
       //------------------------------------------------------------------------
       //! Constructor
       //------------------------------------------------------------------------
-      StdInSource( const std::string &ckSumType, uint32_t chunkSize ):
-        pCkSumHelper(0), pCurrentOffset(0), pChunkSize( chunkSize )
+      StdInSource( const std::string &ckSumType, uint32_t chunkSize,
+                   CopyPipeline *pipeline ):
+        pCkSumHelper(0), pCurrentOffset(0), pChunkSize( chunkSize ),
+        pPipeline( pipeline )
       {
         if( !ckSumType.empty() )
           pCkSumHelper = new CheckSumHelper( "stdin", ckSumType );
@@ -337,7 +629,7 @@ namespace
         Log *log = DefaultEnv::GetLog();
 
         uint32_t toRead = pChunkSize;
-        char *buffer = new char[toRead];
+        char *buffer = pPipeline->GetBuffer( true );
 
         int64_t  bytesRead = 0;
         uint32_t offset    = 0;
@@ -348,7 +640,7 @@ namespace
           {
             log->Debug( UtilityMsg, "Unable to read from stdin: %s",
                         strerror( errno ) );
-            delete [] buffer;
+            pPipeline->Release( buffer );
             return XRootDStatus( stError, errOSError, errno );
           }
 
@@ -362,7 +654,7 @@ namespace
 
         if( bytesRead == 0 )
         {
-          delete [] buffer;
+          pPipeline->Release( buffer );
           return XRootDStatus( stOK, suDone );
         }
 
@@ -395,6 +687,7 @@ namespace
       CheckSumHelper *pCkSumHelper;
       uint64_t        pCurrentOffset;
       uint32_t        pChunkSize;
+      CopyPipeline   *pPipeline;
   };
 
   //----------------------------------------------------------------------------
@@ -408,10 +701,10 @@ namespace
       //------------------------------------------------------------------------
       XRootDSource( const XrdCl::URL *url,
                     uint32_t          chunkSize,
-                    uint8_t           parallelChunks ):
+                    CopyPipeline     *pipeline ):
         pUrl( url ), pFile( new XrdCl::File() ), pSize( -1 ),
         pCurrentOffset( 0 ), pChunkSize( chunkSize ),
-        pParallel( parallelChunks )
+        pPipeline( pipeline ), pQueue( pipeline, pipeline->IsOrdered() )
       {
       }
 
@@ -420,7 +713,7 @@ namespace
       //------------------------------------------------------------------------
       virtual ~XRootDSource()
       {
-        CleanUpChunks();
+        pQueue.CleanUp();
         XrdCl::XRootDStatus status = pFile->Close();
         delete pFile;
       }
@@ -483,46 +776,45 @@ namespace
           return XRootDStatus( stError, errUninitialized );
 
         //----------------------------------------------------------------------
-        // Fill the queue
+        // Fill the queue, we read as many chunks in parallel as there are free
+        // buffers but wait for a buffer only if there is nothing to pick up
         //----------------------------------------------------------------------
-        while( pChunks.size() < pParallel && pCurrentOffset < pSize )
+        while( pCurrentOffset < pSize )
         {
+          char *buffer = pPipeline->GetBuffer( pQueue.Empty() );
+          if( !buffer )
+            break;
+
           uint64_t chunkSize = pChunkSize;
           if( pCurrentOffset + chunkSize > (uint64_t)pSize )
             chunkSize = pSize - pCurrentOffset;
 
-          char *buffer = new char[chunkSize];
-          ChunkHandler *ch = new ChunkHandler;
-          ch->chunk.offset = pCurrentOffset;
-          ch->chunk.length = chunkSize;
-          ch->chunk.buffer = buffer;
-          ch->status = pFile->Read( pCurrentOffset, chunkSize, buffer, ch );
-          pChunks.push( ch );
+          ReadQueue::ChunkHandler *ch = pQueue.Add( pCurrentOffset, chunkSize,
+                                                    buffer );
+          XRootDStatus st = pFile->Read( pCurrentOffset, chunkSize, buffer, ch );
           pCurrentOffset += chunkSize;
-          if( !ch->status.IsOK() )
+          if( !st.IsOK() )
           {
-            ch->sem->Post();
+            ch->status = st;
+            pQueue.Done( ch );
             break;
           }
         }
 
         //----------------------------------------------------------------------
-        // Pick up a chunk from the front and wait for status
+        // Pick up the next chunk that has been read
         //----------------------------------------------------------------------
-        if( pChunks.empty() )
+        XRDCL_SMART_PTR_T<ReadQueue::ChunkHandler> ch( pQueue.Next() );
+        if( !ch.get() )
           return XRootDStatus( stOK, suDone );
 
-        XRDCL_SMART_PTR_T<ChunkHandler> ch( pChunks.front() );
-        pChunks.pop();
-        ch->sem->Wait();
-
         if( !ch->status.IsOK() )
         {
           log->Debug( UtilityMsg, "Unable read %d bytes at %ld from %s: %s",
                       ch->chunk.length, ch->chunk.offset,
                       pUrl->GetURL().c_str(), ch->status.ToStr().c_str() );
-          delete [] (char *)ch->chunk.buffer;
-          CleanUpChunks();
+          pPipeline->Release( ch->chunk.buffer );
+          pQueue.CleanUp();
           return ch->status;
         }
 
@@ -530,21 +822,6 @@ namespace
         return XRootDStatus( stOK, suContinue );
       }
 
-      //------------------------------------------------------------------------
-      // Clean up the chunks that are flying
-      //------------------------------------------------------------------------
-      void CleanUpChunks()
-      {
-        while( !pChunks.empty() )
-        {
-          ChunkHandler *ch = pChunks.front();
-          pChunks.pop();
-          ch->sem->Wait();
-          delete [] (char *)ch->chunk.buffer;
-          delete ch;
-        }
-      }
-
       //------------------------------------------------------------------------
       // Get check sum
       //------------------------------------------------------------------------
@@ -572,41 +849,13 @@ namespace
       XRootDSource(const XRootDSource &other);
       XRootDSource &operator = (const XRootDSource &other);
 
-      //------------------------------------------------------------------------
-      // Asynchronous chunk handler
-      //------------------------------------------------------------------------
-      class ChunkHandler: public XrdCl::ResponseHandler
-      {
-        public:
-          ChunkHandler(): sem( new XrdCl::Semaphore(0) ) {}
-          virtual ~ChunkHandler() { delete sem; }
-          virtual void HandleResponse( XrdCl::XRootDStatus *statusval,
-                                       XrdCl::AnyObject    *response )
-          {
-            this->status = *statusval;
-            delete statusval;
-            if( response )
-            {
-              XrdCl::ChunkInfo *resp = 0;
-              response->Get( resp );
-              if( resp )
-                chunk = *resp;
-              delete response;
-            }
-            sem->Post();
-          }
-
-        XrdCl::Semaphore    *sem;
-        XrdCl::ChunkInfo     chunk;
-        XrdCl::XRootDStatus  status;
-      };
       const XrdCl::URL           *pUrl;
       XrdCl::File                *pFile;
       int64_t                     pSize;
       int64_t                     pCurrentOffset;
       uint32_t                    pChunkSize;
-      uint8_t                     pParallel;
-      std::queue<ChunkHandler *>  pChunks;
+      CopyPipeline               *pPipeline;
+      ReadQueue                   pQueue;
   };
 
   //----------------------------------------------------------------------------
@@ -620,10 +869,10 @@ namespace
       //------------------------------------------------------------------------
       XRootDSourceZip( const std::string &filename, const XrdCl::URL *archive,
                     uint32_t          chunkSize,
-                    uint8_t           parallelChunks ):
+                    CopyPipeline     *pipeline ):
         pArchiveUrl( archive ), pFilename( filename ), pZipArchive( new XrdCl::ZipArchiveReader() ), pSize( 0 ),
         pCurrentOffset( 0 ), pChunkSize( chunkSize ),
-        pParallel( parallelChunks )
+        pPipeline( pipeline ), pQueue( pipeline, pipeline->IsOrdered() )
       {
       }
 
@@ -632,7 +881,7 @@ namespace
       //------------------------------------------------------------------------
       virtual ~XRootDSourceZip()
       {
-        CleanUpChunks();
+        pQueue.CleanUp();
         XrdCl::XRootDStatus status = pZipArchive->Close();
         delete pZipArchive;
       }
@@ -687,46 +936,45 @@ namespace
           return XRootDStatus( stError, errUninitialized );
 
         //----------------------------------------------------------------------
-        // Fill the queue
+        // Fill the queue, we read as many chunks in parallel as there are free
+        // buffers but wait for a buffer only if there is nothing to pick up
         //----------------------------------------------------------------------
-        while( pChunks.size() < pParallel && pCurrentOffset < pSize )
+        while( pCurrentOffset < pSize )
         {
+          char *buffer = pPipeline->GetBuffer( pQueue.Empty() );
+          if( !buffer )
+            break;
+
           uint64_t chunkSize = pChunkSize;
           if( pCurrentOffset + chunkSize > (uint64_t)pSize )
             chunkSize = pSize - pCurrentOffset;
 
-          char *buffer = new char[chunkSize];
-          ChunkHandler *ch = new ChunkHandler;
-          ch->chunk.offset = pCurrentOffset;
-          ch->chunk.length = chunkSize;
-          ch->chunk.buffer = buffer;
-          ch->status = pZipArchive->Read( pFilename, pCurrentOffset, chunkSize, buffer, ch );
-          pChunks.push( ch );
+          ReadQueue::ChunkHandler *ch = pQueue.Add( pCurrentOffset, chunkSize,
+                                                    buffer );
+          XRootDStatus st = pZipArchive->Read( pFilename, pCurrentOffset, chunkSize, buffer, ch );
           pCurrentOffset += chunkSize;
-          if( !ch->status.IsOK() )
+          if( !st.IsOK() )
           {
-            ch->sem->Post();
+            ch->status = st;
+            pQueue.Done( ch );
             break;
           }
         }
 
         //----------------------------------------------------------------------
-        // Pick up a chunk from the front and wait for status
+        // Pick up the next chunk that has been read
         //----------------------------------------------------------------------
-        if( pChunks.empty() )
+        XRDCL_SMART_PTR_T<ReadQueue::ChunkHandler> ch( pQueue.Next() );
+        if( !ch.get() )
           return XRootDStatus( stOK, suDone );
 
-        XRDCL_SMART_PTR_T<ChunkHandler> ch( pChunks.front() );
-        pChunks.pop();
-        ch->sem->Wait();
-
         if( !ch->status.IsOK() )
         {
           log->Debug( UtilityMsg, "Unable read %d bytes at %ld from %s: %s",
                       ch->chunk.length, ch->chunk.offset,
                       pArchiveUrl->GetURL().c_str(), ch->status.ToStr().c_str() );
-          delete [] (char *)ch->chunk.buffer;
-          CleanUpChunks();
+          pPipeline->Release( ch->chunk.buffer );
+          pQueue.CleanUp();
           return ch->status;
         }
 
@@ -734,21 +982,6 @@ namespace
         return XRootDStatus( stOK, suContinue );
       }
 
-      //------------------------------------------------------------------------
-      // Clean up the chunks that are flying
-      //------------------------------------------------------------------------
-      void CleanUpChunks()
-      {
-        while( !pChunks.empty() )
-        {
-          ChunkHandler *ch = pChunks.front();
-          pChunks.pop();
-          ch->sem->Wait();
-          delete [] (char *)ch->chunk.buffer;
-          delete ch;
-        }
-      }
-
       //------------------------------------------------------------------------
       // Get check sum
       //------------------------------------------------------------------------
@@ -762,42 +995,14 @@ namespace
       XRootDSourceZip(const XRootDSource &other);
       XRootDSourceZip &operator = (const XRootDSource &other);
 
-      //------------------------------------------------------------------------
-      // Asynchronous chunk handler
-      //------------------------------------------------------------------------
-      class ChunkHandler: public XrdCl::ResponseHandler
-      {
-        public:
-          ChunkHandler(): sem( new XrdCl::Semaphore(0) ) {}
-          virtual ~ChunkHandler() { delete sem; }
-          virtual void HandleResponse( XrdCl::XRootDStatus *statusval,
-                                       XrdCl::AnyObject    *response )
-          {
-            this->status = *statusval;
-            delete statusval;
-            if( response )
-            {
-              XrdCl::ChunkInfo *resp = 0;
-              response->Get( resp );
-              if( resp )
-                chunk = *resp;
-              delete response;
-            }
-            sem->Post();
-          }
-
-        XrdCl::Semaphore    *sem;
-        XrdCl::ChunkInfo     chunk;
-        XrdCl::XRootDStatus  status;
-      };
       const XrdCl::URL           *pArchiveUrl;
       const std::string           pFilename;
       XrdCl::ZipArchiveReader    *pZipArchive;
       uint32_t                    pSize;
       int64_t                     pCurrentOffset;
       uint32_t                    pChunkSize;
-      uint8_t                     pParallel;
-      std::queue<ChunkHandler *>  pChunks;
+      CopyPipeline               *pPipeline;
+      ReadQueue                   pQueue;
   };
 
   //----------------------------------------------------------------------------
@@ -810,9 +1015,11 @@ namespace
       //! Constructor
       //------------------------------------------------------------------------
       XRootDSourceDynamic( const XrdCl::URL *url,
-                           uint32_t          chunkSize ):
+                           uint32_t          chunkSize,
+                           CopyPipeline     *pipeline ):
         pUrl( url ), pFile( new XrdCl::File() ), pCurrentOffset( 0 ),
-        pChunkSize( chunkSize ), pDone( false )
+        pChunkSize( chunkSize ), pDone( false ),
+        pPipeline( pipeline ), pQueue( pipeline, true )
       {
       }
 
@@ -821,6 +1028,7 @@ namespace
       //------------------------------------------------------------------------
       virtual ~XRootDSourceDynamic()
       {
+        pQueue.CleanUp();
         XrdCl::XRootDStatus status = pFile->Close();
         delete pFile;
       }
@@ -877,35 +1085,52 @@ namespace
           return XRootDStatus( stOK, suDone );
 
         //----------------------------------------------------------------------
-        // Fill the queue
+        // Fill the queue. We don't know where the file ends so we read ahead
+        // as far as the free buffers allow and stop at the first short chunk.
         //----------------------------------------------------------------------
-        char     *buffer = new char[pChunkSize];
-        uint32_t  bytesRead = 0;
-
-        XRootDStatus st = pFile->Read( pCurrentOffset, pChunkSize, buffer,
-                                       bytesRead );
-
-        if( !st.IsOK() )
+        while( 1 )
         {
-          delete [] buffer;
-          return st;
+          char *buffer = pPipeline->GetBuffer( pQueue.Empty() );
+          if( !buffer )
+            break;
+
+          ReadQueue::ChunkHandler *ch = pQueue.Add( pCurrentOffset, pChunkSize,
+                                                    buffer );
+          XRootDStatus st = pFile->Read( pCurrentOffset, pChunkSize, buffer,
+                                         ch );
+          pCurrentOffset += pChunkSize;
+          if( !st.IsOK() )
+          {
+            ch->status = st;
+            pQueue.Done( ch );
+            break;
+          }
         }
 
-        if( !bytesRead )
+        //----------------------------------------------------------------------
+        // Pick up the next chunk in order
+        //----------------------------------------------------------------------
+        XRDCL_SMART_PTR_T<ReadQueue::ChunkHandler> ch( pQueue.Next() );
+        if( !ch->status.IsOK() )
         {
-          delete [] buffer;
-          return XRootDStatus( stOK, suDone );
+          pPipeline->Release( ch->chunk.buffer );
+          pQueue.CleanUp();
+          return ch->status;
         }
 
-        if( bytesRead < pChunkSize )
+        if( ch->chunk.length < pChunkSize )
+        {
           pDone = true;
+          pQueue.CleanUp();
+        }
 
-        ci.offset = pCurrentOffset;
-        ci.length = bytesRead;
-        ci.buffer = buffer;
-
-        pCurrentOffset += bytesRead;
+        if( !ch->chunk.length )
+        {
+          pPipeline->Release( ch->chunk.buffer );
+          return XRootDStatus( stOK, suDone );
+        }
 
+        ci = ch->chunk;
         return XRootDStatus( stOK, suContinue );
       }
 
@@ -937,6 +1162,8 @@ namespace
       int64_t                     pCurrentOffset;
       uint32_t                    pChunkSize;
       bool                        pDone;
+      CopyPipeline               *pPipeline;
+      ReadQueue                   pQueue;
   };
 
   //----------------------------------------------------------------------------
@@ -1081,8 +1308,10 @@ namespace
       //------------------------------------------------------------------------
       //! Constructor
       //------------------------------------------------------------------------
-      StdOutDestination( const std::string &ckSumType ):
-        pCkSumHelper( "stdout", ckSumType ), pCurrentOffset(0)
+      StdOutDestination( const std::string &ckSumType,
+                         CopyPipeline      *pipeline ):
+        pCkSumHelper( "stdout", ckSumType ), pCurrentOffset(0),
+        pPipeline( pipeline )
       {
       }
 
@@ -1137,7 +1366,7 @@ namespace
           {
             log->Debug( UtilityMsg, "Unable to write to stdout: %s",
                         strerror( errno ) );
-            delete [] (char*)ci.buffer; ci.buffer = 0;
+            pPipeline->Release( ci.buffer ); ci.buffer = 0;
             return XRootDStatus( stError, errOSError, errno );
           }
           pCurrentOffset += wr;
@@ -1147,7 +1376,8 @@ namespace
         while( length );
 
         pCkSumHelper.Update( ci.buffer, ci.length );
-        delete [] (char*)ci.buffer; ci.buffer = 0;
+        pPipeline->WriteDone( ci.length );
+        pPipeline->Release( ci.buffer ); ci.buffer = 0;
         return XRootDStatus();
       }
 
@@ -1173,6 +1403,7 @@ namespace
       StdOutDestination &operator = (const StdOutDestination &other);
       CheckSumHelper pCkSumHelper;
       uint64_t       pCurrentOffset;
+      CopyPipeline  *pPipeline;
   };
 
   //----------------------------------------------------------------------------
@@ -1184,8 +1415,8 @@ namespace
       //------------------------------------------------------------------------
       //! Constructor
       //------------------------------------------------------------------------
-      XRootDDestination( const XrdCl::URL *url, uint8_t parallelChunks ):
-        pUrl( url ), pFile( new XrdCl::File( XrdCl::File::DisableVirtRedirect ) ), pParallel( parallelChunks )
+      XRootDDestination( const XrdCl::URL *url, CopyPipeline *pipeline ):
+        pUrl( url ), pFile( new XrdCl::File( XrdCl::File::DisableVirtRedirect ) ), pPipeline( pipeline )
       {
       }
 
@@ -1253,27 +1484,31 @@ namespace
           return XRootDStatus( stError, errUninitialized );
 
         //----------------------------------------------------------------------
-        // If there is still place for this chunk to be sent send it
-        //----------------------------------------------------------------------
-        if( pChunks.size() < pParallel )
-          return QueueChunk( ci );
-
-        //----------------------------------------------------------------------
-        // We wait for a chunk to be sent so that we have space for the current
-        // one
+        // Reap the writes that are done. The buffers have already been given
+        // back by the handlers, so we only need to check the status. If there
+        // is no place for this chunk, we wait for the oldest write to finish.
         //----------------------------------------------------------------------
-        XRDCL_SMART_PTR_T<ChunkHandler> ch( pChunks.front() );
-        pChunks.pop();
-        ch->sem->Wait();
-        delete [] (char*)ch->chunk.buffer;
-        if( !ch->status.IsOK() )
+        while( !pChunks.empty() )
         {
-          Log *log = DefaultEnv::GetLog();
-          log->Debug( UtilityMsg, "Unable write %d bytes at %ld from %s: %s",
-                      ch->chunk.length, ch->chunk.offset,
-                      pUrl->GetURL().c_str(), ch->status.ToStr().c_str() );
-          CleanUpChunks();
-          return ch->status;
+          if( pChunks.size() < pPipeline->GetMaxBuffers() &&
+              !pChunks.front()->sem->CondWait() )
+            break;
+
+          if( pChunks.size() >= pPipeline->GetMaxBuffers() )
+            pChunks.front()->sem->Wait();
+
+          XRDCL_SMART_PTR_T<ChunkHandler> ch( pChunks.front() );
+          pChunks.pop();
+          if( !ch->status.IsOK() )
+          {
+            Log *log = DefaultEnv::GetLog();
+            log->Debug( UtilityMsg, "Unable write %d bytes at %ld from %s: %s",
+                        ch->chunk.length, ch->chunk.offset,
+                        pUrl->GetURL().c_str(), ch->status.ToStr().c_str() );
+            CleanUpChunks();
+            pPipeline->Release( ci.buffer ); ci.buffer = 0;
+            return ch->status;
+          }
         }
         return QueueChunk( ci );
       }
@@ -1288,7 +1523,6 @@ namespace
           ChunkHandler *ch = pChunks.front();
           pChunks.pop();
           ch->sem->Wait();
-          delete [] (char *)ch->chunk.buffer;
           delete ch;
         }
       }
@@ -1298,13 +1532,13 @@ namespace
       //------------------------------------------------------------------------
       XrdCl::XRootDStatus QueueChunk( XrdCl::ChunkInfo &ci )
       {
-        ChunkHandler *ch = new ChunkHandler(ci);
+        ChunkHandler *ch = new ChunkHandler( ci, pPipeline );
         XrdCl::XRootDStatus st;
         st = pFile->Write( ci.offset, ci.length, ci.buffer, ch );
         if( !st.IsOK() )
         {
           CleanUpChunks();
-          delete [] (char*)ci.buffer;
+          pPipeline->Release( ci.buffer );
           ci.buffer = 0;
           delete ch;
           return st;
@@ -1326,7 +1560,6 @@ namespace
           ch->sem->Wait();
           if( !ch->status.IsOK() )
             st = ch->status;
-          delete [] (char *)ch->chunk.buffer;
           delete ch;
         }
         return st;
@@ -1351,31 +1584,37 @@ namespace
       XRootDDestination &operator = (const XRootDDestination &other);
 
       //------------------------------------------------------------------------
-      // Asynchronous chunk handler
+      // Asynchronous chunk handler, gives back the buffer as soon as the
+      // chunk has been written
       //------------------------------------------------------------------------
       class ChunkHandler: public XrdCl::ResponseHandler
       {
         public:
-          ChunkHandler( XrdCl::ChunkInfo ci ):
+          ChunkHandler( XrdCl::ChunkInfo ci, CopyPipeline *pipeline ):
             sem( new XrdCl::Semaphore(0) ),
-            chunk(ci) {}
+            chunk(ci), pipe( pipeline ) {}
           virtual ~ChunkHandler() { delete sem; }
           virtual void HandleResponse( XrdCl::XRootDStatus *statusval,
                                        XrdCl::AnyObject    */*response*/ )
           {
             this->status = *statusval;
             delete statusval;
+            if( status.IsOK() )
+              pipe->WriteDone( chunk.length );
+            pipe->Release( chunk.buffer );
+            chunk.buffer = 0;
             sem->Post();
           }
 
           XrdCl::Semaphore       *sem;
           XrdCl::ChunkInfo        chunk;
           XrdCl::XRootDStatus     status;
+          CopyPipeline           *pipe;
       };
 
       const XrdCl::URL           *pUrl;
       XrdCl::File                *pFile;
-      uint8_t                     pParallel;
+      CopyPipeline               *pPipeline;
       std::queue<ChunkHandler *>  pChunks;
   };
 }
@@ -1409,6 +1648,7 @@ namespace XrdCl
     uint16_t    parallelChunks;
     uint32_t    chunkSize;
     uint64_t    blockSize;
+    uint64_t    pipelineMemory;
     bool        posc, force, coerce, makeDir, dynamicSource, zip, xcp;
     int32_t     nbXcpSources;
 
@@ -1425,6 +1665,7 @@ namespace XrdCl
     pProperties->Get( "zipArchive",      zip );
     pProperties->Get( "xcp",             xcp );
     pProperties->Get( "xcpBlockSize",    blockSize );
+    pProperties->Get( "pipelineMemory",  pipelineMemory );
 
     if( zip )
       pProperties->Get( "zipSource",     zipSource );
@@ -1432,6 +1673,26 @@ namespace XrdCl
     if( xcp )
       pProperties->Get( "nbXcpSources",     nbXcpSources );
 
+    //--------------------------------------------------------------------------
+    // Set up the buffer pool shared by the source and the destination, the
+    // number of chunks in flight is bounded by the memory budget but is never
+    // lower than the number of parallel chunks. Only stdout needs the chunks
+    // in order, everything else may be written as soon as it has been read.
+    //--------------------------------------------------------------------------
+    uint32_t nbBuffers = chunkSize ? pipelineMemory / chunkSize : 0;
+    if( nbBuffers < parallelChunks ) nbBuffers = parallelChunks;
+    if( nbBuffers < 1 ) nbBuffers = 1;
+    bool ordered = GetTarget().GetProtocol() == "stdio";
+    CopyPipeline pipeline( chunkSize, nbBuffers, ordered );
+    log->Debug( UtilityMsg, "Copy pipeline: %d buffers of %d bytes, %s writes",
+                nbBuffers, chunkSize, ordered ? "ordered" : "unordered" );
+
+    //--------------------------------------------------------------------------
+    // The pipeline state is only reported to handlers that ask for it
+    //--------------------------------------------------------------------------
+    CopyPipelineHandler *pipeProgress =
+      dynamic_cast<CopyPipelineHandler*>( progress );
+
     //--------------------------------------------------------------------------
     // Initialize the source and the destination
     //--------------------------------------------------------------------------
@@ -1439,15 +1700,15 @@ namespace XrdCl
     if( xcp )
       src.reset( new XRootDSourceXCp( &GetSource(), chunkSize, parallelChunks, nbXcpSources, blockSize ) );
     else if( zip ) // TODO make zip work for xcp
-      src.reset( new XRootDSourceZip( zipSource, &GetSource(), chunkSize, parallelChunks ) );
+      src.reset( new XRootDSourceZip( zipSource, &GetSource(), chunkSize, &pipeline ) );
     else if( GetSource().GetProtocol() == "stdio" )
-      src.reset( new StdInSource( checkSumType, chunkSize ) );
+      src.reset( new StdInSource( checkSumType, chunkSize, &pipeline ) );
     else
     {
       if( dynamicSource )
-        src.reset( new XRootDSourceDynamic( &GetSource(), chunkSize ) );
+        src.reset( new XRootDSourceDynamic( &GetSource(), chunkSize, &pipeline ) );
       else
-        src.reset( new XRootDSource( &GetSource(), chunkSize, parallelChunks ) );
+        src.reset( new XRootDSource( &GetSource(), chunkSize, &pipeline ) );
     }
 
     XRootDStatus st = src->Initialize();
@@ -1458,7 +1719,7 @@ namespace XrdCl
     URL newDestUrl( GetTarget() );
 
     if( GetTarget().GetProtocol() == "stdio" )
-      dest.reset( new StdOutDestination( checkSumType ) );
+      dest.reset( new StdOutDestination( checkSumType, &pipeline ) );
     //--------------------------------------------------------------------------
     // For xrootd destination build the oss.asize hint
     //--------------------------------------------------------------------------
@@ -1472,7 +1733,7 @@ namespace XrdCl
         newDestUrl.SetParams( params );
  //     makeDir = true; // Backward compatability for xroot destinations!!!
       }
-      dest.reset( new XRootDDestination( &newDestUrl, parallelChunks ) );
+      dest.reset( new XRootDDestination( &newDestUrl, &pipeline ) );
     }
 
     dest->SetForce( force );
@@ -1496,19 +1757,36 @@ namespace XrdCl
       if( st.IsOK() && st.code == suDone )
         break;
 
+      pipeline.ReadDone( chunkInfo.length );
       st = dest->PutChunk( chunkInfo );
 
       if( !st.IsOK() )
         return st;
 
       processed += chunkInfo.length;
-      if( progress ) progress->JobProgress( pJobId, processed, size );
+      if( progress )
+      {
+        progress->JobProgress( pJobId, processed, size );
+        if( pipeProgress )
+        {
+          CopyPipelineInfo info;
+          pipeline.GetInfo( info );
+          pipeProgress->PipelineProgress( pJobId, info );
+        }
+      }
     }
 
     st = dest->Flush();
     if( !st.IsOK() )
       return st;
 
+    if( pipeProgress )
+    {
+      CopyPipelineInfo info;
+      pipeline.GetInfo( info );
+      pipeProgress->PipelineProgress( pJobId, info );
+    }
+
     //--------------------------------------------------------------------------
     // The size of the source is known and not enough data has been transfered
     // to the destination
@@ -54,6 +54,7 @@ namespace XrdCl
   const int DefaultWorkerThreads        = 3;
   const int DefaultCPChunkSize          = 16777216;
   const int DefaultCPParallelChunks     = 4;
+  const int DefaultCPPipelineMemory     = 134217728; // DefaultCPChunkSize * DefaultCPParallelChunks * 2
   const int DefaultDataServerTTL        = 300;
   const int DefaultLoadBalancerTTL      = 1200;
   const int DefaultCPInitTimeout        = 600;
@@ -69,6 +70,7 @@ namespace XrdCl
   const int DefaultXCpBlockSize         = 134217728; // DefaultCPChunkSize * DefaultCPParallelChunks * 2
   const int DefaultNoDelay              = 1;
   const int DefaultAioSignal            = 1;
+  const int DefaultLocalIoUring         = 256;
   const int DefaultPreferIPv4           = 0;
 
   const char * const DefaultPollerPreference   = "built-in";
@@ -212,6 +212,13 @@ namespace XrdCl
       p.Set( "chunkSize", val );
     }
 
+    if( !p.HasProperty( "pipelineMemory" ) )
+    {
+      int val = DefaultCPPipelineMemory;
+      env->GetInt( "CPPipelineMemory", val );
+      p.Set( "pipelineMemory", val );
+    }
+
     if( !p.HasProperty( "xcpBlockSize" ) )
     {
       int val = DefaultXCpBlockSize;
@@ -35,6 +35,23 @@ namespace XrdCl
 {
   class CopyJob;
 
+  //----------------------------------------------------------------------------
+  //! State of the data pipeline of a copy job, the throughput of each stage
+  //! is the number of bytes it processed divided by the elapsed time
+  //----------------------------------------------------------------------------
+  struct CopyPipelineInfo
+  {
+    CopyPipelineInfo(): bytesRead( 0 ), bytesWritten( 0 ), elapsed( 0 ),
+      buffersInUse( 0 ), buffersMax( 0 ), bufferStalls( 0 ) {}
+
+    uint64_t bytesRead;     //!< bytes delivered by the source
+    uint64_t bytesWritten;  //!< bytes acknowledged by the destination
+    uint64_t elapsed;       //!< microseconds since the copy started
+    uint32_t buffersInUse;  //!< chunk buffers being read or written
+    uint32_t buffersMax;    //!< maximum number of chunk buffers
+    uint64_t bufferStalls;  //!< times the source waited for a free buffer
+  };
+
   //----------------------------------------------------------------------------
   //! Interface for copy progress notification
   //----------------------------------------------------------------------------
@@ -96,6 +113,26 @@ namespace XrdCl
       }
   };
 
+  //----------------------------------------------------------------------------
+  //! Optional interface for pipeline state notification. A progress handler
+  //! that also derives from this class is told about the state of the data
+  //! pipeline of the jobs that have one, along with JobProgress.
+  //----------------------------------------------------------------------------
+  class CopyPipelineHandler
+  {
+    public:
+      virtual ~CopyPipelineHandler() {}
+
+      //------------------------------------------------------------------------
+      //! Notify about the state of the data pipeline of the current job
+      //!
+      //! @param jobNum         job number
+      //! @param info           state of the pipeline
+      //------------------------------------------------------------------------
+      virtual void PipelineProgress( uint16_t                jobNum,
+                                     const CopyPipelineInfo &info ) = 0;
+  };
+
   //----------------------------------------------------------------------------
   //! Copy the data from one point to another
   //----------------------------------------------------------------------------
@@ -139,6 +176,9 @@ namespace XrdCl
       //! chunkSize      [uint32_t] - size of a copy chunks in bytes
       //! parallelChunks [uint8_t]  - number of chunks that should be requested
       //!                             in parallel
+      //! pipelineMemory [uint64_t] - memory for chunk buffers; as many chunks
+      //!                             are read and written in parallel as fit,
+      //!                             but never less than parallelChunks
       //! initTimeout    [uint16_t] - time limit for successfull initialization
       //!                             of the copy job
       //! tpcTimeout     [uint16_t] - time limit for the actual copy to finish
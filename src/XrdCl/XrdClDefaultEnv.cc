@@ -274,6 +274,7 @@ namespace XrdCl
     REGISTER_VAR_INT( varsInt, "WorkerThreads",        DefaultWorkerThreads        );
     REGISTER_VAR_INT( varsInt, "CPChunkSize",          DefaultCPChunkSize          );
     REGISTER_VAR_INT( varsInt, "CPParallelChunks",     DefaultCPParallelChunks     );
+    REGISTER_VAR_INT( varsInt, "CPPipelineMemory",     DefaultCPPipelineMemory     );
     REGISTER_VAR_INT( varsInt, "DataServerTTL",        DefaultDataServerTTL        );
     REGISTER_VAR_INT( varsInt, "LoadBalancerTTL",      DefaultLoadBalancerTTL      );
     REGISTER_VAR_INT( varsInt, "CPInitTimeout",        DefaultCPInitTimeout        );
@@ -289,6 +290,7 @@ namespace XrdCl
     REGISTER_VAR_INT( varsInt, "XCpBlockSize",         DefaultXCpBlockSize         );
     REGISTER_VAR_INT( varsInt, "NoDelay",              DefaultNoDelay              );
     REGISTER_VAR_INT( varsInt, "AioSignal",            DefaultAioSignal            );
+    REGISTER_VAR_INT( varsInt, "LocalIoUring",         DefaultLocalIoUring         );
     REGISTER_VAR_INT( varsInt, "PreferIPv4",           DefaultPreferIPv4           );
 
     REGISTER_VAR_STR( varsStr, "PollerPreference",     DefaultPollerPreference     );
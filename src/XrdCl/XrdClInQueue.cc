@@ -25,6 +25,45 @@
 
 namespace XrdCl
 {
+  //----------------------------------------------------------------------------
+  // Constructor
+  //----------------------------------------------------------------------------
+  InQueue::InQueue()
+  {
+    for( int i = 0; i < pPageCount; ++i )
+      pPages[i].store( 0, std::memory_order_relaxed );
+  }
+
+  //----------------------------------------------------------------------------
+  // Destructor
+  //----------------------------------------------------------------------------
+  InQueue::~InQueue()
+  {
+    for( int i = 0; i < pPageCount; ++i )
+      delete [] pPages[i].load( std::memory_order_relaxed );
+  }
+
+  //----------------------------------------------------------------------------
+  // Get the slot of the given sid, allocate its page if needed
+  //----------------------------------------------------------------------------
+  InQueue::Slot &InQueue::GetSlot( uint16_t sid )
+  {
+    std::atomic<Slot*> &pagePtr = pPages[sid >> pSlotBits];
+    Slot *page = pagePtr.load( std::memory_order_acquire );
+
+    if( !page )
+    {
+      Slot *newPage = new Slot[pSlotCount];
+      if( pagePtr.compare_exchange_strong( page, newPage,
+                                           std::memory_order_acq_rel ) )
+        page = newPage;
+      else
+        delete [] newPage;
+    }
+
+    return page[sid & (pSlotCount - 1)];
+  }
+
   //----------------------------------------------------------------------------
   // Filter messages
   //----------------------------------------------------------------------------
@@ -73,23 +112,24 @@ namespace XrdCl
       return true;
     }
 
-    // Lookup the sid in the map of handlers
-    pMutex.Lock();
-    HandlerMap::iterator it = pHandlers.find(msgSid);
+    // Lookup the handler in the slot of the sid
+    Slot           &slot  = GetSlot( msgSid );
+    XrdSysRecMutex &mutex = SlotMutex( msgSid );
+    mutex.Lock();
+    handler = slot.handler.load( std::memory_order_relaxed );
 
-    if (it != pHandlers.end())
+    if( handler )
     {
-      handler = it->second.first;
-      action  = handler->Examine( msg );
+      action = handler->Examine( msg );
 
       if( action & IncomingMsgHandler::RemoveHandler )
-        pHandlers.erase( it );
+        slot.handler.store( 0, std::memory_order_relaxed );
     }
 
     if( !(action & IncomingMsgHandler::Take) )
-      pMessages[msgSid] = msg;
+      slot.message = msg;
 
-    pMutex.UnLock();
+    mutex.UnLock();
 
     if( handler && !(action & IncomingMsgHandler::NoProcess) )
       handler->Process( msg );
@@ -102,26 +142,49 @@ namespace XrdCl
   //----------------------------------------------------------------------------
   void InQueue::AddMessageHandler( IncomingMsgHandler *handler, time_t expires )
   {
-    uint16_t action = 0;
     uint16_t handlerSid = handler->GetSid();
-    XrdSysMutexHelper scopedLock( pMutex );
-    MessageMap::iterator it = pMessages.find(handlerSid);
+    Slot    &slot       = GetSlot( handlerSid );
 
-    if (it != pMessages.end())
+    //--------------------------------------------------------------------------
+    // Usually the response has not arrived yet, so we just install the
+    // handler
+    //--------------------------------------------------------------------------
     {
-      action = handler->Examine( it->second );
+      XrdSysMutexHelper scopedLock( SlotMutex( handlerSid ) );
+      if( !slot.message )
+      {
+        slot.handler.store( handler, std::memory_order_relaxed );
+        slot.expires = expires;
+        return;
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    // Otherwise the handler may process the cached message, which needs to
+    // happen in the right lock order
+    //--------------------------------------------------------------------------
+    uint16_t action = 0;
+    XrdSysMutexHelper eventLock( pEventMutex );
+    XrdSysMutexHelper scopedLock( SlotMutex( handlerSid ) );
+
+    if( slot.message )
+    {
+      action = handler->Examine( slot.message );
 
       if( action & IncomingMsgHandler::Take )
       {
         if( !(action & IncomingMsgHandler::NoProcess ) )
-          handler->Process( it->second );
+          handler->Process( slot.message );
 
-        pMessages.erase( it );
+        slot.message = 0;
       }
     }
 
     if( !(action & IncomingMsgHandler::RemoveHandler) )
-      pHandlers[handlerSid] = HandlerAndExpire( handler, expires );
+    {
+      slot.handler.store( handler, std::memory_order_relaxed );
+      slot.expires = expires;
+    }
   }
 
   //----------------------------------------------------------------------------
@@ -142,21 +205,21 @@ namespace XrdCl
       return handler;
     }
 
-    XrdSysMutexHelper scopedLock( pMutex );
-    HandlerMap::iterator it = pHandlers.find(msgSid);
+    Slot *slot = FindSlot( msgSid );
+    if( !slot )
+      return handler;
+
+    XrdSysMutexHelper scopedLock( SlotMutex( msgSid ) );
+    handler = slot->handler.load( std::memory_order_relaxed );
 
-    if (it != pHandlers.end())
+    if( handler )
     {
-      handler = it->second.first;
       act     = handler->Examine( msg );
-      exp     = it->second.second;
+      exp     = slot->expires;
 
       if( act & IncomingMsgHandler::Take )
-        pHandlers.erase( it );
-    }
+        slot->handler.store( 0, std::memory_order_relaxed );
 
-    if( handler )
-    {
       expires = exp;
       action  = act;
     }
@@ -171,8 +234,10 @@ namespace XrdCl
 				     time_t              expires )
   {
     uint16_t handlerSid = handler->GetSid();
-    XrdSysMutexHelper scopedLock( pMutex );
-    pHandlers[handlerSid] = HandlerAndExpire( handler, expires );
+    Slot    &slot       = GetSlot( handlerSid );
+    XrdSysMutexHelper scopedLock( SlotMutex( handlerSid ) );
+    slot.handler.store( handler, std::memory_order_relaxed );
+    slot.expires = expires;
   }
 
   //----------------------------------------------------------------------------
@@ -181,8 +246,12 @@ namespace XrdCl
   void InQueue::RemoveMessageHandler( IncomingMsgHandler *handler )
   {
     uint16_t handlerSid = handler->GetSid();
-    XrdSysMutexHelper scopedLock( pMutex );
-    pHandlers.erase(handlerSid);
+    Slot    *slot       = FindSlot( handlerSid );
+    if( !slot )
+      return;
+
+    XrdSysMutexHelper scopedLock( SlotMutex( handlerSid ) );
+    slot->handler.store( 0, std::memory_order_relaxed );
   }
 
   //----------------------------------------------------------------------------
@@ -193,15 +262,28 @@ namespace XrdCl
 				   Status                          status )
   {
     uint8_t action = 0;
-    XrdSysMutexHelper scopedLock( pMutex );
-    for( HandlerMap::iterator it = pHandlers.begin(); it != pHandlers.end(); )
+    XrdSysMutexHelper eventLock( pEventMutex );
+    for( int sid = 0; sid < 65536; ++sid )
     {
-      action = it->second.first->OnStreamEvent( event, streamNum, status );
+      Slot *slot = FindSlot( sid );
+      if( !slot )
+      {
+        sid |= pSlotCount - 1;
+        continue;
+      }
+
+      if( !slot->handler.load( std::memory_order_relaxed ) )
+        continue;
+
+      XrdSysMutexHelper scopedLock( SlotMutex( sid ) );
+      IncomingMsgHandler *handler = slot->handler.load( std::memory_order_relaxed );
+      if( !handler )
+        continue;
+
+      action = handler->OnStreamEvent( event, streamNum, status );
 
       if( action & IncomingMsgHandler::RemoveHandler )
-        pHandlers.erase( it++ );
-      else
-        ++it;
+        slot->handler.store( 0, std::memory_order_relaxed );
     }
   }
 
@@ -213,18 +295,27 @@ namespace XrdCl
     if( !now )
       now = ::time(0);
 
-    XrdSysMutexHelper scopedLock( pMutex );
-    HandlerMap::iterator it = pHandlers.begin();
-    while( it != pHandlers.end() )
+    XrdSysMutexHelper eventLock( pEventMutex );
+    for( int sid = 0; sid < 65536; ++sid )
     {
-      if( it->second.second <= now )
+      Slot *slot = FindSlot( sid );
+      if( !slot )
       {
-        it->second.first->OnStreamEvent( IncomingMsgHandler::Timeout, 0,
-                                         Status( stError, errOperationExpired ) );
-        pHandlers.erase( it++ );
+        sid |= pSlotCount - 1;
+        continue;
+      }
+
+      if( !slot->handler.load( std::memory_order_relaxed ) )
+        continue;
+
+      XrdSysMutexHelper scopedLock( SlotMutex( sid ) );
+      IncomingMsgHandler *handler = slot->handler.load( std::memory_order_relaxed );
+      if( handler && slot->expires <= now )
+      {
+        handler->OnStreamEvent( IncomingMsgHandler::Timeout, 0,
+                                Status( stError, errOperationExpired ) );
+        slot->handler.store( 0, std::memory_order_relaxed );
       }
-      else
-        ++it;
     }
   }
 }
@@ -20,8 +20,8 @@
 #define __XRD_CL_IN_QUEUE_HH__
 
 #include <XrdSys/XrdSysPthread.hh>
-#include <map>
-#include <utility>
+#include <atomic>
+#include <ctime>
 #include "XrdCl/XrdClStatus.hh"
 #include "XrdCl/XrdClPostMasterInterfaces.hh"
 
@@ -31,10 +31,30 @@ namespace XrdCl
 
   //----------------------------------------------------------------------------
   //! A synchronize queue for incoming data
+  //!
+  //! Handlers and cached messages live in a table with one slot per stream
+  //! id, so finding them does not involve a search nor a queue-wide lock.
+  //! Slots are allocated in pages of 256 on first use and are serialized by
+  //! one of 256 recursive mutexes chosen by the low byte of the stream id,
+  //! so that requests in flight at the same time use different mutexes.
+  //! Reporting stream events and timeouts, and passing a cached message to
+  //! a new handler, call out to the handlers with the slot mutex held; these
+  //! are rare and are serialized by another mutex taken before any slot
+  //! mutex.
   //----------------------------------------------------------------------------
   class InQueue
   {
     public:
+      //------------------------------------------------------------------------
+      //! Constructor
+      //------------------------------------------------------------------------
+      InQueue();
+
+      //------------------------------------------------------------------------
+      //! Destructor
+      //------------------------------------------------------------------------
+      ~InQueue();
+
       //------------------------------------------------------------------------
       //! Add a fully reconstructed message to the queue
       //------------------------------------------------------------------------
@@ -98,12 +118,57 @@ namespace XrdCl
       //------------------------------------------------------------------------
       bool DiscardMessage(Message* msg, uint16_t& sid) const;
 
-      typedef std::pair<IncomingMsgHandler *, time_t> HandlerAndExpire;
-      typedef std::map<uint16_t, HandlerAndExpire> HandlerMap;
-      typedef std::map<uint16_t, Message*> MessageMap;
-      MessageMap pMessages;
-      HandlerMap pHandlers;
-      XrdSysRecMutex pMutex;
+      InQueue(const InQueue &other);
+      InQueue &operator = (const InQueue &other);
+
+      static const int pSlotBits  = 8;
+      static const int pSlotCount = 1 << pSlotBits;
+      static const int pPageCount = 65536 / pSlotCount;
+      static const int pLockCount = 256;
+
+      //------------------------------------------------------------------------
+      //! Per stream id state, the handler pointer may be read without the
+      //! lock to skip unused slots
+      //------------------------------------------------------------------------
+      struct Slot
+      {
+        Slot(): handler( 0 ), expires( 0 ), message( 0 ) {}
+        std::atomic<IncomingMsgHandler*> handler;
+        time_t                           expires;
+        Message                         *message;
+      };
+
+      //------------------------------------------------------------------------
+      //! Mutex padded to a cache line
+      //------------------------------------------------------------------------
+      struct SlotLock
+      {
+        XrdSysRecMutex mutex;
+        char           pad[64 - sizeof(XrdSysRecMutex) % 64];
+      };
+
+      //------------------------------------------------------------------------
+      //! Get the slot of the given sid, allocate its page if needed
+      //------------------------------------------------------------------------
+      Slot &GetSlot( uint16_t sid );
+
+      //------------------------------------------------------------------------
+      //! Get the slot of the given sid if its page exists, 0 otherwise
+      //------------------------------------------------------------------------
+      Slot *FindSlot( uint16_t sid ) const
+      {
+        Slot *page = pPages[sid >> pSlotBits].load( std::memory_order_acquire );
+        return page ? page + (sid & (pSlotCount - 1)) : 0;
+      }
+
+      XrdSysRecMutex &SlotMutex( uint16_t sid )
+      {
+        return pLocks[sid % pLockCount].mutex;
+      }
+
+      std::atomic<Slot*>  pPages[pPageCount];
+      SlotLock            pLocks[pLockCount];
+      XrdSysRecMutex      pEventMutex;
   };
 }
 
@@ -26,6 +26,8 @@
 
 #include <string>
 #include <memory>
+#include <atomic>
+#include <vector>
 #include <stdexcept>
 #include <iostream>
 
@@ -37,8 +39,36 @@
 #include <arpa/inet.h>
 #include <aio.h>
 
+#ifdef HAVE_IO_URING
+#include <stdint.h>
+#include "XrdSys/XrdSysIOUring.hh"
+#endif
+
 namespace
 {
+  //----------------------------------------------------------------------------
+  // Hand the result of an asynchronous operation over to the user handler
+  //----------------------------------------------------------------------------
+  void QueueTask( XrdCl::XRootDStatus *status, XrdCl::AnyObject *resp,
+                  XrdCl::HostList *hosts, XrdCl::ResponseHandler *handler )
+  {
+    using namespace XrdCl;
+
+    // if it is simply the sync handler we can release the semaphore
+    // and return there is no need to execute this in the thread-pool
+    SyncResponseHandler *syncHandler =
+        dynamic_cast<SyncResponseHandler*>( handler );
+    if( syncHandler )
+    {
+      syncHandler->HandleResponse( status, resp );
+    }
+    else
+    {
+      JobManager *jmngr = DefaultEnv::GetPostMaster()->GetJobManager();
+      LocalFileTask *task = new LocalFileTask( status, resp, hosts, handler );
+      jmngr->QueueJob( task );
+    }
+  }
 
   class AioCtx
   {
@@ -190,33 +220,327 @@ namespace
         }
       }
 
-      static void QueueTask( XrdCl::XRootDStatus *status, XrdCl::AnyObject *resp,
-                             XrdCl::HostList *hosts, XrdCl::ResponseHandler *handler )
+      std::unique_ptr<aiocb>  cb;
+      Opcode                  opcode;
+      XrdCl::HostList        *hosts;
+      XrdCl::ResponseHandler *handler;
+  };
+
+#ifdef HAVE_IO_URING
+  //----------------------------------------------------------------------------
+  // A local file operation executed through io_uring. Vector operations
+  // consist of several segments, the user handler is called once all of them
+  // are done.
+  //----------------------------------------------------------------------------
+  class UringCtx
+  {
+    public:
+
+      enum Opcode
+      {
+        Read,
+        Write,
+        Sync,
+        VectorRead,
+        VectorWrite
+      };
+
+      struct Segment
+      {
+        UringCtx *ctx;
+        uint64_t  offset;
+        uint32_t  length;
+        uint32_t  done;
+        char     *buffer;
+      };
+
+      UringCtx( Opcode op, int fd, const XrdCl::HostList &hostList,
+                XrdCl::ResponseHandler *handler ) :
+        opcode( op ), fd( fd ), pending( 0 ), error( 0 ), vbuffer( 0 ),
+        hosts( new XrdCl::HostList( hostList ) ), handler( handler )
+      {
+      }
+
+      ~UringCtx()
+      {
+        delete hosts;
+      }
+
+      void AddSegment( uint64_t offset, uint32_t length, const void *buffer )
+      {
+        Segment seg = { this, offset, length, 0,
+                        reinterpret_cast<char*>( const_cast<void*>( buffer ) ) };
+        segments.push_back( seg );
+      }
+
+      bool IsWrite() const
+      {
+        return opcode == Write || opcode == VectorWrite;
+      }
+
+      //------------------------------------------------------------------------
+      // Segments complete on the reaper thread or, if the ring fails, on the
+      // submitting one, so the first error is kept with a compare and swap
+      //------------------------------------------------------------------------
+      void SetError( int errNo )
+      {
+        int none = 0;
+        error.compare_exchange_strong( none, errNo );
+      }
+
+      Opcode                  opcode;
+      int                     fd;
+      std::vector<Segment>    segments;
+      std::atomic<size_t>     pending;
+      std::atomic<int>        error;
+      char                   *vbuffer; // vector read into a single buffer
+      XrdCl::HostList        *hosts;
+      XrdCl::ResponseHandler *handler;
+  };
+
+  //----------------------------------------------------------------------------
+  // Process wide io_uring instance used by all local files. The ring is
+  // driven by XrdSysIOUring, each request carries a segment of an operation
+  // and the completions are handed over to the job manager.
+  //----------------------------------------------------------------------------
+  class UringEngine : public XrdSysIOUring
+  {
+    public:
+
+      //------------------------------------------------------------------------
+      // Get the engine, 0 if io_uring is disabled or not available
+      //------------------------------------------------------------------------
+      static UringEngine *Get()
+      {
+        static UringEngine *engine = Create();
+        return engine;
+      }
+
+      //------------------------------------------------------------------------
+      // Submit all segments of the operation, on failure the caller still
+      // owns the context and should fall back to POSIX I/O
+      //------------------------------------------------------------------------
+      bool Submit( UringCtx *ctx )
+      {
+        size_t n = ctx->segments.size();
+        if( n == 0 ) return false;
+
+        Request              one;
+        std::vector<Request> many;
+        Request             *reqs = &one;
+        if( n > 1 )
+        {
+          many.resize( n );
+          reqs = &many[0];
+        }
+        for( size_t i = 0; i < n; ++i )
+          Prepare( &ctx->segments[i], reqs[i] );
+
+        ctx->pending = n;
+        return XrdSysIOUring::Submit( reqs, n ) == 0;
+      }
+
+    protected:
+
+      //------------------------------------------------------------------------
+      // Account for a completed segment, redo interrupted requests and
+      // resubmit the remainder of short writes
+      //------------------------------------------------------------------------
+      void Done( unsigned long long udata, int res )
+      {
+        UringCtx::Segment *seg = reinterpret_cast<UringCtx::Segment*>( udata );
+        UringCtx *ctx = seg->ctx;
+        if( res == -EAGAIN || res == -EINTR )
+          res = Redo( seg );
+
+        if( res < 0 )
+          ctx->SetError( -res );
+        else if( ctx->opcode != UringCtx::Sync )
+        {
+          seg->done += res;
+          if( ctx->IsWrite() && seg->done < seg->length )
+          {
+            if( res == 0 )
+              ctx->SetError( EIO );
+            else
+            {
+              Request req;
+              Prepare( seg, req );
+              if( XrdSysIOUring::Submit( &req ) == 0 )
+                return;
+              res = Redo( seg );
+              if( res < 0 ) ctx->SetError( -res );
+              else seg->done = seg->length;
+            }
+          }
+        }
+
+        // Only the thread that accounts for the last segment completes
+        if( ctx->pending.fetch_sub( 1 ) == 1 )
+          Complete( ctx );
+      }
+
+      //------------------------------------------------------------------------
+      // Report a problem with the ring
+      //------------------------------------------------------------------------
+      void Error( const char *what, int eNum )
+      {
+        XrdCl::Log *log = XrdCl::DefaultEnv::GetLog();
+        log->Error( XrdCl::FileMsg, "io_uring: unable to %s: %s", what,
+                    strerror( eNum ) );
+      }
+
+    private:
+
+      //------------------------------------------------------------------------
+      // Create the ring, the engine is never deleted once it runs
+      //------------------------------------------------------------------------
+      static UringEngine *Create()
+      {
+        using namespace XrdCl;
+        Log *log   = DefaultEnv::GetLog();
+        int  depth = DefaultLocalIoUring;
+        DefaultEnv::GetEnv()->GetInt( "LocalIoUring", depth );
+        if( depth <= 0 ) return 0;
+
+        UringEngine *engine = new UringEngine();
+        const char  *what;
+        int rc = engine->Start( depth, &what );
+        if( rc )
+        {
+          log->Debug( FileMsg, "io_uring not available, using POSIX aio: "
+                      "unable to %s: %s", what, strerror( rc ) );
+          delete engine;
+          return 0;
+        }
+
+        log->Debug( FileMsg, "Local file I/O uses io_uring, depth=%d", depth );
+        return engine;
+      }
+
+      //------------------------------------------------------------------------
+      // Describe the remainder of a segment as a ring request
+      //------------------------------------------------------------------------
+      static void Prepare( UringCtx::Segment *seg, Request &req )
+      {
+        static const Opc opCode[] = { opRead, opWrite, opFsync, opRead,
+                                      opWrite };
+        UringCtx *ctx = seg->ctx;
+        req.udata  = (unsigned long long)(uintptr_t)seg;
+        req.offset = seg->offset + seg->done;
+        req.buff   = seg->buffer + seg->done;
+        req.blen   = seg->length - seg->done;
+        req.fd     = ctx->fd;
+        req.opc    = opCode[ctx->opcode];
+      }
+
+      //------------------------------------------------------------------------
+      // Do the rest of the segment synchronously
+      //------------------------------------------------------------------------
+      int Redo( UringCtx::Segment *seg )
+      {
+        UringCtx *ctx = seg->ctx;
+        ssize_t   rc;
+
+        if( ctx->opcode == UringCtx::Sync )
+          return fsync( ctx->fd ) ? -errno : 0;
+
+        size_t total = 0;
+        while( seg->done + total < seg->length )
+        {
+          char    *buf = seg->buffer + seg->done + total;
+          size_t   len = seg->length - seg->done - total;
+          off_t    off = seg->offset + seg->done + total;
+          if( ctx->IsWrite() ) rc = pwrite( ctx->fd, buf, len, off );
+          else                 rc = pread( ctx->fd, buf, len, off );
+          if( rc < 0 && errno == EINTR ) continue;
+          if( rc < 0 ) return -errno;
+          if( rc == 0 ) break;
+          total += rc;
+          if( !ctx->IsWrite() ) break;
+        }
+        return total;
+      }
+
+      //------------------------------------------------------------------------
+      // All segments are done, respond to the user
+      //------------------------------------------------------------------------
+      void Complete( UringCtx *ctx )
       {
         using namespace XrdCl;
+        static const char *opName[] = { "Read", "Write", "Sync", "VectorRead",
+                                        "VectorWrite" };
 
-        // if it is simply the sync handler we can release the semaphore
-        // and return there is no need to execute this in the thread-pool
-        SyncResponseHandler *syncHandler =
-            dynamic_cast<SyncResponseHandler*>( handler );
-        if( syncHandler )
+        int errNo = ctx->error;
+        if( errNo )
         {
-          syncHandler->HandleResponse( status, resp );
+          Log *log = DefaultEnv::GetLog();
+          log->Error( FileMsg, "%s: failed %s", opName[ctx->opcode],
+                      strerror( errNo ) );
+          XRootDStatus *error = new XRootDStatus( stError, errErrorResponse,
+                                                  XProtocol::mapError( errNo ),
+                                                  strerror( errNo ) );
+          QueueTask( error, 0, ctx->hosts, ctx->handler );
         }
         else
         {
-          JobManager *jmngr = DefaultEnv::GetPostMaster()->GetJobManager();
-          LocalFileTask *task = new LocalFileTask( status, resp, hosts, handler );
-          jmngr->QueueJob( task );
+          AnyObject *resp = 0;
+          if( ctx->opcode == UringCtx::Read )
+          {
+            UringCtx::Segment &seg = ctx->segments[0];
+            resp = new AnyObject();
+            resp->Set( new ChunkInfo( seg.offset, seg.done, seg.buffer ) );
+          }
+          else if( ctx->opcode == UringCtx::VectorRead )
+          {
+            //------------------------------------------------------------------
+            // The chunks were read in parallel, each at its full size. When
+            // they share the user buffer, pack them the way reading them one
+            // after the other would have done in case some came up short.
+            //------------------------------------------------------------------
+            VectorReadInfo *info = new VectorReadInfo();
+            char *cursor = ctx->vbuffer;
+            uint32_t total = 0;
+            for( size_t i = 0; i < ctx->segments.size(); ++i )
+            {
+              UringCtx::Segment &seg = ctx->segments[i];
+              char *buffer = seg.buffer;
+              if( cursor )
+              {
+                if( cursor != seg.buffer )
+                  memmove( cursor, seg.buffer, seg.done );
+                buffer  = cursor;
+                cursor += seg.done;
+              }
+              info->GetChunks().push_back( ChunkInfo( seg.offset, seg.done,
+                                                      buffer ) );
+              total += seg.done;
+            }
+            info->SetSize( total );
+            resp = new AnyObject();
+            resp->Set( info );
+          }
+          QueueTask( new XRootDStatus(), resp, ctx->hosts, ctx->handler );
         }
+
+        ctx->hosts = 0; // now owned by the task
+        delete ctx;
       }
-      
-      std::unique_ptr<aiocb>  cb;
-      Opcode                  opcode;
-      XrdCl::HostList        *hosts;
-      XrdCl::ResponseHandler *handler;
   };
 
+  //----------------------------------------------------------------------------
+  // Run the operation through io_uring if possible, if not the caller falls
+  // back to POSIX I/O
+  //----------------------------------------------------------------------------
+  bool UringSubmit( UringCtx *ctx )
+  {
+    UringEngine *engine = UringEngine::Get();
+    if( engine && engine->Submit( ctx ) )
+      return true;
+    delete ctx;
+    return false;
+  }
+#endif
 };
 
 namespace XrdCl
@@ -323,6 +647,13 @@ namespace XrdCl
   XRootDStatus LocalFileHandler::Read( uint64_t offset, uint32_t size,
       void* buffer, ResponseHandler* handler, uint16_t timeout )
   {
+#ifdef HAVE_IO_URING
+    UringCtx *uctx = new UringCtx( UringCtx::Read, fd, pHostList, handler );
+    uctx->AddSegment( offset, size, buffer );
+    if( UringSubmit( uctx ) )
+      return XRootDStatus();
+#endif
+
     AioCtx *ctx = new AioCtx( pHostList, handler );
     ctx->SetRead( fd, offset, size, buffer );
 
@@ -345,6 +676,13 @@ namespace XrdCl
   XRootDStatus LocalFileHandler::Write( uint64_t offset, uint32_t size,
       const void* buffer, ResponseHandler* handler, uint16_t timeout )
   {
+#ifdef HAVE_IO_URING
+    UringCtx *uctx = new UringCtx( UringCtx::Write, fd, pHostList, handler );
+    uctx->AddSegment( offset, size, buffer );
+    if( UringSubmit( uctx ) )
+      return XRootDStatus();
+#endif
+
     AioCtx *ctx = new AioCtx( pHostList, handler );
     ctx->SetWrite( fd, offset, size, buffer );
 
@@ -367,6 +705,13 @@ namespace XrdCl
   XRootDStatus LocalFileHandler::Sync( ResponseHandler* handler,
       uint16_t timeout )
   {
+#ifdef HAVE_IO_URING
+    UringCtx *uctx = new UringCtx( UringCtx::Sync, fd, pHostList, handler );
+    uctx->AddSegment( 0, 0, 0 );
+    if( UringSubmit( uctx ) )
+      return XRootDStatus();
+#endif
+
     AioCtx *ctx = new AioCtx( pHostList, handler );
     ctx->SetFsync( fd );
 
@@ -409,9 +754,27 @@ namespace XrdCl
   XRootDStatus LocalFileHandler::VectorRead( const ChunkList& chunks,
       void* buffer, ResponseHandler* handler, uint16_t timeout )
   {
+    bool useBuffer( buffer );
+
+#ifdef HAVE_IO_URING
+    //--------------------------------------------------------------------------
+    // All the chunks are submitted at once and read in parallel
+    //--------------------------------------------------------------------------
+    UringCtx *uctx = new UringCtx( UringCtx::VectorRead, fd, pHostList, handler );
+    char *cursor = reinterpret_cast<char*>( buffer );
+    if( useBuffer ) uctx->vbuffer = cursor;
+    for( auto itr = chunks.begin(); itr != chunks.end(); ++itr )
+    {
+      uctx->AddSegment( itr->offset, itr->length,
+                        useBuffer ? cursor : itr->buffer );
+      if( useBuffer ) cursor += itr->length;
+    }
+    if( UringSubmit( uctx ) )
+      return XRootDStatus();
+#endif
+
     std::unique_ptr<VectorReadInfo> info( new VectorReadInfo() );
     size_t totalSize = 0;
-    bool useBuffer( buffer );
 
     for( auto itr = chunks.begin(); itr != chunks.end(); ++itr )
     {
@@ -448,6 +811,13 @@ namespace XrdCl
   XRootDStatus LocalFileHandler::VectorWrite( const ChunkList &chunks,
       ResponseHandler *handler, uint16_t timeout )
   {
+#ifdef HAVE_IO_URING
+    UringCtx *uctx = new UringCtx( UringCtx::VectorWrite, fd, pHostList, handler );
+    for( auto itr = chunks.begin(); itr != chunks.end(); ++itr )
+      uctx->AddSegment( itr->offset, itr->length, itr->buffer );
+    if( UringSubmit( uctx ) )
+      return XRootDStatus();
+#endif
 
     for( auto itr = chunks.begin(); itr != chunks.end(); ++itr )
     {
@@ -18,35 +18,68 @@
 
 #include "XrdCl/XrdClSIDManager.hh"
 
+#include <cstring>
+
 namespace XrdCl
 {
+  //----------------------------------------------------------------------------
+  // Constructor
+  //----------------------------------------------------------------------------
+  SIDManager::SIDManager()
+  {
+    pFreeHead.value.store( 0, std::memory_order_relaxed );
+    pCeiling.value.store( 1, std::memory_order_relaxed );
+    pTimedOut.store( 0, std::memory_order_relaxed );
+    pAllocated.store( 0, std::memory_order_relaxed );
+    for( uint32_t i = 0; i < 65536; ++i )
+    {
+      pSlots[i].next.store( 0, std::memory_order_relaxed );
+      pSlots[i].state.store( Free, std::memory_order_relaxed );
+    }
+  }
+
   //----------------------------------------------------------------------------
   // Allocate a SID
   //---------------------------------------------------------------------------
   Status SIDManager::AllocateSID( uint8_t sid[2] )
   {
-    XrdSysMutexHelper scopedLock( pMutex );
-
-    uint16_t allocSID = 1;
+    uint16_t allocSID = 0;
 
     //--------------------------------------------------------------------------
-    // Get a SID from the list of free SIDs if it's not empty
+    // Get a SID from the stack of free SIDs if it's not empty
     //--------------------------------------------------------------------------
-    if( !pFreeSIDs.empty() )
+    uint64_t head = pFreeHead.value.load( std::memory_order_acquire );
+    while( head & 0xffff )
     {
-      allocSID = pFreeSIDs.front();
-      pFreeSIDs.pop_front();
+      uint16_t top     = head & 0xffff;
+      uint64_t newHead = ((head >> 16) + 1) << 16 |
+                         pSlots[top].next.load( std::memory_order_relaxed );
+      if( pFreeHead.value.compare_exchange_weak( head, newHead,
+                                                 std::memory_order_acquire ) )
+      {
+        allocSID = top;
+        break;
+      }
     }
+
     //--------------------------------------------------------------------------
     // Allocate a new SID if possible
     //--------------------------------------------------------------------------
-    else
+    if( !allocSID )
     {
-      if( pSIDCeiling == 0xffff )
-        return Status( stError, errNoMoreFreeSIDs );
-      allocSID = pSIDCeiling++;
+      uint64_t ceiling = pCeiling.value.load( std::memory_order_relaxed );
+      do
+      {
+        if( ceiling == 0xffff )
+          return Status( stError, errNoMoreFreeSIDs );
+      }
+      while( !pCeiling.value.compare_exchange_weak( ceiling, ceiling + 1,
+                                                    std::memory_order_relaxed ) );
+      allocSID = ceiling;
     }
 
+    pSlots[allocSID].state.store( InUse, std::memory_order_relaxed );
+    ++pAllocated;
     memcpy( sid, &allocSID, 2 );
     return Status();
   }
@@ -56,10 +89,14 @@ namespace XrdCl
   //----------------------------------------------------------------------------
   void SIDManager::ReleaseSID( uint8_t sid[2] )
   {
-    XrdSysMutexHelper scopedLock( pMutex );
     uint16_t relSID = 0;
     memcpy( &relSID, sid, 2 );
-    pFreeSIDs.push_back( relSID );
+    uint8_t state = InUse;
+    if( relSID && pSlots[relSID].state.compare_exchange_strong( state, Free ) )
+    {
+      --pAllocated;
+      PushFree( relSID );
+    }
   }
 
   //----------------------------------------------------------------------------
@@ -67,10 +104,14 @@ namespace XrdCl
   //----------------------------------------------------------------------------
   void SIDManager::TimeOutSID( uint8_t sid[2] )
   {
-    XrdSysMutexHelper scopedLock( pMutex );
     uint16_t tiSID = 0;
     memcpy( &tiSID, sid, 2 );
-    pTimeOutSIDs.insert( tiSID );
+    uint8_t state = InUse;
+    if( pSlots[tiSID].state.compare_exchange_strong( state, TimedOut ) )
+    {
+      --pAllocated;
+      ++pTimedOut;
+    }
   }
 
   //----------------------------------------------------------------------------
@@ -78,13 +119,9 @@ namespace XrdCl
   //----------------------------------------------------------------------------
   bool SIDManager::IsTimedOut( uint8_t sid[2] )
   {
-    XrdSysMutexHelper scopedLock( pMutex );
     uint16_t tiSID = 0;
     memcpy( &tiSID, sid, 2 );
-    std::set<uint16_t>::iterator it = pTimeOutSIDs.find( tiSID );
-    if( it != pTimeOutSIDs.end() )
-      return true;
-    return false;
+    return pSlots[tiSID].state.load( std::memory_order_relaxed ) == TimedOut;
   }
 
   //----------------------------------------------------------------------------
@@ -92,11 +129,14 @@ namespace XrdCl
   //-----------------------------------------------------------------------------
   void SIDManager::ReleaseTimedOut( uint8_t sid[2] )
   {
-    XrdSysMutexHelper scopedLock( pMutex );
     uint16_t tiSID = 0;
     memcpy( &tiSID, sid, 2 );
-    pTimeOutSIDs.erase( tiSID );
-    pFreeSIDs.push_back( tiSID );
+    uint8_t state = TimedOut;
+    if( pSlots[tiSID].state.compare_exchange_strong( state, Free ) )
+    {
+      --pTimedOut;
+      PushFree( tiSID );
+    }
   }
 
   //------------------------------------------------------------------------
@@ -104,19 +144,32 @@ namespace XrdCl
   //------------------------------------------------------------------------
   void SIDManager::ReleaseAllTimedOut()
   {
-    XrdSysMutexHelper scopedLock( pMutex );
-    std::set<uint16_t>::iterator it;
-    for( it = pTimeOutSIDs.begin(); it != pTimeOutSIDs.end(); ++it )
-      pFreeSIDs.push_back( *it );
-    pTimeOutSIDs.clear();
+    uint64_t ceiling = pCeiling.value.load( std::memory_order_relaxed );
+    for( uint64_t i = 1; i < ceiling; ++i )
+    {
+      uint8_t state = TimedOut;
+      if( pSlots[i].state.compare_exchange_strong( state, Free ) )
+      {
+        --pTimedOut;
+        PushFree( i );
+      }
+    }
   }
 
   //----------------------------------------------------------------------------
-  // Get number of allocated SIDs
+  // Put a SID on the free stack
   //----------------------------------------------------------------------------
-  uint16_t SIDManager::GetNumberOfAllocatedSIDs() const
+  void SIDManager::PushFree( uint16_t sid )
   {
-    XrdSysMutexHelper scopedLock( pMutex );
-    return pSIDCeiling - pFreeSIDs.size() - pTimeOutSIDs.size() - 1;
+    uint64_t head = pFreeHead.value.load( std::memory_order_relaxed );
+    uint64_t newHead;
+    do
+    {
+      pSlots[sid].next.store( head & 0xffff, std::memory_order_relaxed );
+      newHead = ((head >> 16) + 1) << 16 | sid;
+    }
+    while( !pFreeHead.value.compare_exchange_weak( head, newHead,
+                                                   std::memory_order_release,
+                                                   std::memory_order_relaxed ) );
   }
 }
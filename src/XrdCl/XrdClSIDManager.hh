@@ -19,16 +19,18 @@
 #ifndef __XRD_CL_SID_MANAGER_HH__
 #define __XRD_CL_SID_MANAGER_HH__
 
-#include <list>
-#include <set>
+#include <atomic>
 #include <stdint.h>
-#include "XrdSys/XrdSysPthread.hh"
 #include "XrdCl/XrdClStatus.hh"
 
 namespace XrdCl
 {
   //----------------------------------------------------------------------------
   //! Handle XRootD stream IDs
+  //!
+  //! The state of every stream ID is kept in a fixed table, so no operation
+  //! needs a lock: released IDs are kept on a lock-free stack threaded through
+  //! the table and new IDs are carved out by atomically raising the ceiling.
   //----------------------------------------------------------------------------
   class SIDManager
   {
@@ -37,7 +39,7 @@ namespace XrdCl
       //------------------------------------------------------------------------
       //! Constructor
       //------------------------------------------------------------------------
-      SIDManager(): pSIDCeiling(1) {}
+      SIDManager();
 
       //------------------------------------------------------------------------
       //! Allocate a SID
@@ -77,20 +79,60 @@ namespace XrdCl
       //------------------------------------------------------------------------
       uint32_t NumberOfTimedOutSIDs() const
       {
-        XrdSysMutexHelper scopedLock( pMutex );
-        return pTimeOutSIDs.size();
+        return pTimedOut.load( std::memory_order_relaxed );
       }
 
       //------------------------------------------------------------------------
       //! Number of allocated streams
       //------------------------------------------------------------------------
-      uint16_t GetNumberOfAllocatedSIDs() const;
+      uint16_t GetNumberOfAllocatedSIDs() const
+      {
+        return pAllocated.load( std::memory_order_relaxed );
+      }
 
     private:
-      std::list<uint16_t>  pFreeSIDs;
-      std::set<uint16_t>   pTimeOutSIDs;
-      uint16_t             pSIDCeiling;
-      mutable XrdSysMutex  pMutex;
+      SIDManager(const SIDManager &other);
+      SIDManager &operator = (const SIDManager &other);
+
+      enum SIDState
+      {
+        Free     = 0,
+        InUse    = 1,
+        TimedOut = 2
+      };
+
+      //------------------------------------------------------------------------
+      //! Put a SID on the free stack
+      //------------------------------------------------------------------------
+      void PushFree( uint16_t sid );
+
+      //------------------------------------------------------------------------
+      //! Stream ID state and link to the next free stream ID
+      //------------------------------------------------------------------------
+      struct SIDSlot
+      {
+        std::atomic<uint16_t> next;
+        std::atomic<uint8_t>  state;
+      };
+
+      //------------------------------------------------------------------------
+      //! Counters that are updated concurrently, each on its own cache line
+      //------------------------------------------------------------------------
+      struct PaddedCounter
+      {
+        std::atomic<uint64_t> value;
+        char                  pad[64 - sizeof(std::atomic<uint64_t>)];
+      };
+
+      //------------------------------------------------------------------------
+      //! The free stack head holds the top SID in the low 16 bits and a
+      //! modification count above to protect against ABA; 0 means empty
+      //------------------------------------------------------------------------
+      PaddedCounter             pFreeHead;
+      PaddedCounter             pCeiling;
+      std::atomic<uint32_t>     pTimedOut;
+      std::atomic<uint16_t>     pAllocated;
+      SIDSlot                   pSlots[65536];
   };
 }
 
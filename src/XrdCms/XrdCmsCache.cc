@@ -63,13 +63,13 @@ public:
 
 void   DoIt() {Cache.Recycle(myList); delete this;}
 
-       XrdCmsCacheJob(XrdCmsKeyItem *List)
-                     : XrdJob("cache scrubber"), myList(List) {}
+       XrdCmsCacheJob(XrdCmsKeyItem **List) : XrdJob("cache scrubber")
+                     {memcpy(myList, List, sizeof(myList));}
       ~XrdCmsCacheJob() {}
 
 private:
 
-XrdCmsKeyItem *myList;
+XrdCmsKeyItem *myList[XrdCmsCache::numShards];
 };
 
 /******************************************************************************/
@@ -116,18 +116,19 @@ void *XrdCmsStartTickTock(void *carg)
   
 int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
 {
+   Shard &sP = getShard(Sel.Path);
    XrdCmsKeyItem *iP;
    SMask_t xmask;
    int isrw = (Sel.Opts & XrdCmsSelect::Write), isnew = 0;
 
 // Serialize processing
 //
-   myMutex.Lock();
+   sP.myMutex.Lock();
 
 // Check for fast path processing
 //
    if (  !(iP = Sel.Path.TODRef) || !(iP->Key.Equiv(Sel.Path)))
-      if ((iP = Sel.Path.TODRef = CTable.Find(Sel.Path)))
+      if ((iP = Sel.Path.TODRef = sP.CTable.Find(Sel.Path)))
          Sel.Path.Ref = iP->Key.Ref;
 
 // Add/Modify the entry
@@ -137,8 +138,8 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
           {iP->Loc.deadline = QDelay + time(0);
            iP->Loc.lifeline = nilTMO + iP->Loc.deadline;
            iP->Loc.hfvec = 0; iP->Loc.pfvec = 0; iP->Loc.qfvec = 0;
-           iP->Loc.TOD_B = BClock;
-           iP->Key.TOD = Tock;
+           iP->Loc.TOD_B = sP.BClock;
+           iP->Key.TOD = sP.Tock;
           } else {
            xmask = iP->Loc.pfvec;
            if (Sel.Opts & XrdCmsSelect::Pending) iP->Loc.pfvec |= mask;
@@ -155,11 +156,11 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
                      }
           }
       } else if (!(Sel.Opts & XrdCmsSelect::Advisory))
-                {Sel.Path.TOD = Tock;
-                 if ((iP = CTable.Add(Sel.Path)))
+                {Sel.Path.TOD = sP.Tock;
+                 if ((iP = sP.CTable.Add(Sel.Path)))
                     {iP->Loc.pfvec    = (Sel.Opts&XrdCmsSelect::Pending?mask:0);
                      iP->Loc.hfvec    = mask;
-                     iP->Loc.TOD_B    = BClock;
+                     iP->Loc.TOD_B    = sP.BClock;
                      iP->Loc.qfvec    = 0;
                      iP->Loc.deadline = QDelay + time(0);
                      iP->Loc.lifeline = nilTMO + iP->Loc.deadline;
@@ -170,7 +171,7 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
 
 // All done
 //
-   myMutex.UnLock();
+   sP.myMutex.UnLock();
    return isnew;
 }
   
@@ -190,29 +191,30 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
   
 int XrdCmsCache::DelFile(XrdCmsSelect &Sel, SMask_t mask)
 {
+   Shard &sP = getShard(Sel.Path);
    XrdCmsKeyItem *iP;
    int gone4good;
 
 // Lock the hash table
 //
-   myMutex.Lock();
+   sP.myMutex.Lock();
 
 // Look up the entry and remove server
 //
-   if ((iP = CTable.Find(Sel.Path)))
+   if ((iP = sP.CTable.Find(Sel.Path)))
       {iP->Loc.hfvec &= ~mask;
        iP->Loc.pfvec &= ~mask;
        if ((gone4good = (iP->Loc.hfvec == 0)))
           {if (nilTMO) iP->Loc.lifeline = nilTMO + time(0);
            if (!(Sel.Opts & XrdCmsSelect::Advisory)
-           &&  XrdCmsKeyItem::Unload(iP) && !CTable.Recycle(iP))
+           &&  sP.Keys.Unload(iP) && !sP.CTable.Recycle(iP))
               Say.Emsg("DelFile", "Delete failed for", iP->Key.Val);
           }
       } else gone4good = 0;
 
 // All done
 //
-   myMutex.UnLock();
+   sP.myMutex.UnLock();
    return gone4good;
 }
   
@@ -231,19 +233,20 @@ int XrdCmsCache::DelFile(XrdCmsSelect &Sel, SMask_t mask)
   
 int  XrdCmsCache::GetFile(XrdCmsSelect &Sel, SMask_t mask)
 {
+   Shard &sP = getShard(Sel.Path);
    XrdCmsKeyItem *iP;
    SMask_t bVec;
    int retc;
 
 // Lock the hash table
 //
-   myMutex.Lock();
+   sP.myMutex.Lock();
 
 // Look up the entry and return location information
 //
-   if ((iP = CTable.Find(Sel.Path)))
-      {if ((bVec = (iP->Loc.TOD_B < BClock 
-                 ? getBVec(iP->Key.TOD, iP->Loc.TOD_B) & mask : 0)))
+   if ((iP = sP.CTable.Find(Sel.Path)))
+      {if ((bVec = (iP->Loc.TOD_B < sP.BClock
+                 ? getBVec(sP, iP->Key.TOD, iP->Loc.TOD_B) & mask : 0)))
           {iP->Loc.hfvec &= ~bVec; 
            iP->Loc.pfvec &= ~bVec;
            iP->Loc.qfvec &= ~mask;
@@ -258,15 +261,15 @@ int  XrdCmsCache::GetFile(XrdCmsSelect &Sel, SMask_t mask)
        if (nilTMO && retc == 1 && iP->Loc.hfvec == 0
        &&  iP->Loc.lifeline <= time(0)) retc = 0;
 
-       Sel.Vec.hf      = okVec & iP->Loc.hfvec;
-       Sel.Vec.pf      = okVec & iP->Loc.pfvec;
-       Sel.Vec.bf      = okVec & (bVec | iP->Loc.qfvec); iP->Loc.qfvec = 0;
+       Sel.Vec.hf      = sP.okVec & iP->Loc.hfvec;
+       Sel.Vec.pf      = sP.okVec & iP->Loc.pfvec;
+       Sel.Vec.bf      = sP.okVec & (bVec | iP->Loc.qfvec); iP->Loc.qfvec = 0;
        Sel.Path.Ref    = iP->Key.Ref;
       } else retc = 0;
 
 // All done
 //
-   myMutex.UnLock();
+   sP.myMutex.UnLock();
    Sel.Path.TODRef = iP;
    return retc;
 }
@@ -278,11 +281,12 @@ int  XrdCmsCache::GetFile(XrdCmsSelect &Sel, SMask_t mask)
 int XrdCmsCache::UnkFile(XrdCmsSelect &Sel, SMask_t mask)
 {
    EPNAME("UnkFile");
+   Shard &sP = getShard(Sel.Path);
    XrdCmsKeyItem *iP;
 
 // Make sure we have the proper information. If so, lock the hash table
 //
-   myMutex.Lock();
+   sP.myMutex.Lock();
 
 // Look up the entry and if valid update the unqueried vector. Note that
 // this method may only be called after GetFile() or AddFile() for a new entry
@@ -294,7 +298,7 @@ int XrdCmsCache::UnkFile(XrdCmsSelect &Sel, SMask_t mask)
 
 // Return result
 //
-   myMutex.UnLock();
+   sP.myMutex.UnLock();
    DEBUG("rc=" <<(iP ? 1 : 0) <<" path=" <<Sel.Path.Val);
    return (iP ? 1 : 0);
 }
@@ -313,7 +317,8 @@ int XrdCmsCache::WT4File(XrdCmsSelect &Sel, SMask_t mask)
 // Make sure we have the proper information. If so, lock the hash table
 //
    if (!Sel.InfoP) return DLTime;
-   myMutex.Lock();
+   Shard &sP = getShard(Sel.Path);
+   sP.myMutex.Lock();
 
 // Look up the entry and if valid add it to the callback queue. Note that
 // this method may only be called after GetFile() or AddFile() for a new entry
@@ -328,7 +333,7 @@ int XrdCmsCache::WT4File(XrdCmsSelect &Sel, SMask_t mask)
 
 // Return result
 //
-   myMutex.UnLock();
+   sP.myMutex.UnLock();
    DEBUG("rc=" <<retc <<" path=" <<Sel.Path.Val);
    return retc;
 }
@@ -343,13 +348,16 @@ int XrdCmsCache::WT4File(XrdCmsSelect &Sel, SMask_t mask)
 void XrdCmsCache::Bounce(SMask_t smask, int SNum)
 {
 
-// Simply indicate that this server bounced
+// Simply indicate that this server bounced. Each shard keeps its own clock.
 //
-   myMutex.Lock();
-   Bounced[SNum] = ++BClock;
-   okVec |= smask;
-   if (SNum > vecHi) vecHi = SNum;
-   myMutex.UnLock();
+   for (int i = 0; i < numShards; i++)
+       {Shard &sP = Shards[i];
+        sP.myMutex.Lock();
+        sP.Bounced[SNum] = ++sP.BClock;
+        sP.okVec |= smask;
+        if (SNum > sP.vecHi) sP.vecHi = SNum;
+        sP.myMutex.UnLock();
+       }
 }
 
 /******************************************************************************/
@@ -364,13 +372,16 @@ void XrdCmsCache::Drop(SMask_t smask, int SNum, int xHi)
 //
    Paths.Remove(smask);
 
-// Remove the node from the list of valid nodes
+// Remove the node from the list of valid nodes in each shard
 //
-   myMutex.Lock();
-   Bounced[SNum] = 0;
-   okVec &= nmask;
-   vecHi = xHi;
-   myMutex.UnLock();
+   for (int i = 0; i < numShards; i++)
+       {Shard &sP = Shards[i];
+        sP.myMutex.Lock();
+        sP.Bounced[SNum] = 0;
+        sP.okVec &= nmask;
+        sP.vecHi = xHi;
+        sP.myMutex.UnLock();
+       }
 }
 
 /******************************************************************************/
@@ -381,6 +392,7 @@ int XrdCmsCache::Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold
 {
    XrdCmsKeyItem *iP;
    pthread_t tid;
+   int i;
 
 // Indicate whether we are a shared-everything setup as this changes how we
 // dispatch clients to newly discovered files (see Dispatch()).
@@ -409,11 +421,16 @@ int XrdCmsCache::Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold
        return 0;
       }
 
-// Get the first reserve of cache items
+// Get the first reserve of cache items for each shard
 //
-   iP = XrdCmsKeyItem::Alloc(0);
-   XrdCmsKeyItem::Unload((unsigned int)0);
-   iP->Recycle();
+   for (i = 0; i < numShards; i++)
+       {Shard &sP = Shards[i];
+        sP.myMutex.Lock();
+        iP = sP.Keys.Alloc(0);
+        sP.Keys.Unload((unsigned int)0);
+        if (iP) sP.Keys.Recycle(iP);
+        sP.myMutex.UnLock();
+       }
 
 // All done
 //
@@ -426,17 +443,24 @@ int XrdCmsCache::Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold
 
 void *XrdCmsCache::TickTock()
 {
-   XrdCmsKeyItem *iP;
+   XrdCmsKeyItem *iP[numShards];
+   bool doRecycle;
+   int i;
 
-// Simply adjust the clock and trim old entries
+// Simply adjust the clock and trim old entries, one shard at a time. The old
+// entries of all the shards are recycled by a single job.
 //
    do {XrdSysTimer::Snooze(Tick);
-       myMutex.Lock();
-       Tock = (Tock+1) & XrdCmsKeyItem::TickMask;
-       Bhistory[Tock].Start = Bhistory[Tock].End = 0;
-       iP = XrdCmsKeyItem::Unload(Tock);
-       myMutex.UnLock();
-       if (iP) Sched->Schedule((XrdJob *)new XrdCmsCacheJob(iP));
+       doRecycle = false;
+       for (i = 0; i < numShards; i++)
+           {Shard &sP = Shards[i];
+            sP.myMutex.Lock();
+            sP.Tock = (sP.Tock+1) & XrdCmsKeyItem::TickMask;
+            sP.Bhistory[sP.Tock].Start = sP.Bhistory[sP.Tock].End = 0;
+            if ((iP[i] = sP.Keys.Unload(sP.Tock))) doRecycle = true;
+            sP.myMutex.UnLock();
+           }
+       if (doRecycle) Sched->Schedule((XrdJob *)new XrdCmsCacheJob(iP));
       } while(1);
 
 // Keep compiler happy
@@ -502,7 +526,9 @@ void XrdCmsCache::Dispatch(XrdCmsSelect &Sel, XrdCmsKeyItem *iP,
 /*                               g e t B V e c                                */
 /******************************************************************************/
   
-SMask_t XrdCmsCache::getBVec(unsigned int TODa, unsigned int &TODb)
+// The shard lock must be held upon entry.
+//
+SMask_t XrdCmsCache::getBVec(Shard &sP, unsigned int TODa, unsigned int &TODb)
 {
    EPNAME("getBVec");
    SMask_t BVec(0);
@@ -510,20 +536,20 @@ SMask_t XrdCmsCache::getBVec(unsigned int TODa, unsigned int &TODb)
 
 // See if we can use a previously calculated bVec
 //
-   if (Bhistory[TODa].End == BClock && Bhistory[TODa].Start <= TODb)
-      {Bhits++; TODb = BClock; return Bhistory[TODa].Vec;}
+   if (sP.Bhistory[TODa].End == sP.BClock && sP.Bhistory[TODa].Start <= TODb)
+      {sP.Bhits++; TODb = sP.BClock; return sP.Bhistory[TODa].Vec;}
 
 // Calculate the new vector
 //
-   for (i = 0; i <= vecHi; i++)
-       if (TODb < Bounced[i]) BVec |= 1ULL << i;
+   for (i = 0; i <= sP.vecHi; i++)
+       if (TODb < sP.Bounced[i]) BVec.Set(i);
 
-   Bhistory[TODa].Vec   = BVec;
-   Bhistory[TODa].Start = TODb;
-   Bhistory[TODa].End   = BClock;
-   TODb                 = BClock;
-   Bmiss++;
-   if (!(Bmiss & 0xff)) DEBUG("hits=" <<Bhits <<" miss=" <<Bmiss);
+   sP.Bhistory[TODa].Vec   = BVec;
+   sP.Bhistory[TODa].Start = TODb;
+   sP.Bhistory[TODa].End   = sP.BClock;
+   TODb                    = sP.BClock;
+   sP.Bmiss++;
+   if (!(sP.Bmiss & 0xff)) DEBUG("hits=" <<sP.Bhits <<" miss=" <<sP.Bmiss);
    return BVec;
 }
 
@@ -531,40 +557,44 @@ SMask_t XrdCmsCache::getBVec(unsigned int TODa, unsigned int &TODb)
 /*                               R e c y c l e                                */
 /******************************************************************************/
   
-void XrdCmsCache::Recycle(XrdCmsKeyItem *theList)
+void XrdCmsCache::Recycle(XrdCmsKeyItem **theList)
 {
    XrdCmsKeyItem *iP;
    char msgBuff[100];
-   int numNull, numHave, numFree, numRecycled = 0;
-
-// Recycle the list of cache items, as needed
-//
-   while((iP = theList))
-        {theList = iP->Key.TODRef;
-         if (iP->Loc.roPend) RRQ.Del(iP->Loc.roPend, iP);
-         if (iP->Loc.rwPend) RRQ.Del(iP->Loc.rwPend, iP);
-         myMutex.Lock(); CTable.Recycle(iP); myMutex.UnLock();
-         numRecycled++;
-        }
-
-// See if we have enough items in reserve
-//
-   myMutex.Lock();
-   XrdCmsKeyItem::Stats(numHave, numFree, numNull);
-   if (numFree < XrdCmsKeyItem::minFree)
-      {myMutex.UnLock();
-       if (!(numNull /= 4)) numNull = 1;
-       numHave += XrdCmsKeyItem::minAlloc * numNull;
-       while(numNull--)
-            {myMutex.Lock();
-             numFree = XrdCmsKeyItem::Replenish();
-             myMutex.UnLock();
-            }
-      } else myMutex.UnLock();
+   int numNull, numHave, numFree, numRecycled = 0, totHave = 0, totFree = 0;
+
+// Recycle the list of cache items of each shard, as needed
+//
+   for (int i = 0; i < numShards; i++)
+       {Shard &sP = Shards[i];
+        while((iP = theList[i]))
+             {theList[i] = iP->Key.TODRef;
+              if (iP->Loc.roPend) RRQ.Del(iP->Loc.roPend, iP);
+              if (iP->Loc.rwPend) RRQ.Del(iP->Loc.rwPend, iP);
+              sP.myMutex.Lock(); sP.CTable.Recycle(iP); sP.myMutex.UnLock();
+              numRecycled++;
+             }
+
+     // See if we have enough items in reserve
+     //
+        sP.myMutex.Lock();
+        sP.Keys.Stats(numHave, numFree, numNull);
+        if (numFree < XrdCmsKeyItem::minFree)
+           {sP.myMutex.UnLock();
+            if (!(numNull /= 4)) numNull = 1;
+            numHave += XrdCmsKeyItem::minAlloc * numNull;
+            while(numNull--)
+                 {sP.myMutex.Lock();
+                  numFree = sP.Keys.Replenish();
+                  sP.myMutex.UnLock();
+                 }
+           } else sP.myMutex.UnLock();
+        totHave += numHave; totFree += numFree;
+       }
 
 // Log the stats
 //
    sprintf(msgBuff, "%d cache items; %d allocated %d free",
-           numRecycled, numHave, numFree);
+           numRecycled, totHave, totFree);
    Say.Emsg("Recycle", msgBuff);
 }
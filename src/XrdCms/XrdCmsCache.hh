@@ -80,41 +80,67 @@ void       *TickTock();
 
 static const int min_nxTime = 60;
 
-            XrdCmsCache() : okVec(0), Tick(8*60*60), Tock(0), BClock(0), 
-                            nilTMO(0),
-                            DLTime(5), QDelay(5), Bhits(0), Bmiss(0), vecHi(-1),
-                            isDFS(0)
-                          {memset(Bounced,  0, sizeof(Bounced));
-                           memset(Bhistory, 0, sizeof(Bhistory));
-                          }
+// The cache is partitioned by key hash into shards that are locked
+// independently. Each shard has its own hash table, expiry wheel, and copy of
+// the server bounce state so that a lookup never touches another shard.
+//
+static const int shardBits  = 4;
+static const int numShards  = 1 << shardBits;
+
+// ShardOf() returns the shard holding keys with the passed hash. We use the
+// high order bits of the hash as the table within a shard uses the hash
+// modulo its size.
+//
+static int  ShardOf(unsigned int kHash) {return kHash >> (32 - shardBits);}
+
+            XrdCmsCache() : Tick(8*60*60), nilTMO(0), DLTime(5), QDelay(5),
+                            isDFS(0) {}
            ~XrdCmsCache() {}   // Never gets deleted
 
 private:
 
+struct Shard
+      {XrdSysMutex   myMutex;
+       XrdCmsKeyPool Keys;
+       XrdCmsNash    CTable;
+       struct {SMask_t      Vec;
+               unsigned int Start;
+               unsigned int End;
+              }      Bhistory[XrdCmsKeyItem::TickRate];
+       unsigned int  Bounced[STMax];
+       SMask_t       okVec;
+       unsigned int  Tock;
+       unsigned int  BClock;
+                int  Bhits;
+                int  Bmiss;
+                int  vecHi;
+
+       Shard() : CTable(&Keys, 1597, 2584), okVec(0), Tock(0), BClock(0),
+                 Bhits(0), Bmiss(0), vecHi(-1)
+               {memset(Bounced,  0, sizeof(Bounced));
+                for (unsigned int i = 0; i < XrdCmsKeyItem::TickRate; i++)
+                    {Bhistory[i].Vec   = 0;
+                     Bhistory[i].Start = Bhistory[i].End = 0;
+                    }
+               }
+      };
+
+inline Shard &getShard(XrdCmsKey &Key)
+              {if (!Key.Hash) Key.setHash();
+               return Shards[ShardOf(Key.Hash)];
+              }
+
 void          Add2Q(XrdCmsRRQInfo *Info, XrdCmsKeyItem *cp, int selOpts);
 void          Dispatch(XrdCmsSelect &Sel, XrdCmsKeyItem *cinfo,
                        short roQ, short rwQ);
-SMask_t       getBVec(unsigned int todA, unsigned int &todB);
-void          Recycle(XrdCmsKeyItem *theList);
-
-struct  {SMask_t      Vec;
-         unsigned int Start;
-         unsigned int End;
-        }             Bhistory[XrdCmsKeyItem::TickRate];
-
-XrdSysMutex   myMutex;
-XrdCmsNash    CTable;
-unsigned int  Bounced[STMax];
-SMask_t       okVec;
+SMask_t       getBVec(Shard &sP, unsigned int todA, unsigned int &todB);
+void          Recycle(XrdCmsKeyItem **theList);
+
+Shard         Shards[numShards];
 unsigned int  Tick;
-unsigned int  Tock;
-unsigned int  BClock;
          int  nilTMO;
          int  DLTime;
          int  QDelay;
-         int  Bhits;
-         int  Bmiss;
-         int  vecHi;
          int  isDFS;
 };
 
@@ -499,7 +499,7 @@ void XrdCmsMeter::SpaceMsg(int why)
   
 void XrdCmsMeter::UpdtSpace()
 {
-   static const SMask_t allNodes(~0);
+   static const SMask_t allNodes(~SMask_t(0));
    SpaceData mySpace;
 
 // Get new space values for the cluser
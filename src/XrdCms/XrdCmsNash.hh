@@ -41,11 +41,11 @@ XrdCmsKeyItem *Find(XrdCmsKey &Key);
 
 int            Recycle(XrdCmsKeyItem *rip);
 
-// When allocateing a new nash, specify the required starting size. Make
-// sure that the previous number is the correct Fibonocci antecedent. The
-// series is simply n[j] = n[j-1] + n[j-2].
+// When allocateing a new nash, specify the pool that supplies the key items
+// and the required starting size. Make sure that the previous number is the
+// correct Fibonocci antecedent. The series is simply n[j] = n[j-1] + n[j-2].
 //
-    XrdCmsNash(int psize = 17711, int size = 28657);
+    XrdCmsNash(XrdCmsKeyPool *pool, int psize = 17711, int size = 28657);
    ~XrdCmsNash() {} // Never gets deleted
 
 private:
@@ -54,6 +54,7 @@ static const int LoadMax = 80;
 
 void               Expand();
 
+XrdCmsKeyPool   *keypool;
 XrdCmsKeyItem  **nashtable;
 int              prevtablesize;
 int              nashtablesize;
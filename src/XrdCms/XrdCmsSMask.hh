@@ -0,0 +1,184 @@
+#ifndef XRDCMSSMASK__H
+#define XRDCMSSMASK__H
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d C m s S M a s k . h h                         */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <ostream>
+
+/******************************************************************************/
+/*                     C l a s s   X r d C m s S M a s k                      */
+/******************************************************************************/
+
+// A server set holds one bit per cell slot. It is a fixed array of 64-bit
+// words so that a cell may have more than 64 subscribers. All operations are
+// simple loops over a compile-time word count, which the compiler unrolls and
+// vectorizes; with a single word the code is identical to using an integer.
+// A value constructed from an integer sets the low order word and clears the
+// rest, so SMask_t(0) is the empty set and ~SMask_t(0) is the full set.
+//
+template<int nBits>
+class XrdCmsSMask
+{
+public:
+
+static const int nWords = (nBits + 63) / 64;
+
+inline int  Count() const
+                 {int n = 0;
+                  for (int i = 0; i < nWords; i++)
+                      n += __builtin_popcountll(Word[i]);
+                  return n;
+                 }
+
+inline int  First() const
+                 {for (int i = 0; i < nWords; i++)
+                      if (Word[i]) return i*64 + __builtin_ctzll(Word[i]);
+                  return -1;
+                 }
+
+inline bool Many() const
+                 {int n = 0;
+                  for (int i = 0; i < nWords; i++)
+                      if (Word[i] && (++n > 1 || (Word[i] & (Word[i]-1))))
+                         return true;
+                  return false;
+                 }
+
+inline XrdCmsSMask &Set(int n)
+                 {Word[n >> 6] |= 1ULL << (n & 63); return *this;}
+
+inline bool Test(int n) const
+                 {return (Word[n >> 6] & (1ULL << (n & 63))) != 0;}
+
+inline static
+       XrdCmsSMask Bit(int n) {XrdCmsSMask m(0); return m.Set(n);}
+
+inline char *Hex(char *buff, int blen) const
+                 {int i = nWords-1, n;
+                  while(i > 0 && !Word[i]) i--;
+                  n = snprintf(buff, blen, "%llx", Word[i]);
+                  while(--i >= 0 && n < blen)
+                       n += snprintf(buff+n, blen-n, "%016llx", Word[i]);
+                  return buff;
+                 }
+
+inline explicit operator bool() const
+                 {unsigned long long any = 0;
+                  for (int i = 0; i < nWords; i++) any |= Word[i];
+                  return any != 0;
+                 }
+
+inline bool operator!() const {return !static_cast<bool>(*this);}
+
+inline XrdCmsSMask operator~() const
+                 {XrdCmsSMask m;
+                  for (int i = 0; i < nWords; i++) m.Word[i] = ~Word[i];
+                  return m;
+                 }
+
+inline XrdCmsSMask &operator&=(const XrdCmsSMask &rhs)
+                 {for (int i = 0; i < nWords; i++) Word[i] &= rhs.Word[i];
+                  return *this;
+                 }
+
+inline XrdCmsSMask &operator|=(const XrdCmsSMask &rhs)
+                 {for (int i = 0; i < nWords; i++) Word[i] |= rhs.Word[i];
+                  return *this;
+                 }
+
+inline XrdCmsSMask &operator^=(const XrdCmsSMask &rhs)
+                 {for (int i = 0; i < nWords; i++) Word[i] ^= rhs.Word[i];
+                  return *this;
+                 }
+
+inline XrdCmsSMask &operator<<=(int n)
+                 {int ws = n >> 6, bs = n & 63, i;
+                  for (i = nWords-1; i >= 0; i--)
+                      {unsigned long long w = (i-ws >= 0 ? Word[i-ws] : 0);
+                       if (bs)
+                          {w <<= bs;
+                           if (i-ws-1 >= 0) w |= Word[i-ws-1] >> (64-bs);
+                          }
+                       Word[i] = w;
+                      }
+                  return *this;
+                 }
+
+inline XrdCmsSMask &operator>>=(int n)
+                 {int ws = n >> 6, bs = n & 63, i;
+                  for (i = 0; i < nWords; i++)
+                      {unsigned long long w = (i+ws < nWords ? Word[i+ws] : 0);
+                       if (bs)
+                          {w >>= bs;
+                           if (i+ws+1 < nWords) w |= Word[i+ws+1] << (64-bs);
+                          }
+                       Word[i] = w;
+                      }
+                  return *this;
+                 }
+
+inline XrdCmsSMask operator<<(int n) const {XrdCmsSMask m(*this); return m<<=n;}
+inline XrdCmsSMask operator>>(int n) const {XrdCmsSMask m(*this); return m>>=n;}
+
+friend
+inline XrdCmsSMask operator&(XrdCmsSMask lhs, const XrdCmsSMask &rhs)
+                            {return lhs &= rhs;}
+friend
+inline XrdCmsSMask operator|(XrdCmsSMask lhs, const XrdCmsSMask &rhs)
+                            {return lhs |= rhs;}
+friend
+inline XrdCmsSMask operator^(XrdCmsSMask lhs, const XrdCmsSMask &rhs)
+                            {return lhs ^= rhs;}
+
+friend
+inline bool        operator==(const XrdCmsSMask &lhs, const XrdCmsSMask &rhs)
+                             {unsigned long long dif = 0;
+                              for (int i = 0; i < nWords; i++)
+                                  dif |= lhs.Word[i] ^ rhs.Word[i];
+                              return dif == 0;
+                             }
+friend
+inline bool        operator!=(const XrdCmsSMask &lhs, const XrdCmsSMask &rhs)
+                             {return !(lhs == rhs);}
+
+friend
+std::ostream      &operator<<(std::ostream &os, const XrdCmsSMask &m)
+                             {char buff[nWords*16+1];
+                              return os <<m.Hex(buff, sizeof(buff));
+                             }
+
+                   XrdCmsSMask() {}
+
+                   XrdCmsSMask(unsigned long long val)
+                              {Word[0] = val;
+                               for (int i = 1; i < nWords; i++) Word[i] = 0;
+                              }
+
+private:
+
+unsigned long long Word[nWords];
+};
+#endif
@@ -30,13 +30,21 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
   
-typedef unsigned long long SMask_t;
-
-#define FULLMASK 0xFFFFFFFFFFFFFFFFULL
-
-// The following defines our cell size (maximum subscribers)
+// The following defines our cell size (maximum subscribers). It defaults to
+// 64 but may be raised at build time (cmake -DCMS_MAXNODES=n) in which case
+// it should be a multiple of 64. Each subscriber has a bit in a server set.
 //
+#ifdef XRDCMS_MAXNODES
+#define STMax XRDCMS_MAXNODES
+#else
 #define STMax 64
+#endif
+
+#include "XrdCms/XrdCmsSMask.hh"
+
+typedef XrdCmsSMask<STMax> SMask_t;
+
+#define FULLMASK (~SMask_t(0))
 
 // The following defines the maximum number of redirectors. It is one greater
 // than the actual maximum as the zeroth is never used.
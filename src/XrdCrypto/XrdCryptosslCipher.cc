@@ -604,10 +604,10 @@ XrdCryptosslCipher::XrdCryptosslCipher(const XrdCryptosslCipher &c)
          const BIGNUM *pub, *pri;
          DH_get0_key(c.fDH, &pub, &pri);
          DH_set0_key(fDH, pub ? BN_dup(pub) : NULL, pri ? BN_dup(pri) : NULL);
-         int dhrc = 0;
-         DH_check(fDH,&dhrc);
-         if (dhrc == 0)
-            valid = 1;
+         // The parameters were checked when the original was made; checking
+         // them again involves primality tests and costs more than all the
+         // rest of a login
+         valid = 1;
       }
    }
    if (valid) {
@@ -192,6 +192,17 @@ XrdCryptosslRSA::XrdCryptosslRSA(const XrdCryptosslRSA &r) : XrdCryptoRSA()
       return;
    }
 
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+   // A complete key has been checked already and is never changed in place:
+   // share it rather than copying it, which would check it again at a cost
+   // comparable to a few private key operations
+   if (r.status == kComplete && EVP_PKEY_up_ref(r.fEVP)) {
+      fEVP = r.fEVP;
+      status = kComplete;
+      return;
+   }
+#endif
+
    // If the given key is set, copy it via a bio
    const BIGNUM *d;
    RSA_get0_key(EVP_PKEY_get0_RSA(r.fEVP), NULL, NULL, &d);
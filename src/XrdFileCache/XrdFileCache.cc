@@ -33,6 +33,7 @@
 #include "XrdFileCache.hh"
 #include "XrdFileCacheTrace.hh"
 #include "XrdFileCacheInfo.hh"
+#include "XrdFileCachePurgeIndex.hh"
 #include "XrdFileCacheIOEntireFile.hh"
 #include "XrdFileCacheIOFileBlock.hh"
 
@@ -146,6 +147,7 @@ Cache::Cache() : XrdOucCache(),
    m_log(0, "XrdFileCache_"),
    m_trace(0),
    m_traceID("Manager"),
+   m_purgeIndex(0),
    m_prefetch_condVar(0),
    m_RAMblocks_used(0),
    m_isClient(false)
@@ -39,6 +39,7 @@ class Log;
 namespace XrdFileCache {
 class File;
 class IO;
+class PurgeIndex;
 }
 
 
@@ -73,6 +74,7 @@ struct Configuration
    long long m_diskUsageLWM;            //!< cache purge low water mark
    long long m_diskUsageHWM;            //!< cache purge high water mark
    int       m_purgeInterval;           //!< sleep interval between cache purges
+   std::string m_purgeIndexPath;        //!< journal of persistent purge index, empty if disabled
 
    long long m_bufferSize;              //!< prefetch buffer size, default 1MB
    long long m_RamAbsAvailable;         //!< available from configuration
@@ -211,12 +213,19 @@ public:
    
    XrdSysTrace* GetTrace() { return m_trace; }
 
+   //---------------------------------------------------------------------
+   //! Persistent purge index, 0 if not configured.
+   //---------------------------------------------------------------------
+   PurgeIndex* GetPurgeIndex() const { return m_purgeIndex; }
+
 private:
    bool ConfigParameters(std::string, XrdOucStream&, TmpConfiguration &tmpc);
    bool ConfigXeq(char *, XrdOucStream &);
    bool xdlib(XrdOucStream &);
    bool xtrace(XrdOucStream &);
 
+   bool PurgeFile(const std::string& infoPath, long long nByte, long long& bytesToRemove);
+
    static Cache     *m_factory;         //!< this object
    static 
    XrdScheduler     *schedP;
@@ -227,6 +236,7 @@ private:
 
    XrdOucCacheStats  m_stats;           //!<
    XrdOss           *m_output_fs;       //!< disk cache file system
+   PurgeIndex       *m_purgeIndex;      //!< LRU index of cached files, optional
 
    std::vector<XrdFileCache::Decision*> m_decisionpoints;       //!< decision plugins
 
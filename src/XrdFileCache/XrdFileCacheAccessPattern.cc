@@ -0,0 +1,81 @@
+//----------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//----------------------------------------------------------------------------------
+
+#include "XrdFileCacheAccessPattern.hh"
+
+using namespace XrdFileCache;
+
+//------------------------------------------------------------------------------
+
+void AccessPattern::Observe(int first, int last)
+{
+   if (m_last < 0)
+   {
+      m_first = first;
+      m_last  = last;
+      return;
+   }
+
+   const int delta = first - m_last;
+
+   // Further reads within the last block tell us nothing new.
+   if (delta == 0)
+   {
+      if (last > m_last) m_last = last;
+      return;
+   }
+
+   if (delta > 0 && delta == m_stride)
+   {
+      // Sequential or the same stride as before.
+      if (m_conf < s_maxConf) ++m_conf;
+   }
+   else if (delta == 1)
+   {
+      m_stride = 1;
+      if (m_conf < s_maxConf) ++m_conf;
+   }
+   else if (delta > 0)
+   {
+      // Forward jump, e.g. sparse baskets: a new stride candidate.
+      m_stride = delta;
+      if (m_conf > 0) --m_conf;
+   }
+   else
+   {
+      // Backward jump, lose half of the confidence.
+      m_stride = 0;
+      m_conf  /= 2;
+   }
+
+   m_first = first;
+   m_last  = last;
+   ++m_nObs;
+}
+
+//------------------------------------------------------------------------------
+
+int AccessPattern::Window(int maxBlocks) const
+{
+   if (m_conf == 0 || m_stride <= 0) return 0;
+
+   // The window covers whole accesses unless a single one exceeds the limit.
+   const int width = m_last - m_first + 1;
+   int n = 1 << (m_conf - 1);
+   if (n > maxBlocks / width) n = maxBlocks / width;
+   return n ? n * width : maxBlocks;
+}
@@ -0,0 +1,88 @@
+#ifndef __XRDFILECACHE_ACCESS_PATTERN_HH__
+#define __XRDFILECACHE_ACCESS_PATTERN_HH__
+//----------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//----------------------------------------------------------------------------------
+
+namespace XrdFileCache
+{
+//----------------------------------------------------------------------------
+//! Detector of the block access pattern of a file.
+//!
+//! It is fed with the range of blocks touched by each read, or by each chunk
+//! of a vector read, in the order they were issued. Forward sequential and
+//! constant stride accesses raise the confidence in the prediction, other
+//! jumps lower it. The stride is the gap between the end of one access and
+//! the start of the next, and predicted accesses are as wide as the last one.
+//! The prefetch window grows exponentially with confidence and drops to zero
+//! for files that are read randomly.
+//!
+//! Not thread safe, the owning File serializes access.
+//----------------------------------------------------------------------------
+class AccessPattern
+{
+public:
+   //------------------------------------------------------------------------
+   //! Constructor.
+   //------------------------------------------------------------------------
+   AccessPattern() : m_first(-1), m_last(-1), m_stride(0), m_conf(0), m_nObs(0) {}
+
+   //------------------------------------------------------------------------
+   //! Record access to blocks first to last, inclusive.
+   //------------------------------------------------------------------------
+   void Observe(int first, int last);
+
+   //------------------------------------------------------------------------
+   //! Enough accesses were seen to judge the pattern.
+   //------------------------------------------------------------------------
+   bool IsKnown() const { return m_nObs >= s_minObs; }
+
+   //------------------------------------------------------------------------
+   //! \brief Number of predicted blocks worth prefetching.
+   //!
+   //! @param maxBlocks  upper limit of the window
+   //!
+   //! @return 0 if the file is accessed randomly
+   //------------------------------------------------------------------------
+   int Window(int maxBlocks) const;
+
+   //------------------------------------------------------------------------
+   //! \brief Predicted block index.
+   //!
+   //! @param n  position of the block among the predicted ones, starting
+   //!           at 1; all blocks of the next access come before those of
+   //!           the access after it
+   //------------------------------------------------------------------------
+   int Predict(int n) const
+   {
+      const int w = m_last - m_first + 1, k = (n - 1) / w;
+      return m_last + (k + 1) * m_stride + k * (w - 1) + (n - 1) % w;
+   }
+
+private:
+   static const int s_minObs  = 4;   //!< accesses seen before judging
+   static const int s_maxConf = 8;   //!< confidence saturation
+
+   int m_first;                      //!< first block of the last access
+   int m_last;                       //!< last block accessed
+   int m_stride;                     //!< distance from the end of an access
+                                     //!< to the start of the next
+   int m_conf;                       //!< confidence in m_stride
+   int m_nObs;                       //!< number of accesses seen
+};
+}
+
+#endif
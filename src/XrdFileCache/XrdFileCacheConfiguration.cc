@@ -1,5 +1,6 @@
 #include "XrdFileCache.hh"
 #include "XrdFileCacheTrace.hh"
+#include "XrdFileCachePurgeIndex.hh"
 
 #include "XrdOss/XrdOss.hh"
 #include "XrdOss/XrdOssCache.hh"
@@ -304,6 +305,13 @@ bool Cache::Config(XrdSysLogger *logger, const char *config_filename, const char
          loff += snprintf(buff + loff, sizeof(buff) - loff, "%s", unameBuff);
       }
 
+      if ( ! m_configuration.m_purgeIndexPath.empty())
+      {
+         loff += snprintf(buff + loff, sizeof(buff) - loff, "\n       pfc.purgeindex %s",
+                          m_configuration.m_purgeIndexPath.c_str());
+         m_purgeIndex = new PurgeIndex(m_trace, m_configuration.m_purgeIndexPath);
+      }
+
       m_log.Say( buff);
    }
 
@@ -440,6 +448,16 @@ bool Cache::ConfigParameters(std::string part, XrdOucStream& config, TmpConfigur
    {
       tmpc.m_flushRaw = config.GetWord();
    }
+   else if ( part == "purgeindex" )
+   {
+      const char* path = config.GetWord();
+      if ( ! path || path[0] != '/')
+      {
+         m_log.Emsg("Config", "Error: purgeindex requires an absolute path of the index file.");
+         return false;
+      }
+      m_configuration.m_purgeIndexPath = path;
+   }
    else
    {
       m_log.Emsg("Cache::ConfigParameters() unmatched pfc parameter", part.c_str());
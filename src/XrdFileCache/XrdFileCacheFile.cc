@@ -33,6 +33,7 @@
 #include "XrdOuc/XrdOucEnv.hh"
 #include "XrdSfs/XrdSfsInterface.hh"
 #include "XrdFileCache.hh"
+#include "XrdFileCachePurgeIndex.hh"
 
 
 using namespace XrdFileCache;
@@ -90,7 +91,9 @@ File::~File()
       m_output = NULL;
    }
 
-   TRACEF(Debug, "File::~File() ended, prefetch score = " <<  m_prefetchScore);
+   TRACEF(Debug, "File::~File() ended, prefetch score = " <<  m_prefetchScore
+          << ", blocks prefetched = " << m_stats.m_BlocksPrefetched << ", hits = " << m_stats.m_PrefetchHits
+          << ", wasted = " << m_stats.m_PrefetchWasted);
 }
 
 //------------------------------------------------------------------------------
@@ -173,6 +176,12 @@ bool File::FinalizeSyncBeforeExit()
      {
        m_cfi.WriteIOStatDetach(m_stats);
        m_detachTimeIsLogged = true;
+       if (cache()->GetPurgeIndex())
+       {
+          time_t detachTime = 0;
+          m_cfi.GetLatestDetachTime(detachTime);
+          cache()->GetPurgeIndex()->Update(m_filename + Info::m_infoExtension, detachTime, m_cfi.GetNDownloadedBytes());
+       }
        TRACEF(Debug, "File::FinalizeSyncBeforeExit scheduling sync to write detach stats");
        return true;
      }
@@ -286,6 +295,10 @@ bool File::Open()
    }
 
    m_cfi.WriteIOStatAttach();
+   if (cache()->GetPurgeIndex())
+   {
+      cache()->GetPurgeIndex()->Update(ifn, time(0), m_cfi.GetNDownloadedBytes());
+   }
    m_downloadCond.Lock();
    m_is_open = true;
    m_prefetchState = (m_cfi.IsComplete()) ? kComplete : kOn;
@@ -475,6 +488,8 @@ int File::Read(char* iUserBuff, long long iUserOff, int iUserSize)
    const int idx_first = iUserOff / BS;
    const int idx_last  = (iUserOff + iUserSize - 1) / BS;
 
+   ObserveAccess(idx_first, idx_last);
+
    BlockList_t blks_to_request, blks_to_process, blks_processed;
    IntList_t blks_on_disk,    blks_direct;
 
@@ -898,23 +913,44 @@ void File::Prefetch()
       if (m_prefetchState != kOn)
          return;
 
-      for (int f = 0; f < m_cfi.GetSizeInBits(); ++f)
+      int f = -1;
+
+      if (m_pattern.IsKnown())
+      {
+         // Follow the observed access pattern.
+         f = NextPredictedBlock();
+      }
+      else
       {
-         if ( ! m_cfi.TestBit(f))
+         // No pattern yet, take the first block not on disk and not in RAM.
+         for (int i = 0; i < m_cfi.GetSizeInBits(); ++i)
          {
-            f += m_offset/m_cfi.GetBufferSize();
-            BlockMap_i bi = m_block_map.find(f);
-            if (bi == m_block_map.end())
+            if ( ! m_cfi.TestBit(i))
             {
-               TRACEF(Dump, "File::Prefetch take block " << f);
-               cache()->RequestRAMBlock();
-               blks.push_back( PrepareBlockRequest(f, true) );
-               m_prefetchReadCnt++;
-               m_prefetchScore = float(m_prefetchHitCnt)/m_prefetchReadCnt;
-               break;
+               int bi = i + m_offset/m_cfi.GetBufferSize();
+               if (m_block_map.find(bi) == m_block_map.end())
+               {
+                  f = bi;
+                  break;
+               }
             }
          }
       }
+
+      if (f >= 0)
+      {
+         TRACEF(Dump, "File::Prefetch take block " << f);
+         cache()->RequestRAMBlock();
+         blks.push_back( PrepareBlockRequest(f, true) );
+         m_prefetchReadCnt++;
+         m_prefetchScore = float(m_prefetchHitCnt)/m_prefetchReadCnt;
+
+         if (m_prefetchUsed.empty())
+            m_prefetchUsed.resize(m_cfi.GetSizeInBits(), 0);
+         m_prefetchUsed[offsetIdx(f)] = 1;
+         m_stats.m_BlocksPrefetched++;
+         m_stats.m_PrefetchWasted++;
+      }
    }
 
 
@@ -924,14 +960,76 @@ void File::Prefetch()
    }
    else
    {
-      TRACEF(Dump, "File::Prefetch no free block found ");
+      // Without a pattern all blocks have been requested. With a pattern there
+      // is nothing predicted at the moment: the file is read randomly or the
+      // window is already covered. Wait for further reads to resume.
       m_downloadCond.Lock();
-      m_prefetchState = kComplete;
+      if (m_pattern.IsKnown() && ! m_cfi.IsComplete())
+      {
+         TRACEF(Dump, "File::Prefetch no predicted block, going idle");
+         if (m_prefetchState == kOn) m_prefetchState = kIdle;
+      }
+      else
+      {
+         TRACEF(Dump, "File::Prefetch no free block found ");
+         m_prefetchState = kComplete;
+      }
       m_downloadCond.UnLock();
       cache()->DeRegisterPrefetchFile(this);
    }
 }
 
+//------------------------------------------------------------------------------
+
+void File::ObserveAccess(int idx_first, int idx_last)
+{
+   // Method always called under lock
+
+   m_pattern.Observe(idx_first, idx_last);
+
+   // Count prefetched blocks on their first use.
+   if ( ! m_prefetchUsed.empty())
+   {
+      for (int i = idx_first; i <= idx_last; ++i)
+      {
+         int li = offsetIdx(i);
+         if (li >= 0 && li < (int) m_prefetchUsed.size() && m_prefetchUsed[li] == 1)
+         {
+            m_prefetchUsed[li] = 2;
+            m_stats.m_PrefetchHits++;
+            m_stats.m_PrefetchWasted--;
+         }
+      }
+   }
+
+   if (m_prefetchState == kIdle && NextPredictedBlock() >= 0)
+   {
+      TRACEF(Dump, "File::ObserveAccess resume prefetching");
+      m_prefetchState = kOn;
+      cache()->RegisterPrefetchFile(this);
+   }
+}
+
+//------------------------------------------------------------------------------
+
+int File::NextPredictedBlock()
+{
+   // Method always called under lock
+
+   const int window = m_pattern.Window(Cache::GetInstance().RefConfiguration().m_prefetch_max_blocks);
+
+   for (int n = 1; n <= window; ++n)
+   {
+      int f  = m_pattern.Predict(n);
+      int li = offsetIdx(f);
+      if (li < 0 || li >= m_cfi.GetSizeInBits())
+         break;
+      if ( ! m_cfi.TestBit(li) && m_block_map.find(f) == m_block_map.end())
+         return f;
+   }
+   return -1;
+}
+
 
 //------------------------------------------------------------------------------
 
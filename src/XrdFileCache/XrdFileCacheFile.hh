@@ -26,6 +26,7 @@
 
 #include "XrdFileCacheInfo.hh"
 #include "XrdFileCacheStats.hh"
+#include "XrdFileCacheAccessPattern.hh"
 
 #include <string>
 #include <map>
@@ -202,7 +203,7 @@ public:
    int dec_ref_cnt() { return --m_ref_cnt; }
 
 private:
-   enum PrefetchState_e { kOff=-1, kOn, kHold, kStopped, kComplete };
+   enum PrefetchState_e { kOff=-1, kOn, kHold, kStopped, kComplete, kIdle };
 
    int            m_ref_cnt;            //!< number of references from IO or sync
    
@@ -243,6 +244,9 @@ private:
    int   m_prefetchReadCnt;
    int   m_prefetchHitCnt;
    float m_prefetchScore;              //cached
+
+   AccessPattern      m_pattern;       //!< access pattern detector, drives prefetch
+   std::vector<char>  m_prefetchUsed;  //!< per block: 1 prefetched, 2 also read
    
    bool  m_detachTimeIsLogged;
 
@@ -281,6 +285,9 @@ private:
    long long BufferSize();
    void AppendIOStatToFileInfo();
 
+   void ObserveAccess(int idx_first, int idx_last);
+   int  NextPredictedBlock();
+
    void inc_ref_count(Block*);
    void dec_ref_count(Block*);
    void free_block(Block*);
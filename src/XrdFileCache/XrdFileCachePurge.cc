@@ -1,5 +1,6 @@
 #include "XrdFileCache.hh"
 #include "XrdFileCacheTrace.hh"
+#include "XrdFileCachePurgeIndex.hh"
 
 using namespace XrdFileCache;
 
@@ -23,10 +24,15 @@ public:
    typedef map_t::iterator map_i;
    map_t fmap;
    
-   FPurgeState(long long iNByteReq) : nByteReq(iNByteReq), nByteAccum(0) {}
+   FPurgeState(long long iNByteReq, PurgeIndex *iIndex = 0) :
+      nByteReq(iNByteReq), nByteAccum(0), index(iIndex) {}
 
    void checkFile (time_t iTime, const char* iPath,  long long iNByte)
    {
+      if (index) index->Add(iPath, iTime, iNByte);
+
+      if (nByteReq <= 0) return;
+
       if (nByteAccum < nByteReq || iTime < fmap.rbegin()->first)
       {
          fmap.insert(std::pair<const time_t, FS> (iTime, FS(iPath, iNByte)));
@@ -47,6 +53,7 @@ public:
 private:
    long long nByteReq;
    long long nByteAccum;
+   PurgeIndex *index;     // rebuilt from the scan when set
 };
 
 XrdSysTrace* GetTrace()
@@ -141,12 +148,54 @@ void FillFileMapRecurse( XrdOssDF* iOssDF, const std::string& path, FPurgeState&
    }
 }
 }
+
+//______________________________________________________________________________
+
+bool Cache::PurgeFile(const std::string& infoPath, long long nByte, long long& bytesToRemove)
+{
+   // Returns false if the file is in use and was skipped.
+
+   XrdOss* oss = Cache::GetInstance().GetOss();
+   std::string dataPath = infoPath.substr(0, infoPath.size() - strlen(XrdFileCache::Info::m_infoExtension));
+
+   if (HaveActiveFileWithLocalPath(dataPath))
+      return false;
+
+   struct stat fstat;
+
+   // remove info file
+   if (oss->Stat(infoPath.c_str(), &fstat) == XrdOssOK)
+   {
+      // cinfo file can be on another oss.space, do not subtract for now.
+      // bytesToRemove -= fstat.st_size;
+      oss->Unlink(infoPath.c_str());
+      TRACE(Info, "Cache::CacheDirCleanup() removed file:" <<  infoPath <<  " size: " << fstat.st_size);
+   }
+
+   // remove data file
+   if (oss->Stat(dataPath.c_str(), &fstat) == XrdOssOK)
+   {
+      bytesToRemove -= nByte;
+
+      oss->Unlink(dataPath.c_str());
+      TRACE(Info, "Cache::CacheDirCleanup() removed file: %s " << dataPath << " size " << nByte);
+   }
+
+   if (m_purgeIndex) m_purgeIndex->Remove(infoPath);
+
+   return true;
+}
+
+//______________________________________________________________________________
+
 void Cache::CacheDirCleanup()
 {
    XrdOucEnv env;
    XrdOss*      oss = Cache::GetInstance().GetOss();
    XrdOssVSInfo sP;
 
+   if (m_purgeIndex) m_purgeIndex->Load();
+
    while (1)
    {
       // get amount of space to erase
@@ -167,53 +216,60 @@ void Cache::CacheDirCleanup()
          }
       }
 
-      if (bytesToRemove > 0)
+      if (m_purgeIndex && m_purgeIndex->IsValid())
       {
-         // make a sorted map of file patch by access time
-         XrdOssDF* dh = oss->newDir(m_configuration.m_username.c_str());
-         if (dh->Opendir("", env) == XrdOssOK)
+         if (bytesToRemove > 0)
          {
-            FPurgeState purgeState(bytesToRemove * 5 / 4); // prepare 20% more volume than required
+            // take the least recently used files from the index
+            std::vector<PurgeIndex::Entry> victims;
+            m_purgeIndex->GetOldest(bytesToRemove * 5 / 4, victims); // prepare 20% more volume than required
 
-            FillFileMapRecurse(dh, "", purgeState);
+            TRACE(Debug, "Cache::CacheDirCleanup() index returned " << victims.size() << " purge candidates.");
 
-            // loop over map and remove files with highest value of access time
-            struct stat fstat;
-            for (FPurgeState::map_i it = purgeState.fmap.begin(); it != purgeState.fmap.end(); ++it)
+            for (std::vector<PurgeIndex::Entry>::iterator it = victims.begin(); it != victims.end(); ++it)
             {
+               PurgeFile(it->path, it->nByte, bytesToRemove);
 
-               std::string infoPath = it->second.path;
-               std::string dataPath = infoPath.substr(0, infoPath.size() - strlen(XrdFileCache::Info::m_infoExtension));
-
-               if (HaveActiveFileWithLocalPath(dataPath))
-                  continue;
+               if (bytesToRemove <= 0)
+                  break;
+            }
+         }
+      }
+      else if (bytesToRemove > 0 || m_purgeIndex)
+      {
+         // make a sorted map of file patch by access time, rebuilding the index on the way if needed
+         if (m_purgeIndex)
+         {
+            TRACE(Info, "Cache::CacheDirCleanup() rebuilding purge index from full scan.");
+            m_purgeIndex->Clear();
+         }
 
-               // remove info file
-               if (oss->Stat(infoPath.c_str(), &fstat) == XrdOssOK)
-               {
-                  // cinfo file can be on another oss.space, do not subtract for now.
-                  // bytesToRemove -= fstat.st_size;
-                  oss->Unlink(infoPath.c_str());
-                  TRACE(Info, "Cache::CacheDirCleanup() removed file:" <<  infoPath <<  " size: " << fstat.st_size);
-               }
+         XrdOssDF* dh = oss->newDir(m_configuration.m_username.c_str());
+         if (dh->Opendir("", env) == XrdOssOK)
+         {
+            FPurgeState purgeState(bytesToRemove * 5 / 4, m_purgeIndex); // prepare 20% more volume than required
 
-               // remove data file
-               if (oss->Stat(dataPath.c_str(), &fstat) == XrdOssOK)
-               {
-                  bytesToRemove -= it->second.nByte;
+            FillFileMapRecurse(dh, "", purgeState);
 
-                  oss->Unlink(dataPath.c_str());
-                  TRACE(Info, "Cache::CacheDirCleanup() removed file: %s " << dataPath << " size " << it->second.nByte);
-               }
+            if (m_purgeIndex)
+            {
+               m_purgeIndex->Compact(true);
+               m_purgeIndex->SetValid(true);
+               TRACE(Info, "Cache::CacheDirCleanup() purge index rebuilt with " << m_purgeIndex->Size() << " files.");
+            }
 
-               if (bytesToRemove <= 0)
-                  break;
+            // loop over map and remove files with highest value of access time
+            for (FPurgeState::map_i it = purgeState.fmap.begin(); it != purgeState.fmap.end() && bytesToRemove > 0; ++it)
+            {
+               PurgeFile(it->second.path, it->second.nByte, bytesToRemove);
             }
          }
          dh->Close();
          delete dh; dh = 0;
       }
 
+      if (m_purgeIndex) m_purgeIndex->Compact();
+
       sleep(m_configuration.m_purgeInterval);
    }
 }
@@ -0,0 +1,304 @@
+//----------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//----------------------------------------------------------------------------------
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "XrdSys/XrdSysTrace.hh"
+#include "XrdFileCachePurgeIndex.hh"
+#include "XrdFileCacheTrace.hh"
+
+using namespace XrdFileCache;
+
+// The journal is a text file with one record per line:
+//
+//    + <access-time> <bytes> <cinfo-path>
+//    - <cinfo-path>
+//
+// Records are only appended. A line that is not terminated by a new line is
+// the remainder of an interrupted write; it is cut off on load so that the
+// next record starts on a line of its own.
+
+namespace
+{
+const int    JournalLineMax = 4096 + 64;
+const size_t CompactSlack   = 16384;
+}
+
+const char *PurgeIndex::m_traceID = "PurgeIndex";
+
+//------------------------------------------------------------------------------
+
+PurgeIndex::PurgeIndex(XrdSysTrace *trace, const std::string &path) :
+   m_trace(trace),
+   m_path(path),
+   m_fd(-1),
+   m_nRecords(0),
+   m_valid(false)
+{}
+
+PurgeIndex::~PurgeIndex()
+{
+   if (m_fd >= 0) close(m_fd);
+}
+
+//------------------------------------------------------------------------------
+
+bool PurgeIndex::Load()
+{
+   XrdSysMutexHelper lock(&m_mutex);
+
+   m_files.clear();
+   m_lru.clear();
+   m_nRecords = 0;
+   m_valid    = false;
+
+   FILE *fp = fopen(m_path.c_str(), "r");
+   if ( ! fp)
+   {
+      TRACE(Info, "PurgeIndex::Load() no journal " << m_path << ", err " << strerror(errno)
+                                                   << "; full scan required.");
+      return false;
+   }
+
+   char      line[JournalLineMax];
+   long long goodEnd = 0;             // offset just past the last whole record
+   bool      torn    = false;
+   bool      ok      = true;
+   while (fgets(line, sizeof(line), fp))
+   {
+      size_t len = strlen(line);
+      if (len == 0 || line[len - 1] != '\n')
+      {
+         TRACE(Warning, "PurgeIndex::Load() ignoring truncated record in " << m_path);
+         torn = true;
+         break;
+      }
+      goodEnd += len;
+      line[len - 1] = 0;
+      ++m_nRecords;
+
+      if (line[0] == '+' && line[1] == ' ')
+      {
+         char *eP;
+         time_t atime = strtol(line + 2, &eP, 10);
+         if (*eP != ' ') { ok = false; break; }
+         long long nByte = strtoll(eP + 1, &eP, 10);
+         if (*eP != ' ' || ! eP[1]) { ok = false; break; }
+         insert(std::string(eP + 1), atime, nByte);
+      }
+      else if (line[0] == '-' && line[1] == ' ' && line[2])
+      {
+         erase(std::string(line + 2));
+      }
+      else
+      {
+         ok = false;
+         break;
+      }
+   }
+   fclose(fp);
+
+   if ( ! ok)
+   {
+      TRACE(Error, "PurgeIndex::Load() corrupted journal " << m_path << " at record "
+                                                           << m_nRecords << "; full scan required.");
+      m_files.clear();
+      m_lru.clear();
+      return false;
+   }
+
+   // Records are appended, so the partial one must go before anything else is
+   // written or the next record would be glued onto it.
+   if (torn && truncate(m_path.c_str(), goodEnd))
+   {
+      TRACE(Error, "PurgeIndex::Load() can't truncate " << m_path << ", err " << strerror(errno)
+                                                        << "; full scan required.");
+      m_files.clear();
+      m_lru.clear();
+      return false;
+   }
+
+   TRACE(Info, "PurgeIndex::Load() recovered " << m_files.size() << " files from "
+                                               << m_nRecords << " journal records.");
+   m_valid = openJournal();
+   return m_valid;
+}
+
+//------------------------------------------------------------------------------
+
+void PurgeIndex::Update(const std::string &cinfoPath, time_t accessTime, long long nByte)
+{
+   char buff[JournalLineMax];
+   int  blen = snprintf(buff, sizeof(buff), "+ %ld %lld %s\n",
+                        (long) accessTime, nByte, cinfoPath.c_str());
+   if (blen >= (int) sizeof(buff)) return;
+
+   XrdSysMutexHelper lock(&m_mutex);
+   insert(cinfoPath, accessTime, nByte);
+   append(buff, blen);
+}
+
+void PurgeIndex::Remove(const std::string &cinfoPath)
+{
+   char buff[JournalLineMax];
+   int  blen = snprintf(buff, sizeof(buff), "- %s\n", cinfoPath.c_str());
+   if (blen >= (int) sizeof(buff)) return;
+
+   XrdSysMutexHelper lock(&m_mutex);
+   if (erase(cinfoPath)) append(buff, blen);
+}
+
+void PurgeIndex::Clear()
+{
+   XrdSysMutexHelper lock(&m_mutex);
+   m_files.clear();
+   m_lru.clear();
+   m_valid = false;
+}
+
+//------------------------------------------------------------------------------
+
+void PurgeIndex::GetOldest(long long nByteReq, std::vector<Entry> &victims)
+{
+   XrdSysMutexHelper lock(&m_mutex);
+
+   long long nByteAccum = 0;
+   for (LruMap_i it = m_lru.begin(); it != m_lru.end() && nByteAccum < nByteReq; ++it)
+   {
+      FileMap_i fi = m_files.find(it->second);
+      Entry e;
+      e.path  = it->second;
+      e.nByte = fi->second.nByte;
+      victims.push_back(e);
+      nByteAccum += e.nByte;
+   }
+}
+
+//------------------------------------------------------------------------------
+
+void PurgeIndex::Compact(bool force)
+{
+   XrdSysMutexHelper lock(&m_mutex);
+
+   if ( ! force && m_fd >= 0 && m_nRecords < (long long) (2 * m_files.size() + CompactSlack))
+      return;
+
+   std::string tmpPath = m_path + ".tmp";
+   FILE *fp = fopen(tmpPath.c_str(), "w");
+   if ( ! fp)
+   {
+      TRACE(Error, "PurgeIndex::Compact() can't create " << tmpPath << ", err " << strerror(errno));
+      return;
+   }
+
+   bool ok = true;
+   for (LruMap_i it = m_lru.begin(); it != m_lru.end(); ++it)
+   {
+      FileMap_i fi = m_files.find(it->second);
+      if (fprintf(fp, "+ %ld %lld %s\n", (long) fi->second.atime, fi->second.nByte, it->second.c_str()) < 0)
+      {
+         ok = false;
+         break;
+      }
+   }
+   if (fflush(fp) || fsync(fileno(fp))) ok = false;
+   if (fclose(fp)) ok = false;
+
+   if ( ! ok || rename(tmpPath.c_str(), m_path.c_str()))
+   {
+      TRACE(Error, "PurgeIndex::Compact() can't write snapshot " << m_path << ", err " << strerror(errno));
+      unlink(tmpPath.c_str());
+      return;
+   }
+
+   if (m_fd >= 0) close(m_fd);
+   m_fd       = -1;
+   m_nRecords = m_files.size();
+   openJournal();
+
+   TRACE(Info, "PurgeIndex::Compact() wrote " << m_nRecords << " records to " << m_path);
+}
+
+//------------------------------------------------------------------------------
+// Private methods, called with m_mutex locked.
+//------------------------------------------------------------------------------
+
+void PurgeIndex::insert(const std::string &path, time_t atime, long long nByte)
+{
+   erase(path);
+
+   FInfo fin;
+   fin.atime = atime;
+   fin.nByte = nByte;
+   m_files[path] = fin;
+   m_lru.insert(std::make_pair(atime, path));
+}
+
+bool PurgeIndex::erase(const std::string &path)
+{
+   FileMap_i fi = m_files.find(path);
+   if (fi == m_files.end()) return false;
+
+   std::pair<LruMap_i, LruMap_i> ret = m_lru.equal_range(fi->second.atime);
+   for (LruMap_i it = ret.first; it != ret.second; ++it)
+   {
+      if (it->second == path)
+      {
+         m_lru.erase(it);
+         break;
+      }
+   }
+   m_files.erase(fi);
+   return true;
+}
+
+bool PurgeIndex::append(const char *buff, int blen)
+{
+   if (m_fd < 0) return false;
+
+   ssize_t ret;
+   do { ret = write(m_fd, buff, blen); } while (ret < 0 && errno == EINTR);
+
+   if (ret != blen)
+   {
+      // The journal no longer matches the index; the next compaction rewrites it.
+      TRACE(Error, "PurgeIndex::append() write to " << m_path << " failed, err "
+                                                    << (ret < 0 ? strerror(errno) : "short write"));
+      close(m_fd);
+      m_fd = -1;
+      return false;
+   }
+   ++m_nRecords;
+   return true;
+}
+
+bool PurgeIndex::openJournal()
+{
+   m_fd = open(m_path.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0600);
+   if (m_fd < 0)
+   {
+      TRACE(Error, "PurgeIndex::openJournal() can't open " << m_path << ", err " << strerror(errno));
+      return false;
+   }
+   fcntl(m_fd, F_SETFD, FD_CLOEXEC);
+   return true;
+}
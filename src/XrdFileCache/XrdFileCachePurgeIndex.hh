@@ -0,0 +1,154 @@
+#ifndef __XRDFILECACHE_PURGE_INDEX_HH__
+#define __XRDFILECACHE_PURGE_INDEX_HH__
+//----------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//----------------------------------------------------------------------------------
+
+#include <time.h>
+#include <string>
+#include <map>
+#include <vector>
+
+#include "XrdSys/XrdSysPthread.hh"
+
+class XrdSysTrace;
+
+namespace XrdFileCache
+{
+//----------------------------------------------------------------------------
+//! Persistent LRU index of cached files used by the purge thread.
+//!
+//! Every cinfo file known to the cache is kept in memory ordered by its last
+//! access time. Changes are appended to a journal on local disk so that the
+//! index survives restarts; the journal is periodically compacted into a
+//! snapshot. When the journal is missing or can not be parsed the index is
+//! marked as invalid and the purge falls back to a full scan of the cache
+//! directory, which is then used to rebuild the index.
+//----------------------------------------------------------------------------
+class PurgeIndex
+{
+public:
+   struct Entry
+   {
+      std::string path;          //!< path of cinfo file
+      long long   nByte;         //!< number of downloaded bytes
+   };
+
+   //------------------------------------------------------------------------
+   //! Constructor.
+   //!
+   //! @param trace  trace object of the cache
+   //! @param path   local path of the journal file
+   //------------------------------------------------------------------------
+   PurgeIndex(XrdSysTrace *trace, const std::string &path);
+
+   //------------------------------------------------------------------------
+   //! Destructor.
+   //------------------------------------------------------------------------
+   ~PurgeIndex();
+
+   //------------------------------------------------------------------------
+   //! Load the index from the journal.
+   //!
+   //! @return true if the index could be recovered from the journal
+   //------------------------------------------------------------------------
+   bool Load();
+
+   //------------------------------------------------------------------------
+   //! Add or update the entry for the given cinfo file.
+   //------------------------------------------------------------------------
+   void Update(const std::string &cinfoPath, time_t accessTime, long long nByte);
+
+   //------------------------------------------------------------------------
+   //! Add entry without journaling it, used while rebuilding the index from
+   //! a full scan. Compact(true) must be called after the scan.
+   //------------------------------------------------------------------------
+   void Add(const std::string &cinfoPath, time_t accessTime, long long nByte)
+   { XrdSysMutexHelper lock(&m_mutex); insert(cinfoPath, accessTime, nByte); }
+
+   //------------------------------------------------------------------------
+   //! Remove the entry for the given cinfo file.
+   //------------------------------------------------------------------------
+   void Remove(const std::string &cinfoPath);
+
+   //------------------------------------------------------------------------
+   //! \brief Get the least recently used files.
+   //!
+   //! Entries are returned oldest first until their cumulative size reaches
+   //! the requested number of bytes. Entries are not removed from the index.
+   //!
+   //! @param nByteReq   number of bytes to collect
+   //! @param victims    output list of candidates
+   //------------------------------------------------------------------------
+   void GetOldest(long long nByteReq, std::vector<Entry> &victims);
+
+   //------------------------------------------------------------------------
+   //! Drop all entries, used before a recovery rescan of the cache.
+   //------------------------------------------------------------------------
+   void Clear();
+
+   //------------------------------------------------------------------------
+   //! Rewrite the journal as a snapshot of the current content if it grew
+   //! too large, or unconditionally when force is set.
+   //------------------------------------------------------------------------
+   void Compact(bool force = false);
+
+   //------------------------------------------------------------------------
+   //! Mark index as valid or invalid. An invalid index requires a rescan.
+   //------------------------------------------------------------------------
+   void SetValid(bool v) { XrdSysMutexHelper lock(&m_mutex); m_valid = v; }
+   bool IsValid()        { XrdSysMutexHelper lock(&m_mutex); return m_valid; }
+
+   //------------------------------------------------------------------------
+   //! Number of files in the index.
+   //------------------------------------------------------------------------
+   size_t Size()         { XrdSysMutexHelper lock(&m_mutex); return m_files.size(); }
+
+   XrdSysTrace* GetTrace() const { return m_trace; }
+
+private:
+   struct FInfo
+   {
+      time_t    atime;
+      long long nByte;
+   };
+
+   typedef std::map<std::string, FInfo>            FileMap_t;
+   typedef FileMap_t::iterator                      FileMap_i;
+   typedef std::multimap<time_t, std::string>      LruMap_t;
+   typedef LruMap_t::iterator                       LruMap_i;
+
+   void insert(const std::string &path, time_t atime, long long nByte);
+   bool erase(const std::string &path);
+   bool append(const char *buff, int blen);
+   bool openJournal();
+
+   XrdSysTrace  *m_trace;
+   std::string   m_path;              //!< journal file name
+   int           m_fd;                //!< journal file descriptor, -1 if closed
+   long long     m_nRecords;          //!< number of records in the journal
+   bool          m_valid;             //!< index reflects content of the cache
+
+   FileMap_t     m_files;             //!< cinfo path -> access time and size
+   LruMap_t      m_lru;               //!< access time -> cinfo path
+
+   XrdSysMutex   m_mutex;
+
+   static const char *m_traceID;
+};
+}
+
+#endif
@@ -35,11 +35,15 @@ public:
    //----------------------------------------------------------------------
    Stats() {
       m_BytesDisk = m_BytesRam = m_BytesMissed = 0;
+      m_BlocksPrefetched = m_PrefetchHits = m_PrefetchWasted = 0;
    }
 
    long long m_BytesDisk;         //!< number of bytes served from disk cache
    long long m_BytesRam;          //!< number of bytes served from RAM cache
    long long m_BytesMissed;       //!< number of bytes served directly from XrdCl
+   long long m_BlocksPrefetched;  //!< number of blocks requested by prefetch
+   long long m_PrefetchHits;      //!< number of prefetched blocks later read
+   long long m_PrefetchWasted;    //!< number of prefetched blocks not (yet) read
 
    inline void AddStat(Stats &Src)
    {
@@ -49,6 +53,9 @@ public:
       m_BytesDisk += Src.m_BytesDisk;
       m_BytesRam += Src.m_BytesRam;
       m_BytesMissed += Src.m_BytesMissed;
+      m_BlocksPrefetched += Src.m_BlocksPrefetched;
+      m_PrefetchHits     += Src.m_PrefetchHits;
+      m_PrefetchWasted   += Src.m_PrefetchWasted;
 
       m_MutexXfc.UnLock();
    }
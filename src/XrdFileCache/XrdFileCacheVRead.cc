@@ -218,6 +218,8 @@ bool File::VReadPreProcess(const XrdOucIOVec *readV, int n,
       const int blck_idx_first =  readV[iov_idx].offset / m_cfi.GetBufferSize();
       const int blck_idx_last  = (readV[iov_idx].offset + readV[iov_idx].size - 1) / m_cfi.GetBufferSize();
 
+      ObserveAccess(blck_idx_first, blck_idx_last);
+
       for (int block_idx = blck_idx_first; block_idx <= blck_idx_last; ++block_idx)
       {
          TRACEF(Dump, "VReadPreProcess chunk "<<  readV[iov_idx].size << "@"<< readV[iov_idx].offset);
@@ -28,6 +28,7 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <stdlib.h>
 #include <string.h>
 #include <strings.h>
 #include <stdio.h>
@@ -41,6 +42,7 @@
 #include "XrdFrc/XrdFrcCID.hh"
 #include "XrdFrc/XrdFrcReqFile.hh"
 #include "XrdFrc/XrdFrcTrace.hh"
+#include "XrdSys/XrdSysAtomics.hh"
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysFD.hh"
 #include "XrdSys/XrdSysPlatform.hh"
@@ -67,6 +69,7 @@ XrdFrcReqFile::XrdFrcReqFile(const char *fn, int aVal)
    lokFN = strdup(buff);
    lokFD = reqFD = -1;
    isAgent = aVal;
+   wrSeq = synSeq = 0;
 }
   
 /******************************************************************************/
@@ -125,29 +128,46 @@ void XrdFrcReqFile::Add(XrdFrcRequest *rP)
 void XrdFrcReqFile::Can(XrdFrcRequest *rP)
 {
    rqMonitor rqMon(isAgent);
-   XrdFrcRequest tmpReq;
-   int Offs, numCan = 0, numBad = 0;
+   XrdFrcRequest *tmpReq;
+   int Offs, i, n, numCan = 0, numBad = 0;
    struct stat buf;
-   char txt[128];
+   char txt[128], *rBuff;
+
+// Get a buffer so that the file can be scanned a chunk at a time
+//
+   if (!(rBuff = (char *)malloc(ScanNum*ReqSize)))
+      {Say.Emsg("Can", ENOMEM, "scan", reqFN); FailCan(rP->ID, 0); return;}
 
 // Lock the file and get its size
 //
-   if (!FileLock() || fstat(reqFD, &buf)) {FailCan(rP->ID, 0); return;}
+   if (!FileLock() || fstat(reqFD, &buf))
+      {free(rBuff); FailCan(rP->ID, 0); return;}
 
 // Run through all of the file entries removing matching requests
 //
-   for (Offs = ReqSize; Offs < buf.st_size; Offs += ReqSize)
-       {if (!reqRead((void *)&tmpReq, Offs)) return FailCan(rP->ID);
-        if (!strcmp(tmpReq.ID, rP->ID))
-           {tmpReq.LFN[0] = '\0';
-            if (!reqWrite((void *)&tmpReq, Offs, 0)) numBad++;
-               else numCan++;
+   for (Offs = ReqSize; Offs < buf.st_size; Offs += n*ReqSize)
+       {if ((n = reqReadN(rBuff, ScanNum, Offs)) <= 0)
+           {if (!n) break;
+            free(rBuff);
+            return FailCan(rP->ID);
            }
+        for (i = 0; i < n; i++)
+            {tmpReq = (XrdFrcRequest *)(rBuff + i*ReqSize);
+             if (!strcmp(tmpReq->ID, rP->ID))
+                {tmpReq->LFN[0] = '\0';
+                 if (!reqWrite((void *)tmpReq, Offs+i*ReqSize, 0)) numBad++;
+                    else numCan++;
+                }
+            }
        }
+   free(rBuff);
 
 // Make sure this is written to disk
 //
-   if (numCan) fsync(reqFD);
+   if (numCan)
+      {if (isAgent) fsync(reqFD);
+          else AtomicInc(wrSeq);
+      }
 
 // Document the action
 //
@@ -217,10 +237,11 @@ int XrdFrcReqFile::Init()
 {
    EPNAME("Init");
    static const int Mode = S_IRUSR|S_IWUSR|S_IRGRP|S_IROTH;
-   XrdFrcRequest tmpReq;
+   XrdFrcRequest tmpReq, *rP;
    struct stat buf;
-   recEnt *RegList = 0, *First = 0, *rP, *pP, *tP;
-   int    Offs, rc, numreq = 0;
+   recKey *keyTab;
+   char   *rBuff = 0;
+   int    Offs, i, n, rc, numreq = 0;
 
 // Open the lock file first in r/w mode
 //
@@ -257,43 +278,43 @@ int XrdFrcReqFile::Init()
        return 1;
       }
 
-// Read the full file
-//
-   for (Offs = ReqSize; Offs < buf.st_size; Offs += ReqSize)
-       {if (!reqRead((void *)&tmpReq, Offs)) return FailIni("read file");
-        if (*tmpReq.LFN == '\0' || !tmpReq.addTOD
-        ||  tmpReq.Opaque >= int(sizeof(tmpReq.LFN))) continue;
-        pP = 0; rP = First; tP = new recEnt(tmpReq); numreq++;
-        if (tmpReq.Options & XrdFrcRequest::Register)
-           {tP->Next = RegList; RegList = tP;
-           } else {
-            while(rP && rP->reqData.addTOD < tmpReq.addTOD) {pP=rP;rP=rP->Next;}
-            if (pP) pP->Next = tP;
-               else First    = tP;
-            tP->Next = rP;
+// Read the full file a chunk at a time noting where each valid request is.
+// The requests are then ordered by sorting these keys: registration requests
+// in the order found followed by all others by the time they were added.
+//
+   if (!(keyTab = (recKey *)malloc(sizeof(recKey)*(buf.st_size/ReqSize)))
+   ||  !(rBuff  = (char   *)malloc(ScanNum*ReqSize)))
+      {if (keyTab) free(keyTab);
+       errno = ENOMEM;
+       return FailIni("scan file");
+      }
+
+   for (Offs = ReqSize; Offs < buf.st_size; Offs += n*ReqSize)
+       {if ((n = reqReadN(rBuff, ScanNum, Offs)) <= 0)
+           {if (!n) break;
+            free(keyTab); free(rBuff);
+            return FailIni("read file");
            }
+        for (i = 0; i < n; i++)
+            {rP = (XrdFrcRequest *)(rBuff + i*ReqSize);
+             if (*rP->LFN == '\0' || !rP->addTOD
+             ||  rP->Opaque >= int(sizeof(rP->LFN))) continue;
+             keyTab[numreq].addTOD = rP->addTOD;
+             keyTab[numreq].Offs   = Offs + i*ReqSize;
+             keyTab[numreq].Seq    = numreq;
+             keyTab[numreq].isReg  = (rP->Options & XrdFrcRequest::Register)!=0;
+             CID.Ref(rP->iName);
+             numreq++;
+            }
        }
-
-// Plase registration requests in the front
-//
-   while((rP = RegList))
-        {RegList = rP->Next;
-         rP->Next = First;
-         First = rP;
-        }
+   free(rBuff);
+   qsort(keyTab, numreq, sizeof(recKey), recCmp);
 
 // Now write out the file
 //
    DEBUG(numreq <<" request(s) recovered from " <<reqFN);
-   rc = ReWrite(First);
-
-// Delete all the entries in memory while referencing known instance names
-//
-   while((tP = First)) 
-        {First = tP->Next;
-         CID.Ref(tP->reqData.iName);
-         delete tP;
-        }
+   rc = ReWrite(keyTab, numreq);
+   free(keyTab);
 
 // All done
 //
@@ -492,6 +513,7 @@ int XrdFrcReqFile::FileLock(LockType lktype)
 {
    FLOCK_t lock_args;
    const char *What;
+   long long mySeq = 0;
    int rc;
 
 // Establish locking options
@@ -501,6 +523,7 @@ int XrdFrcReqFile::FileLock(LockType lktype)
    if (lktype == lkNone)
       {lock_args.l_type = F_UNLCK; What = "unlock";
        if (isAgent && reqFD >= 0) {close(reqFD); reqFD = -1;}
+       mySeq = AtomicGet(wrSeq);
       }
       else {lock_args.l_type = (lktype == lkShare ? F_RDLCK : F_WRLCK);
             What = "lock";
@@ -526,7 +549,10 @@ int XrdFrcReqFile::FileLock(LockType lktype)
        if (rc < 0) {Say.Emsg("reqRead",errno,"refresh hdr from", reqFN);
                     FileLock(lkNone); return 0;
                    }
-      } else if (lktype == lkNone) flMutex.UnLock();
+      } else if (lktype == lkNone)
+                {flMutex.UnLock();
+                 if (mySeq > synSeq) Sync(mySeq);
+                }
 
 // All done
 //
@@ -546,6 +572,22 @@ int XrdFrcReqFile::reqRead(void *Buff, int Offs)
    return 1;
 }
 
+/******************************************************************************/
+/*                              r e q R e a d N                               */
+/******************************************************************************/
+
+// Returns the number of whole records read, zero at end of file, or -1.
+  
+int XrdFrcReqFile::reqReadN(char *Buff, int rNum, int Offs)
+{
+   int rc;
+
+   do {rc = pread(reqFD, Buff, rNum*ReqSize, Offs);}
+      while(rc < 0 && errno == EINTR);
+   if (rc < 0) {Say.Emsg("reqRead",errno,"read",reqFN); return -1;}
+   return rc / ReqSize;
+}
+
 /******************************************************************************/
 /*                              r e q W r i t e                               */
 /******************************************************************************/
@@ -558,7 +600,10 @@ int XrdFrcReqFile::reqWrite(void *Buff, int Offs, int updthdr)
                               while(rc < 0 && errno == EINTR);
    if (rc >= 0 && updthdr){do {rc = pwrite(reqFD,&HdrData, sizeof(HdrData), 0);}
                               while(rc < 0 && errno == EINTR);
-                           if (rc >= 0) rc = fsync(reqFD);
+                           if (rc >= 0)
+                              {if (isAgent) rc = fsync(reqFD);
+                                  else AtomicInc(wrSeq);
+                              }
                           }
    if (rc < 0) {Say.Emsg("reqWrite",errno,"write", reqFN); return 0;}
    return 1;
@@ -568,46 +613,74 @@ int XrdFrcReqFile::reqWrite(void *Buff, int Offs, int updthdr)
 /*                               R e W r i t e                                */
 /******************************************************************************/
   
-int XrdFrcReqFile::ReWrite(XrdFrcReqFile::recEnt *rP)
+int XrdFrcReqFile::ReWrite(XrdFrcReqFile::recKey *kP, int kNum)
 {
    static const int Mode = S_IRUSR|S_IWUSR|S_IRGRP|S_IROTH;
-   char newFN[MAXPATHLEN], *oldFN;
-   int  newFD, oldFD, Offs = ReqSize, aOK = 1;
+   XrdFrcRequest *rP;
+   char newFN[MAXPATHLEN], *oldFN, *wBuff;
+   int  newFD, oldFD, i, j, k, n, rc, aOK = 1;
+
+// Get a buffer so that the new file can be written a chunk at a time
+//
+   if (!(wBuff = (char *)malloc(ScanNum*ReqSize)))
+      {Say.Emsg("ReWrite",ENOMEM,"rewrite",reqFN); FileLock(lkNone); return 0;}
 
 // Construct new file and open it
 //
    strcpy(newFN, reqFN); strcat(newFN, ".new");
    if ((newFD = XrdSysFD_Open(newFN, O_RDWR|O_CREAT|O_TRUNC, Mode)) < 0)
-      {Say.Emsg("ReWrite",errno,"open",newFN); FileLock(lkNone); return 0;}
+      {Say.Emsg("ReWrite",errno,"open",newFN); FileLock(lkNone);
+       free(wBuff);
+       return 0;
+      }
 
 // Setup to write/swap the file
 //
    oldFD = reqFD; reqFD = newFD;
    oldFN = reqFN; reqFN = newFN;
 
-// Rewrite all records if we have any
-//
-   if (rP)
-      {HdrData.First = Offs;
-       while(rP)
-            {rP->reqData.This = Offs;
-             rP->reqData.Next = (rP->Next ? Offs+ReqSize : 0);
-             if (!reqWrite((void *)&rP->reqData, Offs, 0)) {aOK = 0; break;}
-             Offs += ReqSize;
-             rP = rP->Next;
-            }
-       HdrData.Last = Offs - ReqSize;
+// Rewrite all records if we have any in key order. Record k of the new file
+// lives at offset (k+1)*ReqSize as the first slot holds the header.
+//
+   if (kNum)
+      {HdrData.First = ReqSize;
+       for (i = 0; i < kNum && aOK; i += n)
+           {n = (kNum-i < ScanNum ? kNum-i : ScanNum);
+            for (j = 0; j < n; j++)
+                {rP = (XrdFrcRequest *)(wBuff + j*ReqSize);
+                 do {rc = pread(oldFD, (void *)rP, ReqSize, kP[i+j].Offs);}
+                    while(rc < 0 && errno == EINTR);
+                 if (rc != ReqSize)
+                    {Say.Emsg("ReWrite",(rc < 0 ? errno : EIO),"read",oldFN);
+                     aOK = 0; break;
+                    }
+                 k = i+j+1;
+                 rP->This = k*ReqSize;
+                 rP->Next = (k < kNum ? (k+1)*ReqSize : 0);
+                }
+            if (!aOK) break;
+            do {rc = pwrite(newFD, wBuff, n*ReqSize, (i+1)*ReqSize);}
+               while(rc < 0 && errno == EINTR);
+            if (rc != n*ReqSize)
+               {Say.Emsg("ReWrite",(rc < 0 ? errno : EIO),"write",newFN);
+                aOK = 0;
+               }
+           }
+       HdrData.Last = kNum*ReqSize;
       } else {
        HdrData.First = HdrData.Last = 0;
        if (ftruncate(newFD, ReqSize) < 0)
           {Say.Emsg("ReWrite",errno,"trunc",newFN); aOK = 0;}
       }
+   free(wBuff);
 
-// Update the header
+// Update the header and make sure all of it is on disk before the rename
 //
    HdrData.Free = 0;
    if (aOK && !(aOK = reqWrite(0, 0)))
       Say.Emsg("ReWrite",errno,"write header",newFN);
+   if (aOK && fsync(newFD) < 0)
+      {Say.Emsg("ReWrite",errno,"sync",newFN); aOK = 0;}
 
 // If all went well, rename the file
 //
@@ -621,3 +694,39 @@ int XrdFrcReqFile::ReWrite(XrdFrcReqFile::recEnt *rP)
    reqFN = oldFN;
    return aOK;
 }
+
+/******************************************************************************/
+/*                                r e c C m p                                 */
+/******************************************************************************/
+
+int XrdFrcReqFile::recCmp(const void *k1, const void *k2)
+{
+   const recKey *kP1 = (const recKey *)k1, *kP2 = (const recKey *)k2;
+
+   if (kP1->isReg != kP2->isReg) return kP2->isReg - kP1->isReg;
+   if (!kP1->isReg && kP1->addTOD != kP2->addTOD)
+      return (kP1->addTOD < kP2->addTOD ? -1 : 1);
+   return kP1->Seq - kP2->Seq;
+}
+
+/******************************************************************************/
+/*                                  S y n c                                   */
+/******************************************************************************/
+
+// The daemon does not sync the file while it is locked. Instead, each updater
+// syncs after unlocking unless someone else's sync already covered its update.
+// So, concurrent updates share a sync and nobody waits for the disk while
+// holding the lock (agents sync in place as they close the file on unlock).
+//
+void XrdFrcReqFile::Sync(long long theSeq)
+{
+   long long upTo;
+
+   synMutex.Lock();
+   if (theSeq > synSeq)
+      {upTo = AtomicGet(wrSeq);
+       if (fsync(reqFD) < 0) Say.Emsg("Sync", errno, "sync", reqFN);
+          else synSeq = upTo;
+      }
+   synMutex.UnLock();
+}
@@ -60,6 +60,7 @@ private:
 enum LockType {lkNone, lkShare, lkExcl, lkInit};
 
 static const int ReqSize  = sizeof(XrdFrcRequest);
+static const int ScanNum  = 64;   // Records read at a time in a full scan
 
 void   FailAdd(char *lfn, int unlk=1);
 void   FailCan(char *rid, int unlk=1);
@@ -67,9 +68,12 @@ void   FailDel(char *lfn, int unlk=1);
 int    FailIni(const char *lfn);
 int    FileLock(LockType ltype=lkExcl);
 int    reqRead(void *Buff, int Offs);
+int    reqReadN(char *Buff, int rNum, int Offs);
 int    reqWrite(void *Buff, int Offs, int updthdr=1);
+void   Sync(long long theSeq);
 
 XrdSysMutex flMutex;
+XrdSysMutex synMutex;
 
 struct FileHdr
 {
@@ -85,11 +89,16 @@ char  *reqFN;
 
 int    isAgent;
 
-struct recEnt {recEnt       *Next;
-               XrdFrcRequest reqData;
-               recEnt(XrdFrcRequest &reqref) {Next = 0; reqData = reqref;}
+long long wrSeq;    // Updates written (daemon only)
+long long synSeq;   // Updates known to be on disk (daemon only)
+
+struct recKey {long long addTOD;
+               int       Offs;
+               int       Seq;
+               int       isReg;
               };
-int    ReWrite(recEnt *rP);
+static int recCmp(const void *k1, const void *k2);
+int    ReWrite(recKey *kP, int kNum);
 
 class rqMonitor
 {
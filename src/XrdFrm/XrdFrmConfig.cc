@@ -150,6 +150,7 @@ XrdFrmConfig::XrdFrmConfig(SubSys ss, const char *vopts, const char *uinfo)
    QPath    = 0;
    AdminMode= 0740;
    xfrMax   = 2;
+   scanThreads = 4;
    FailHold = 3*60*60;
    IdleHold = 10*60;
    WaitMigr = 60*60;
@@ -1007,6 +1008,7 @@ int XrdFrmConfig::ConfigXeq(char *var, int mbok)
    if (!strcmp(var, "all.pidpath"   )) return Grab(var, &PidPath, 0);
    if (!strcmp(var, "all.manager"   )) {haveCMS = 1; return 0;}
    if (!strcmp(var, "frm.all.cnsd"  )) return xcnsd();
+   if (!strcmp(var, "frm.all.scanthreads")) return xscan();
 
 // Process directives specific to each subsystem
 //
@@ -1943,6 +1945,31 @@ int XrdFrmConfig::xqchk()
    return 0;
 }
 
+/******************************************************************************/
+/* Private:                        x s c a n                                  */
+/******************************************************************************/
+
+/* Function: xscan
+
+   Purpose:  To parse the directive: scanthreads <num>
+
+             <num>     number of threads that index directories when walking
+                       the name space (e.g. purge scans and audits). A value
+                       of 1 walks it in a single thread. The default is 4.
+
+   Output: 0 upon success or !0 upon failure.
+*/
+int XrdFrmConfig::xscan()
+{   int nthr;
+    char *val;
+
+    if (!(val = cFile->GetWord()))
+       {Say.Emsg("Config", "scanthreads value not specified"); return 1;}
+    if (XrdOuca2x::a2i(Say, "scanthreads", val, &nthr, 1, 64)) return 1;
+    scanThreads = nthr;
+    return 0;
+}
+
 /******************************************************************************/
 /*                                  x s i t                                   */
 /******************************************************************************/
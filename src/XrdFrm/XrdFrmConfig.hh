@@ -97,6 +97,7 @@ int                 cmdHold;
 int                 AdminMode;
 int                 isAgent;
 int                 xfrMax;
+int                 scanThreads; // Threads walking the namespace
 int                 FailHold;
 int                 IdleHold;
 int                 WaitQChk;
@@ -206,6 +207,7 @@ int          xmon();
 int          xpol();
 int          xpolprog();
 int          xqchk();
+int          xscan();
 int          xsit();
 int          xspace(int isPrg=0, int isXA=1);
 void         xspaceBuild(char *grp, char *fn, int isxa);
@@ -316,6 +316,10 @@ XrdFrmFiles::XrdFrmFiles(const char *dname, int opts,
 // Set Call Back method
 //
    nsObj.setCallBack(cbP);
+
+// Index directories in parallel when walking the whole tree
+//
+   if (opts & Recursive) nsObj.setThreads(Config.scanThreads);
 }
 
 /******************************************************************************/
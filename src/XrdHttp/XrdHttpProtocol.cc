@@ -41,6 +41,7 @@
 #include "XrdHttpUtils.hh"
 #include "XrdHttpSecXtractor.hh"
 #include "XrdHttpExtHandler.hh"
+#include "XrdHttpTlsReuse.hh"
 
 #include <openssl/err.h>
 #include <openssl/ssl.h>
@@ -90,6 +91,8 @@ char *XrdHttpProtocol::gridmap = 0;
 XrdOucGMap *XrdHttpProtocol::servGMap = 0;  // Grid mapping service
 
 int XrdHttpProtocol::sslverifydepth = 9;
+int XrdHttpProtocol::tlsreusecache = XrdHttpTlsReuse::dfltCache;
+int XrdHttpProtocol::tlsreusetkt = XrdHttpTlsReuse::dfltTktLife;
 SSL_CTX *XrdHttpProtocol::sslctx = 0;
 BIO *XrdHttpProtocol::sslbio_err = 0;
 XrdCryptoFactory *XrdHttpProtocol::myCryptoFactory = 0;
@@ -690,6 +693,7 @@ int XrdHttpProtocol::Process(XrdLink *lp) // We ignore the argument here
 
 
       if (res != X509_V_OK) return -1;
+      XrdHttpTlsReuse::Count(ssl);
       ssldone = true;
     }
 
@@ -1009,7 +1013,19 @@ int XrdHttpProtocol::Stats(char *buff, int blen, int do_sync) {
   //  //
   //  return SI->Stats(buff, blen, do_sync);
 
-  return 0;
+  static const char statfmt[] = "<stats id=\"http\">";
+  static const char statend[] = "</stats>";
+  int n;
+
+  // If only size wanted, return it
+  //
+  if (!buff)
+    return sizeof(statfmt) + sizeof(statend) + XrdHttpTlsReuse::Stats(0, 0);
+
+  n = snprintf(buff, blen, "%s", statfmt);
+  if (n < blen) n += XrdHttpTlsReuse::Stats(buff + n, blen - n);
+  if (n < blen) n += snprintf(buff + n, blen - n, "%s", statend);
+  return (n < blen ? n : blen - 1);
 }
 
 
@@ -1095,6 +1111,7 @@ int XrdHttpProtocol::Config(const char *ConfigFN, XrdOucEnv *myEnv) {
       else if TS_Xeq("staticpreload", xstaticpreload);
       else if TS_Xeq("listingdeny", xlistdeny);
       else if TS_Xeq("header2cgi", xheader2cgi);
+      else if TS_Xeq("tlsreuse", xtlsreuse);
       else {
         eDest.Say("Config warning: ignoring unknown directive '", var, "'.");
         Config.Echo();
@@ -1682,9 +1699,11 @@ int XrdHttpProtocol::InitSecurity() {
 
   sslctx = SSL_CTX_new((SSL_METHOD *)meth);
   //SSL_CTX_set_min_proto_version(sslctx, TLS1_2_VERSION);
-  SSL_CTX_set_session_cache_mode(sslctx, SSL_SESS_CACHE_SERVER);
   SSL_CTX_set_session_id_context(sslctx, s_server_session_id_context,
           s_server_session_id_context_len);
+  if (!XrdHttpTlsReuse::Init(sslctx, Sched, &eDest, tlsreusecache,
+                             tlsreusetkt))
+    exit(1);
 
   /* An error write context */
   sslbio_err = BIO_new_fp(stderr, BIO_NOCLOSE);
@@ -1877,6 +1896,64 @@ int XrdHttpProtocol::xsslverifydepth(XrdOucStream & Config) {
   return 0;
 }
 
+/******************************************************************************/
+/*                                x t l s r e u s e                           */
+/******************************************************************************/
+
+/* Function: xtlsreuse
+
+   Purpose:  To parse the directive: tlsreuse off | [cache {<num> | off}]
+                                                    [tickets {<sec> | off}]
+
+             off       disables TLS session resumption altogether.
+             cache     the maximum number of sessions kept in the server side
+                       session cache, the default is 20480.
+             tickets   the number of seconds after which the session ticket
+                       key is replaced, the default is 3600. This is also
+                       the lifetime of a resumable session.
+
+  Output: 0 upon success or !0 upon failure.
+ */
+
+int XrdHttpProtocol::xtlsreuse(XrdOucStream & Config) {
+  char *val;
+  int *dest, num;
+
+  val = Config.GetWord();
+  if (!val || !val[0]) {
+    eDest.Emsg("Config", "tlsreuse argument not specified");
+    return 1;
+  }
+
+  if (!strcmp(val, "off")) {
+    tlsreusecache = tlsreusetkt = 0;
+    return 0;
+  }
+
+  while (val && val[0]) {
+         if (!strcmp(val, "cache"))   dest = &tlsreusecache;
+    else if (!strcmp(val, "tickets")) dest = &tlsreusetkt;
+    else {
+      eDest.Emsg("Config", "invalid tlsreuse option -", val);
+      return 1;
+    }
+
+    if (!(val = Config.GetWord()) || !val[0]) {
+      eDest.Emsg("Config", "tlsreuse value not specified");
+      return 1;
+    }
+    if (!strcmp(val, "off")) num = 0;
+    else if ((num = atoi(val)) <= 0) {
+      eDest.Emsg("Config", "invalid tlsreuse value -", val);
+      return 1;
+    }
+    *dest = num;
+    val = Config.GetWord();
+  }
+
+  return 0;
+}
+
 /******************************************************************************/
 /*                                 x s s l c e r t                            */
 /******************************************************************************/
@@ -175,6 +175,7 @@ private:
   static int xsslverifydepth(XrdOucStream &Config);
   static int xsecretkey(XrdOucStream &Config);
   static int xheader2cgi(XrdOucStream &Config);
+  static int xtlsreuse(XrdOucStream &Config);
   
   static XrdHttpSecXtractor *secxtractor;
   
@@ -344,6 +345,9 @@ protected:
   /// Depth of verification of a certificate chain
   static int sslverifydepth;
 
+  /// TLS session reuse: max cached sessions and ticket key lifetime (0 = off)
+  static int tlsreusecache, tlsreusetkt;
+
   /// True if the redirections must be towards https targets
   static bool isdesthttps;
   
@@ -192,6 +192,8 @@ int XrdHttpReq::parseLine(char *line, int len) {
 
     } else if (!strcmp(key, "Expect") && strstr(val, "100-continue")) {
       sendcontinue = true;
+    } else if (!strcmp(key, "Transfer-Encoding") && strstr(val, "chunked")) {
+      chunked = true;
     } else {
       // Some headers need to be translated into "local" cgi info. In theory they should already be quoted
       std::map< std:: string, std:: string > ::iterator it = prot->hdr2cgimap.find(key);
@@ -311,6 +313,46 @@ int XrdHttpReq::parseRWOp(char *str) {
   return j;
 }
 
+int XrdHttpReq::parseChunkHeader() {
+  // Returns:
+  // 1: the size of the next chunk is known or the body is complete
+  // 0: more data is needed
+  // -1: malformed chunk header
+  XrdOucString line;
+  int rc;
+
+  while ((rc = prot->BuffgetLine(line)) > 0) {
+    bool empty = (rc <= 2);
+
+    // After the last chunk there may be trailer lines, an empty one ends the body
+    if (chunktrailer) {
+      if (empty) {
+        chunkdone = true;
+        return 1;
+      }
+      continue;
+    }
+
+    // The data of every chunk is followed by a CRLF
+    if (empty) continue;
+
+    char *endp;
+    long long sz = strtoll(line.c_str(), &endp, 16);
+    if ((endp == line.c_str()) || (sz < 0)) return -1;
+
+    TRACE(REQ, "Chunk of " << sz << " bytes");
+    if (!sz) {
+      chunktrailer = true;
+      continue;
+    }
+
+    chunkleft = sz;
+    return 1;
+  }
+
+  return 0;
+}
+
 int XrdHttpReq::parseFirstLine(char *line, int len) {
 
   char *key = line;
@@ -433,26 +475,26 @@ void XrdHttpReq::clientUnMarshallReadAheadList(int nitems) {
 int XrdHttpReq::ReqReadV() {
 
 
-  kXR_int64 total_len = 0;
-  rwOpPartialDone = 0;
-  // Now we build the protocol-ready read ahead list
-  //  and also put the correct placeholders inside the cache
+  // Now we build the protocol-ready read ahead list for the next batch of
+  // segments. A long list of ranges is requested as a sequence of readv
+  // requests, each one streamed to the client as it arrives, so that we
+  // never exceed the readv limits of the xrootd layer
   int n = rwOps_split.size();
-  if (!ralist) ralist = (readahead_list *) malloc(n * sizeof (readahead_list));
+  if (!ralist) ralist = (readahead_list *) malloc(READV_MAXCHUNKS * sizeof (readahead_list));
 
   int j = 0;
-  for (int i = 0; i < n; i++) {
+  for (; (rwOpSplitDone < (unsigned int)n) && (j < READV_MAXCHUNKS); rwOpSplitDone++) {
+    ReadWriteOp &op = rwOps_split[rwOpSplitDone];
 
     // We can suppose that we know the length of the file
     // Hence we can sort out requests that are out of boundary or trim them
-    if (rwOps_split[i].bytestart > filesize) continue;
-    if (rwOps_split[i].byteend > filesize - 1) rwOps_split[i].byteend = filesize - 1;
+    if (op.bytestart > filesize) continue;
+    if (op.byteend > filesize - 1) op.byteend = filesize - 1;
 
     memcpy(&(ralist[j].fhandle), this->fhandle, 4);
 
-    ralist[j].offset = rwOps_split[i].bytestart;
-    ralist[j].rlen = rwOps_split[i].byteend - rwOps_split[i].bytestart + 1;
-    total_len += ralist[j].rlen;
+    ralist[j].offset = op.bytestart;
+    ralist[j].rlen = op.byteend - op.bytestart + 1;
     j++;
   }
 
@@ -984,10 +1026,13 @@ int XrdHttpReq::ProcessHTTPReq() {
         default: // Read() or Close()
         {
 
-          if ( ((reqstate == 3) && (rwOps.size() > 1)) ||
-            (writtenbytes >= length) ) {
+          // For a multi-range request prepare the next readv, if any is left
+          if (rwOps.size() > 1) l = ReqReadV();
 
-            // Close() if this was a readv or we have finished, otherwise read the next chunk
+          if ( ((rwOps.size() > 1) && !l) ||
+            ((rwOps.size() <= 1) && (writtenbytes >= length)) ) {
+
+            // Close() if all the ranges were sent or we have finished, otherwise read the next chunk
 
             // --------- CLOSE
 
@@ -1017,13 +1062,16 @@ int XrdHttpReq::ProcessHTTPReq() {
             memcpy(xrdreq.read.fhandle, fhandle, 4);
             xrdreq.read.dlen = 0;
             
+            // Large chunks keep the number of trips through the bridge low. The
+            // xrootd layer either sends the whole chunk with a single sendfile()
+            // or, under TLS, streams it back to us one buffer at a time.
             if (rwOps.size() == 0) {
-              l = (long)min(filesize-writtenbytes, (long long)1024*1024);
+              l = (long)min(filesize-writtenbytes, (long long)READ_MAXCHUNKSIZE);
               offs = writtenbytes;
               xrdreq.read.offset = htonll(writtenbytes);
               xrdreq.read.rlen = htonl(l);
             } else {
-              l = min(rwOps[0].byteend - rwOps[0].bytestart + 1 - writtenbytes, (long long)1024*1024);
+              l = min(rwOps[0].byteend - rwOps[0].bytestart + 1 - writtenbytes, (long long)READ_MAXCHUNKSIZE);
               offs = rwOps[0].bytestart + writtenbytes;
               xrdreq.read.offset = htonll(offs);
               xrdreq.read.rlen = htonl(l);
@@ -1062,11 +1110,9 @@ int XrdHttpReq::ProcessHTTPReq() {
               return -1;
             }
           } else {
-            // More than one chunk to read... use readv
-
-            length = ReqReadV();
+            // More than one chunk to read... use readv, the list is ready
 
-            if (!prot->Bridge->Run((char *) &xrdreq, (char *) ralist, length)) {
+            if (!prot->Bridge->Run((char *) &xrdreq, (char *) ralist, l)) {
               prot->SendSimpleResp(404, NULL, NULL, (char *) "Could not run read request.", 0);
               return -1;
             }
@@ -1114,9 +1160,44 @@ int XrdHttpReq::ProcessHTTPReq() {
 
       } else {
 
+        // With a chunked body we first need the size of the next chunk
+        if (chunked && !chunkleft && !chunkdone) {
+          int rc = parseChunkHeader();
+          if (rc < 0) {
+            prot->SendSimpleResp(400, NULL, NULL, (char *) "Malformed chunked encoding.", 0);
+            return -1;
+          }
+          if (rc == 0) {
+            // Wait for the rest of the chunk header
+            prot->ResumeBytes = 0;
+            return 1;
+          }
+        }
+
         // Check if we have finished
-        if (writtenbytes < length) {
+        if (chunked ? !chunkdone : (writtenbytes < length)) {
+          long long left = (chunked ? chunkleft : length - writtenbytes);
+          int avail = prot->BuffUsed();
+          int contig = (prot->myBuffEnd >= prot->myBuffStart ? avail :
+                        prot->myBuff->buff + prot->myBuff->bsize - prot->myBuffStart);
+          int l;
+
+          // We write what we have in the buffer that belongs to this body. When
+          // all of the buffered data is ours and there is no TLS, the write can
+          // span the data still on the wire: the xrootd layer then reads it
+          // straight from the socket into its own buffers as the disk takes it,
+          // saving a trip through the bridge for each buffer full.
+          writebufbytes = (int) min((long long) contig, left);
+          if (!prot->ishttps && (contig == avail) && (avail <= left))
+            l = (int) min(left, (long long) WRITE_MAXCHUNKSIZE);
+          else
+            l = writebufbytes;
 
+          if (!l) {
+            // Nothing to write yet, wait for the data
+            prot->ResumeBytes = min(left, (long long) prot->BuffAvailable());
+            return 1;
+          }
 
           // --------- WRITE
           memset(&xrdreq, 0, sizeof (xrdreq));
@@ -1125,15 +1206,15 @@ int XrdHttpReq::ProcessHTTPReq() {
 
 
           xrdreq.write.offset = htonll(writtenbytes);
-          xrdreq.write.dlen = htonl(prot->BuffUsed());
+          xrdreq.write.dlen = htonl(l);
 
-          TRACEI(REQ, "Writing " << prot->BuffUsed());
-          if (!prot->Bridge->Run((char *) &xrdreq, prot->myBuffStart, prot->BuffUsed())) {
+          TRACEI(REQ, "Writing " << l << " buffered " << writebufbytes);
+          if (!prot->Bridge->Run((char *) &xrdreq, prot->myBuffStart, writebufbytes)) {
             prot->SendSimpleResp(404, NULL, NULL, (char *) "Could not run write request.", 0);
             return -1;
           }
 
-          if (writtenbytes + prot->BuffUsed() >= length)
+          if ((l >= left) || (l > writebufbytes) || (avail > writebufbytes))
             // Trigger an immediate recall after this request has finished
             return 0;
           else
@@ -1800,9 +1881,6 @@ int XrdHttpReq::PostProcessHTTPReq(bool final_) {
             // Nothing to do if we are postprocessing a close
             if (ntohs(xrdreq.header.requestid) == kXR_close) return 1;
             
-            // Close() if this was the third state of a readv, otherwise read the next chunk
-            if ((reqstate == 3) && (ntohs(xrdreq.header.requestid) == kXR_readv)) return 1;
-
             // If we are here it's too late to send a proper error message...
             if (xrdresp == kXR_error) return -1;
 
@@ -1813,6 +1891,8 @@ int XrdHttpReq::PostProcessHTTPReq(bool final_) {
               char *p;
               int len;
 
+              bool wasdone = (rwOpDone == rwOps.size());
+
               // Cycle on all the data that is coming from the server
               for (int i = 0; i < iovN; i++) {
 
@@ -1849,7 +1929,7 @@ int XrdHttpReq::PostProcessHTTPReq(bool final_) {
                 }
               }
 
-              if (rwOpDone == rwOps.size()) {
+              if (!wasdone && (rwOpDone == rwOps.size())) {
                 string s = buildPartialHdrEnd((char *) "123456");
                 if (prot->SendData((char *) s.c_str(), s.size())) return -1;
               }
@@ -1908,12 +1988,15 @@ int XrdHttpReq::PostProcessHTTPReq(bool final_) {
         if (ntohs(xrdreq.header.requestid) == kXR_write) {
           int l = ntohl(xrdreq.write.dlen);
 
-          // Consume the written bytes
-          prot->BuffConsume(ntohl(xrdreq.write.dlen));
+          // Consume the written bytes, the rest came from the socket
+          prot->BuffConsume(writebufbytes);
+          writebufbytes = 0;
           writtenbytes += l;
+          if (chunked) chunkleft -= l;
 
           // We try to completely fill up our buffer before flushing
-          prot->ResumeBytes = min(length - writtenbytes, (long long) prot->BuffAvailable());
+          prot->ResumeBytes = min((chunked ? chunkleft : length - writtenbytes),
+                                  (long long) prot->BuffAvailable());
 
           return 0;
         }
@@ -2253,7 +2336,13 @@ void XrdHttpReq::reset() {
   rwOps_split.clear();
   rwOpDone = 0;
   rwOpPartialDone = 0;
+  rwOpSplitDone = 0;
   writtenbytes = 0;
+  writebufbytes = 0;
+  chunked = false;
+  chunkleft = 0;
+  chunktrailer = false;
+  chunkdone = false;
   etext.clear();
   redirdest = "";
 
@@ -55,6 +55,8 @@
 
 #define READV_MAXCHUNKS            512
 #define READV_MAXCHUNKSIZE         (1024*128)
+#define READ_MAXCHUNKSIZE          (1024*1024*8)
+#define WRITE_MAXCHUNKSIZE         (1024*1024*64)
 
 struct ReadWriteOp {
   // < 0 means "not specified"
@@ -105,8 +107,13 @@ public:
     ralist = 0;
     opaque = 0;
     writtenbytes = 0;
+    writebufbytes = 0;
     fopened = false;
     headerok = false;
+    chunked = false;
+    chunkleft = 0;
+    chunktrailer = false;
+    chunkdone = false;
   };
 
   virtual ~XrdHttpReq();
@@ -122,7 +129,11 @@ public:
   /// Parse the body of a request, assuming that it's XML and that it's entirely in memory
   int parseBody(char *body, long long len);
 
-  /// Prepare the buffers for sending a readv request
+  /// Parse the size line of the next chunk of a chunked upload
+  int parseChunkHeader();
+
+  /// Prepare the buffers for sending the next readv request of a multi-range
+  /// GET, at most READV_MAXCHUNKS segments at a time
   int ReqReadV();
   readahead_list *ralist;
 
@@ -191,6 +202,15 @@ public:
   int depth;
   bool sendcontinue;
 
+  /// The body of the request comes with chunked transfer encoding
+  bool chunked;
+  /// Bytes of the current chunk still to be written, zero if we need a header
+  long long chunkleft;
+  /// The last chunk was seen and we are skipping the trailer
+  bool chunktrailer;
+  /// The whole chunked body has been received
+  bool chunkdone;
+
   /// The host field specified in the req
   std::string host;
   /// The destination field specified in the req
@@ -206,6 +226,8 @@ public:
 
   /// To coordinate multipart responses across multiple calls
   unsigned int rwOpDone, rwOpPartialDone;
+  /// The next entry of rwOps_split to be requested via readv
+  unsigned int rwOpSplitDone;
 
   /// The last issued xrd request, often pending
   ClientRequest xrdreq;
@@ -237,6 +259,8 @@ public:
 
   /// In a long write, we track where we have arrived
   long long writtenbytes;
+  /// How many bytes of the pending write came from our buffer
+  int writebufbytes;
 
 
 
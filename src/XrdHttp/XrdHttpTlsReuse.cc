@@ -0,0 +1,373 @@
+//------------------------------------------------------------------------------
+// This file is part of XrdHTTP: A pragmatic implementation of the
+// HTTP/WebDAV protocol for the Xrootd framework
+//------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+
+
+
+
+/** @file  XrdHttpTlsReuse.cc
+ * @brief  TLS session resumption for XrdHTTP
+ *
+ */
+
+
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/rand.h>
+#include <openssl/ssl.h>
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include <openssl/core_names.h>
+#endif
+
+#include <list>
+#include <map>
+#include <string>
+
+#include "Xrd/XrdJob.hh"
+#include "Xrd/XrdScheduler.hh"
+#include "XrdSys/XrdSysAtomics.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysPthread.hh"
+#include "XrdHttpTlsReuse.hh"
+
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+typedef unsigned char XrdHttpSessId_t;
+#else
+typedef const unsigned char XrdHttpSessId_t;
+#endif
+
+namespace
+{
+//------------------------------------------------------------------------------
+// The session cache. Each shard is locked on its own and evicts its oldest
+// entries once it holds its share of the configured maximum.
+//------------------------------------------------------------------------------
+
+struct SessEntry
+{
+  std::string                      der;      // i2d form of the session
+  time_t                           expires;
+  std::list<std::string>::iterator age;
+};
+
+struct SessShard
+{
+  XrdSysMutex                      mtx;
+  std::map<std::string, SessEntry> sMap;
+  std::list<std::string>           sAge;     // oldest first
+  long long                        hits;
+  long long                        miss;
+  char                             pad[64];  // Keep shards on own lines
+
+  SessShard() : hits(0), miss(0) {}
+};
+
+const int   nShards = 16;                    // Must be a power of two
+SessShard   Shard[nShards];
+size_t      shardMax = 0;
+
+// Counters for handshakes; updated with atomics where available
+//
+XrdSysMutex cntMutex;
+long long   numFull    = 0;
+long long   numResumed = 0;
+int         numRotated = 0;
+
+inline SessShard &ShardOf(const unsigned char *id, unsigned int idlen)
+{
+  unsigned int h = 2166136261U;
+  for (unsigned int i = 0; i < idlen; i++) h = (h ^ id[i]) * 16777619U;
+  return Shard[h & (nShards-1)];
+}
+
+int NewSess(SSL *ssl, SSL_SESSION *sess)
+{
+  unsigned int idlen;
+  const unsigned char *id = SSL_SESSION_get_id(sess, &idlen);
+  int dlen = i2d_SSL_SESSION(sess, 0);
+  if (!idlen || dlen <= 0) return 0;
+
+  std::string der(dlen, '\0');
+  unsigned char *dp = (unsigned char *)&der[0];
+  i2d_SSL_SESSION(sess, &dp);
+
+  std::string key((const char *)id, idlen);
+  SessShard &sp = ShardOf(id, idlen);
+  XrdSysMutexHelper mh(sp.mtx);
+
+  std::map<std::string, SessEntry>::iterator it = sp.sMap.find(key);
+  if (it != sp.sMap.end())
+    {sp.sAge.erase(it->second.age);
+     sp.sMap.erase(it);
+    }
+  while (sp.sMap.size() >= shardMax && !sp.sAge.empty())
+    {sp.sMap.erase(sp.sAge.front());
+     sp.sAge.pop_front();
+    }
+
+  SessEntry &ep = sp.sMap[key];
+  ep.der.swap(der);
+  ep.expires = SSL_SESSION_get_time(sess) + SSL_SESSION_get_timeout(sess);
+  ep.age = sp.sAge.insert(sp.sAge.end(), key);
+
+  // We copied the session, so OpenSSL keeps its reference
+  //
+  return 0;
+}
+
+SSL_SESSION *GetSess(SSL *ssl, XrdHttpSessId_t *id, int idlen, int *copy)
+{
+  SessShard &sp = ShardOf(id, idlen);
+  SSL_SESSION *sess = 0;
+  std::string key((const char *)id, idlen);
+
+  *copy = 0;
+  sp.mtx.Lock();
+  std::map<std::string, SessEntry>::iterator it = sp.sMap.find(key);
+  if (it != sp.sMap.end())
+    {if (it->second.expires < time(0))
+        {sp.sAge.erase(it->second.age);
+         sp.sMap.erase(it);
+        } else {
+         const unsigned char *dp = (const unsigned char *)it->second.der.data();
+         sess = d2i_SSL_SESSION(0, &dp, it->second.der.size());
+        }
+    }
+  if (sess) sp.hits++;
+     else   sp.miss++;
+  sp.mtx.UnLock();
+  return sess;
+}
+
+void DelSess(SSL_CTX *ctx, SSL_SESSION *sess)
+{
+  unsigned int idlen;
+  const unsigned char *id = SSL_SESSION_get_id(sess, &idlen);
+  SessShard &sp = ShardOf(id, idlen);
+  XrdSysMutexHelper mh(sp.mtx);
+
+  std::map<std::string, SessEntry>::iterator it =
+      sp.sMap.find(std::string((const char *)id, idlen));
+  if (it != sp.sMap.end())
+    {sp.sAge.erase(it->second.age);
+     sp.sMap.erase(it);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Session ticket keys. The current key encrypts new tickets, the previous one
+// is still accepted so that tickets issued just before a rotation stay valid.
+//------------------------------------------------------------------------------
+
+struct TktKey
+{
+  unsigned char name[16];
+  unsigned char aes[32];
+  unsigned char mac[32];
+  bool          valid;
+};
+
+XrdSysRWLock tktLock;
+TktKey       tktCur;
+TktKey       tktPrev;
+
+bool NewKey(TktKey &key)
+{
+  if (RAND_bytes(key.name, sizeof(key.name)) != 1
+  ||  RAND_bytes(key.aes,  sizeof(key.aes))  != 1
+  ||  RAND_bytes(key.mac,  sizeof(key.mac))  != 1) return false;
+  key.valid = true;
+  return true;
+}
+
+bool Rotate()
+{
+  TktKey key;
+
+  if (!NewKey(key)) return false;
+  tktLock.WriteLock();
+  tktPrev = tktCur;
+  tktCur  = key;
+  tktLock.UnLock();
+  OPENSSL_cleanse(&key, sizeof(key));
+  AtomicBeg(cntMutex);
+  AtomicInc(numRotated);
+  AtomicEnd(cntMutex);
+  return true;
+}
+
+class TktRotator : public XrdJob
+{
+public:
+
+void DoIt() {Rotate(); Sched->Schedule((XrdJob *)this, time(0)+Life);}
+
+     TktRotator(XrdScheduler *sp, int life)
+               : XrdJob("http ticket key rotation"), Sched(sp), Life(life) {}
+
+private:
+XrdScheduler *Sched;
+int           Life;
+};
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+typedef EVP_MAC_CTX XrdHttpMacCtx_t;
+
+inline int SetMac(EVP_MAC_CTX *hctx, unsigned char *mac, size_t mlen)
+{
+  OSSL_PARAM parms[3];
+  parms[0] = OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY, mac, mlen);
+  parms[1] = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST,
+                                              (char *)"SHA256", 0);
+  parms[2] = OSSL_PARAM_construct_end();
+  return EVP_MAC_CTX_set_params(hctx, parms);
+}
+#else
+typedef HMAC_CTX XrdHttpMacCtx_t;
+
+inline int SetMac(HMAC_CTX *hctx, unsigned char *mac, size_t mlen)
+{
+  return HMAC_Init_ex(hctx, mac, mlen, EVP_sha256(), 0);
+}
+#endif
+
+// Returns -1 on error, 0 if the ticket key is unknown (full handshake), 1 if
+// the ticket is good and 2 if it is good but should be replaced by a new one.
+//
+int TktCB(SSL *ssl, unsigned char *name, unsigned char *iv,
+          EVP_CIPHER_CTX *cctx, XrdHttpMacCtx_t *hctx, int enc)
+{
+  int rc = -1;
+
+  tktLock.ReadLock();
+  if (enc)
+    {if (RAND_bytes(iv, EVP_CIPHER_iv_length(EVP_aes_256_cbc())) == 1
+     &&  EVP_EncryptInit_ex(cctx, EVP_aes_256_cbc(), 0, tktCur.aes, iv)
+     &&  SetMac(hctx, tktCur.mac, sizeof(tktCur.mac)))
+        {memcpy(name, tktCur.name, sizeof(tktCur.name));
+         rc = 1;
+        }
+    } else {
+     TktKey *kp = 0;
+     if (!memcmp(name, tktCur.name, sizeof(tktCur.name))) kp = &tktCur;
+        else if (tktPrev.valid
+             &&  !memcmp(name, tktPrev.name, sizeof(tktPrev.name)))
+                kp = &tktPrev;
+     if (!kp) rc = 0;
+        else if (SetMac(hctx, kp->mac, sizeof(kp->mac))
+             &&  EVP_DecryptInit_ex(cctx, EVP_aes_256_cbc(), 0, kp->aes, iv))
+                rc = (kp == &tktCur ? 1 : 2);
+    }
+  tktLock.UnLock();
+  return rc;
+}
+}
+
+/******************************************************************************/
+/*                                  I n i t                                   */
+/******************************************************************************/
+
+bool XrdHttpTlsReuse::Init(SSL_CTX *ctx, XrdScheduler *sched,
+                           XrdSysError *eDest, int cacheMax, int tktLife)
+{
+  char buff[128];
+
+  SSL_CTX_set_timeout(ctx, (tktLife > 0 ? tktLife : dfltTktLife));
+
+  // Set up the sharded cache or turn session caching off altogether
+  //
+  if (cacheMax > 0)
+    {shardMax = (cacheMax + nShards - 1) / nShards;
+     SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_SERVER
+                                       | SSL_SESS_CACHE_NO_INTERNAL);
+     SSL_CTX_sess_set_new_cb(ctx, NewSess);
+     SSL_CTX_sess_set_get_cb(ctx, GetSess);
+     SSL_CTX_sess_set_remove_cb(ctx, DelSess);
+    } else SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_OFF);
+
+  // Set up ticket keys and have them replaced every tktLife seconds
+  //
+  if (tktLife > 0)
+    {tktPrev.valid = false;
+     if (!NewKey(tktCur))
+        {eDest->Emsg("Config", "Unable to generate TLS session ticket key.");
+         return false;
+        }
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+     SSL_CTX_set_tlsext_ticket_key_evp_cb(ctx, TktCB);
+#else
+     SSL_CTX_set_tlsext_ticket_key_cb(ctx, TktCB);
+#endif
+     sched->Schedule((XrdJob *)new TktRotator(sched, tktLife),
+                     time(0)+tktLife);
+    } else SSL_CTX_set_options(ctx, SSL_OP_NO_TICKET);
+
+  snprintf(buff, sizeof(buff), "TLS session reuse: cache %d, tickets %d",
+           cacheMax, tktLife);
+  eDest->Say("Config ", buff);
+  return true;
+}
+
+/******************************************************************************/
+/*                                 C o u n t                                  */
+/******************************************************************************/
+
+void XrdHttpTlsReuse::Count(SSL *ssl)
+{
+  AtomicBeg(cntMutex);
+  if (SSL_session_reused(ssl)) AtomicInc(numResumed);
+     else                      AtomicInc(numFull);
+  AtomicEnd(cntMutex);
+}
+
+/******************************************************************************/
+/*                                 S t a t s                                  */
+/******************************************************************************/
+
+int XrdHttpTlsReuse::Stats(char *buff, int blen)
+{
+  static const char statfmt[] = "<tls><full>%lld</full><resumed>%lld"
+         "</resumed><cache><hit>%lld</hit><miss>%lld</miss><num>%lld</num>"
+         "</cache><rotated>%d</rotated></tls>";
+  long long hits = 0, miss = 0, num = 0, full, resumed;
+  int rotated;
+
+// If only size wanted, return it (five long longs and an int at most)
+//
+  if (!buff) return sizeof(statfmt) + 5*20 + 11;
+
+  for (int i = 0; i < nShards; i++)
+      {Shard[i].mtx.Lock();
+       hits += Shard[i].hits;
+       miss += Shard[i].miss;
+       num  += Shard[i].sMap.size();
+       Shard[i].mtx.UnLock();
+      }
+
+  AtomicBeg(cntMutex);
+  full    = AtomicGet(numFull);
+  resumed = AtomicGet(numResumed);
+  rotated = AtomicGet(numRotated);
+  AtomicEnd(cntMutex);
+
+  return snprintf(buff, blen, statfmt, full, resumed, hits, miss, num,
+                  rotated);
+}
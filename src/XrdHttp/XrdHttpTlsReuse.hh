@@ -0,0 +1,73 @@
+//------------------------------------------------------------------------------
+// This file is part of XrdHTTP: A pragmatic implementation of the
+// HTTP/WebDAV protocol for the Xrootd framework
+//------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+
+
+
+
+/** @file  XrdHttpTlsReuse.hh
+ * @brief  TLS session resumption for XrdHTTP: a sharded server-side session
+ *         cache and session tickets protected by periodically rotated keys
+ *
+ */
+
+
+
+#ifndef XRDHTTPTLSREUSE_HH
+#define	XRDHTTPTLSREUSE_HH
+
+#include <openssl/ssl.h>
+
+class XrdScheduler;
+class XrdSysError;
+
+/// Sets up TLS session resumption on the server SSL context and keeps the
+/// counters reported through XrdHttpProtocol::Stats().
+///
+/// Sessions of clients that do not use tickets are kept in an external cache
+/// split into independently locked shards, selected by a hash of the session
+/// id, so that concurrent handshakes on different worker threads rarely meet
+/// on the same lock. Tickets are encrypted with a key that is replaced every
+/// ticket lifetime, which is also the session timeout. Tickets made with the
+/// previous key are still accepted and renewed, so a ticket issued just before
+/// a rotation stays usable for its whole lifetime.
+
+class XrdHttpTlsReuse {
+public:
+
+  /// Configure session reuse on ctx.
+  ///
+  /// @param cacheMax max number of cached sessions, 0 disables the cache
+  /// @param tktLife  seconds between ticket key rotations, 0 disables tickets
+  ///
+  /// @return true on success, false if the ticket keys could not be set up
+  static bool Init(SSL_CTX *ctx, XrdScheduler *sched, XrdSysError *eDest,
+                   int cacheMax, int tktLife);
+
+  /// Account for a completed server handshake
+  static void Count(SSL *ssl);
+
+  /// Put the statistics in xml form into buff. When buff is null return the
+  /// maximum length that may be needed.
+  static int Stats(char *buff, int blen);
+
+  /// Default values for the tlsreuse directive
+  static const int dfltCache = 20480;
+  static const int dfltTktLife = 3600;
+};
+
+#endif	/* XRDHTTPTLSREUSE_HH */
@@ -111,7 +111,62 @@ int XrdNetMsg::Send(const struct iovec iov[], int iovcnt,
 
    return Send(buff, (int)(bp-buff), dest, -1);
 }
-  
+
+/******************************************************************************/
+/*                             S e n d B a t c h                              */
+/******************************************************************************/
+
+int XrdNetMsg::SendBatch(const struct iovec msg[], int msgcnt)
+{
+   int retc, numSent = 0;
+
+   if (!destOK)
+      {eDest->Emsg("Msg", "Destination not specified."); return -1;}
+
+#ifdef HAVE_SENDMMSG
+   static const int mmMax = 64;
+   struct mmsghdr mmVec[mmMax];
+   int i, n;
+
+// Send the messages in groups of at most mmMax. The kernel may send fewer
+// messages than we asked for, in which case we simply retry with the rest.
+//
+   while(numSent < msgcnt)
+        {n = (msgcnt - numSent > mmMax ? mmMax : msgcnt - numSent);
+         memset(mmVec, 0, n*sizeof(struct mmsghdr));
+         for (i = 0; i < n; i++)
+             {mmVec[i].msg_hdr.msg_name    = (void *)dfltDest.SockAddr();
+              mmVec[i].msg_hdr.msg_namelen = dfltDest.SockSize();
+              mmVec[i].msg_hdr.msg_iov     = (struct iovec *)&msg[numSent+i];
+              mmVec[i].msg_hdr.msg_iovlen  = 1;
+             }
+         do {retc = sendmmsg(FD, mmVec, n, 0);}
+            while(retc < 0 && errno == EINTR);
+         if (retc <= 0) break;
+         numSent += retc;
+        }
+#else
+// Send the messages one at a time
+//
+   while(numSent < msgcnt)
+        {do {retc = sendto(FD, (Sokdata_t)msg[numSent].iov_base,
+                           msg[numSent].iov_len, 0,
+                           dfltDest.SockAddr(), dfltDest.SockSize());}
+            while(retc < 0 && errno == EINTR);
+         if (retc < 0) break;
+         numSent++;
+        }
+#endif
+
+// Report any error and return the number of messages sent
+//
+   if (numSent < msgcnt)
+      {retErr((retc < 0 ? errno : EAGAIN), &dfltDest);
+       if (!numSent) return -1;
+      }
+   return numSent;
+}
+
 /******************************************************************************/
 /*                       P r i v a t e   M e t h o d s                        */
 /******************************************************************************/
@@ -87,6 +87,21 @@ int           Send(const struct  iovec iov[], // Remaining parms as above
                          int     iovcnt,      // Number of elements in iovec
                    const char   *dest=0,      // Hostname to send UDP datagram
                          int     tmo=-1);     // Timeout in ms (-1 = none)
+
+//------------------------------------------------------------------------------
+//! Send several UDP messages to the default endpoint, using as few system
+//! calls as possible (i.e. sendmmsg() where available).
+//!
+//! @param  msg      The messages to send, one datagram per element.
+//! @param  msgcnt   The number of elements in msg.
+//! @return >=0      The number of messages sent. When less than msgcnt, the
+//!                  remaining messages were not sent due to an error.
+//! @return <0       No message could be sent due to an error.
+//------------------------------------------------------------------------------
+
+int           SendBatch(const struct iovec msg[], // One datagram per element
+                              int          msgcnt);
+
 //------------------------------------------------------------------------------
 //! Constructor
 //!
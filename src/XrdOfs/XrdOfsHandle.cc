@@ -168,11 +168,8 @@ extern XrdOfsStats OfsStats;
 /*                        S t a t i c   O b j e c t s                         */
 /******************************************************************************/
   
-XrdSysMutex   XrdOfsHandle::myMutex;
-XrdOfsHanTab  XrdOfsHandle::roTable;
-XrdOfsHanTab  XrdOfsHandle::rwTable;
-XrdOssDF     *XrdOfsHandle::ossDF = (XrdOssDF *)new XrdOfsHanOss;
-XrdOfsHandle *XrdOfsHandle::Free = 0;
+XrdOfsHanShard XrdOfsHandle::hanShard[XrdOfsHandle::hanShards];
+XrdOssDF      *XrdOfsHandle::ossDF = (XrdOssDF *)new XrdOfsHanOss;
 
 /******************************************************************************/
 /*                    c l a s s   X r d O f s H a n d l e                     */
@@ -183,34 +180,35 @@ XrdOfsHandle *XrdOfsHandle::Free = 0;
   
 int XrdOfsHandle::Alloc(const char *thePath, int Opts, XrdOfsHandle **Handle)
 {
-   XrdOfsHandle *hP;
-   XrdOfsHanTab *theTable = (Opts & opRW ? &rwTable : &roTable);
-   XrdOfsHanKey theKey(thePath, (int)strlen(thePath));
-   int          retc;
-
-// Lock the search table and try to find the key. If found, increment the
-// the link count (can only be done with the global lock) then release the
+   XrdOfsHandle   *hP;
+   XrdOfsHanKey    theKey(thePath, (int)strlen(thePath));
+   XrdOfsHanShard &hS = Shard(theKey.Hash);
+   XrdOfsHanTab   *theTable = (Opts & opRW ? &hS.rwTable : &hS.roTable);
+   int             retc;
+
+// Lock the shard holding the key and try to find the key. If found, increment
+// the link count (can only be done with the shard lock) then release the
 // lock and try to lock the handle. It can't escape between lock calls because
 // the link count is positive. If we can't lock the handle then it must be the
 // that a long running operation is occuring. Return the handle to its former
 // state and return a delay. Otherwise, return the handle.
 //
-   myMutex.Lock();
+   hS.hsMutex.Lock();
    if ((hP = theTable->Find(theKey)))
-      {hP->Path.Links++; myMutex.UnLock();
+      {hP->Path.Links++; hS.hsMutex.UnLock();
        if (hP->WaitLock()) {*Handle = hP; return 0;}
-       myMutex.Lock(); hP->Path.Links--; myMutex.UnLock();
+       hS.hsMutex.Lock(); hP->Path.Links--; hS.hsMutex.UnLock();
        return nolokDelay;
       }
 
 // Get a new handle
 //
-   if (!(retc = Alloc(theKey, Opts, Handle))) theTable->Add(*Handle);
-   OfsStats.Add(OfsStats.Data.numHandles);
+   if (!(retc = Alloc(hS, theKey, Opts, Handle))) theTable->Add(*Handle);
+   hS.hsMutex.UnLock();
 
 // All done
 //
-   myMutex.UnLock();
+   OfsStats.Add(OfsStats.Data.numHandles);
    return retc;
 }
 
@@ -221,12 +219,13 @@ int XrdOfsHandle::Alloc(const char *thePath, int Opts, XrdOfsHandle **Handle)
 int XrdOfsHandle::Alloc(XrdOfsHandle **Handle)
 {
     XrdOfsHanKey myKey("dummy", 5);
+    XrdOfsHanShard &hS = Shard(myKey.Hash);
     int retc;
 
-    myMutex.Lock();
-    if (!(retc = Alloc(myKey, 0, Handle))) 
+    hS.hsMutex.Lock();
+    if (!(retc = Alloc(hS, myKey, 0, Handle))) 
        {(*Handle)->Path.Links = 0; (*Handle)->UnLock();}
-    myMutex.UnLock();
+    hS.hsMutex.UnLock();
     return retc;
 }
 
@@ -234,16 +233,19 @@ int XrdOfsHandle::Alloc(XrdOfsHandle **Handle)
 /* private                      A l l o c   # 3                               */
 /******************************************************************************/
   
-int XrdOfsHandle::Alloc(XrdOfsHanKey theKey, int Opts, XrdOfsHandle **Handle)
+// The shard lock must be held upon entry!
+
+int XrdOfsHandle::Alloc(XrdOfsHanShard &hS, XrdOfsHanKey theKey, int Opts,
+                        XrdOfsHandle **Handle)
 {
    static const int minAlloc = 4096/sizeof(XrdOfsHandle);
    XrdOfsHandle *hP;
 
-// No handle currently in the table. Get a new one off the free list
+// No handle currently in the table. Get a new one off the shard's free list
 //
-   if (!Free && (hP = new XrdOfsHandle[minAlloc]))
-      {int i = minAlloc; while(i--) {hP->Next = Free; Free = hP; hP++;}}
-   if ((hP = Free)) Free = hP->Next;
+   if (!hS.Free && (hP = new XrdOfsHandle[minAlloc]))
+      {int i = minAlloc; while(i--) {hP->Next = hS.Free; hS.Free = hP; hP++;}}
+   if ((hP = hS.Free)) hS.Free = hP->Next;
 
 // Initialize the new handle, if we have one, and add it to the table
 //
@@ -271,14 +273,16 @@ void XrdOfsHandle::Hide(const char *thePath)
 {
    XrdOfsHandle *hP;
    XrdOfsHanKey theKey(thePath, (int)strlen(thePath));
+   XrdOfsHanShard &hS = Shard(theKey.Hash);
 
-// Lock the search table and try to find the key in each table. If found,
-// clear the length field to effectively hide the item.
+// Lock the shard and try to find the key in each table. If found, clear the
+// length field to effectively hide the item. The hash is left as is so that
+// the handle can still be located in its shard when it is retired.
 //
-   myMutex.Lock();
-   if ((hP = roTable.Find(theKey))) hP->Path.Len = 0;
-   if ((hP = rwTable.Find(theKey))) hP->Path.Len = 0;
-   myMutex.UnLock();
+   hS.hsMutex.Lock();
+   if ((hP = hS.roTable.Find(theKey))) hP->Path.Len = 0;
+   if ((hP = hS.rwTable.Find(theKey))) hP->Path.Len = 0;
+   hS.hsMutex.UnLock();
 }
 
 /******************************************************************************/
@@ -297,7 +301,10 @@ int XrdOfsHandle::PoscGet(short &Mode, int Done)
        Mode = Posc->Mode;
        if (Done)
           {pP = Posc; Posc = 0;
-           if (pP->xprP) {myMutex.Lock(); Path.Links--; myMutex.UnLock();}
+           if (pP->xprP)
+              {XrdOfsHanShard &hS = Shard(Path.Hash);
+               hS.hsMutex.Lock(); Path.Links--; hS.hsMutex.UnLock();
+              }
            pP->Recycle();
           }
        return pnum;
@@ -378,30 +385,31 @@ const char *XrdOfsHandle::PoscUsr()
 
 int XrdOfsHandle::Retire(int &retc, long long *retsz, char *buff, int blen)
 {
+   XrdOfsHanShard &hS = Shard(Path.Hash);
    XrdOssDF *mySSI;
    int numLeft;
 
-// Get the global lock as the links field can only be manipulated with it.
+// Get the shard lock as the links field can only be manipulated with it.
 // Decrement the links count and if zero, remove it from the table and
 // place it on the free list. Otherwise, it is still in use.
 //
    retc = 0;
-   myMutex.Lock();
+   hS.hsMutex.Lock();
    if (Path.Links == 1)
       {if (buff) strlcpy(buff, Path.Val, blen);
        numLeft = 0; OfsStats.Dec(OfsStats.Data.numHandles);
-       if ( (isRW ? rwTable.Remove(this) : roTable.Remove(this)) )
+       if ( (isRW ? hS.rwTable.Remove(this) : hS.roTable.Remove(this)) )
          {if (Posc) {Posc->Recycle(); Posc = 0;}
           if (Path.Val) {free((void *)Path.Val); Path.Val = (char *)"";}
           Path.Len = 0; mySSI = ssi; ssi = ossDF;
-          Next = Free; Free = this; UnLock(); myMutex.UnLock();
+          Next = hS.Free; hS.Free = this; UnLock(); hS.hsMutex.UnLock();
           if (mySSI && mySSI != ossDF)
              {retc = mySSI->Close(retsz); delete mySSI;}
          } else {
-          UnLock(); myMutex.UnLock();
+          UnLock(); hS.hsMutex.UnLock();
           OfsEroute.Emsg("Retire", "Lost handle to", buff);
         }
-      } else {numLeft = --Path.Links; UnLock(); myMutex.UnLock();}
+      } else {numLeft = --Path.Links; UnLock(); hS.hsMutex.UnLock();}
    return numLeft;
 }
 
@@ -410,20 +418,21 @@ int XrdOfsHandle::Retire(int &retc, long long *retsz, char *buff, int blen)
 int XrdOfsHandle::Retire(XrdOfsHanCB *cbP, int hTime)
 {
    static int allOK = StartXpr(1);
+   XrdOfsHanShard &hS = Shard(Path.Hash);
    XrdOfsHanXpr *xP;
    int retc;
 
 // The handle can only be held by one reference and only if it's a POSC and
 // defered handling was properly set up.
 //
-   myMutex.Lock();
+   hS.hsMutex.Lock();
    if (!Posc || !allOK)
       {OfsEroute.Emsg("Retire", "ignoring deferred retire of", Path.Val);
-       if (Path.Links != 1 || !Posc || !cbP) myMutex.UnLock();
-          else {myMutex.UnLock(); cbP->Retired(this);}
+       if (Path.Links != 1 || !Posc || !cbP) hS.hsMutex.UnLock();
+          else {hS.hsMutex.UnLock(); cbP->Retired(this);}
        return Retire(retc);
       }
-   myMutex.UnLock();
+   hS.hsMutex.UnLock();
 
 // If this object already has an xpr object (happens for bouncing connections)
 // then reuse that object. Otherwise create a new one and put it on the queue.
@@ -475,16 +484,18 @@ do{xP = XrdOfsHanXpr::Get(); hP = xP->Handle;
             hP->UnLock(); delete xP; continue;
            }
 
-// As the handle is locked we can get the global handle lock to prevent
-// additions and removals of handles as we need a stable reference count to
-// effect the callout, if any. Do so only if the reference count is one (for us)
-// and the handle is active. In all cases, drop the global lock.
+// As the handle is locked we can get the shard lock to prevent additions and
+// removals of the handle as we need a stable reference count to effect the
+// callout, if any. Do so only if the reference count is one (for us) and the
+// handle is active. In all cases, drop the shard lock.
 //
-   myMutex.Lock();
-   if (hP->Path.Links != 1 || !xP->Call) myMutex.UnLock();
-      else {myMutex.UnLock();
+  {XrdOfsHanShard &hS = Shard(hP->Path.Hash);
+   hS.hsMutex.Lock();
+   if (hP->Path.Links != 1 || !xP->Call) hS.hsMutex.UnLock();
+      else {hS.hsMutex.UnLock();
             xP->Call->Retired(hP);
            }
+  }
 
 // We can now officially retire the handle and delete the xpr object
 //
@@ -112,6 +112,29 @@ int              nashnum;
 int              Threshold;
 };
 
+/******************************************************************************/
+/*                  C l a s s   X r d O f s H a n S h a r d                   */
+/******************************************************************************/
+
+// Handles are spread over a number of shards by the hash of their path. Each
+// shard has its own lock, tables, and free list so that opens and closes of
+// unrelated files do not serialize on a single lock. The link count of a
+// handle may only be changed while holding the lock of the handle's shard.
+//
+class XrdOfsHanShard
+{
+public:
+
+XrdSysMutex   hsMutex;
+XrdOfsHanTab  roTable;    // File handles open r/o
+XrdOfsHanTab  rwTable;    // File Handles open r/w
+XrdOfsHandle *Free;       // List of free handles
+char          Pad[64];    // Keep shard locks in separate cache lines
+
+              XrdOfsHanShard() : roTable(55, 89), rwTable(55, 89), Free(0) {}
+             ~XrdOfsHanShard() {} // Never gets deleted
+};
+
 /******************************************************************************/
 /*                    C l a s s   X r d O f s H a n d l e                     */
 /******************************************************************************/
@@ -170,7 +193,8 @@ inline       void   UnLock() {hMutex.UnLock();}
          ~XrdOfsHandle() {int retc; Retire(retc);}
 
 private:
-static int           Alloc(XrdOfsHanKey, int Opts, XrdOfsHandle **Handle);
+static int           Alloc(XrdOfsHanShard &hS, XrdOfsHanKey, int Opts,
+                           XrdOfsHandle **Handle);
        int           WaitLock(void);
 
 static const int     LockTries =   3; // Times to try for a lock
@@ -178,11 +202,16 @@ static const int     LockWait  = 333; // Mills to wait between tries
 static const int     nolokDelay=   3; // Secs to delay client when lock failed
 static const int     nomemDelay=  15; // Secs to delay client when ENOMEM
 
-static XrdSysMutex   myMutex;
-static XrdOfsHanTab  roTable;    // File handles open r/o
-static XrdOfsHanTab  rwTable;    // File Handles open r/w
+static const int     hanShards = 32; // Number of shards (must be power of 2)
+
+static inline
+XrdOfsHanShard      &Shard(unsigned int hash)
+                          {return hanShard[(hash ^ (hash >> 16))
+                                           & (hanShards-1)];
+                          }
+
+static XrdOfsHanShard hanShard[hanShards];
 static XrdOssDF     *ossDF;      // Dummy storage sysem
-static XrdOfsHandle *Free;       // List of free handles
 
        XrdSysMutex   hMutex;
        XrdOssDF     *ssi;        // Storage System Interface
@@ -45,6 +45,7 @@
 
 #include "XrdOss/XrdOssApi.hh"
 #include "XrdOss/XrdOssTrace.hh"
+#include "XrdOss/XrdOssUring.hh"
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysPlatform.hh"
 #include "XrdSys/XrdSysPthread.hh"
@@ -71,6 +72,8 @@ extern XrdOucTrace OssTrace;
 
 extern XrdSysError OssEroute;
 
+extern XrdOssSys  *XrdOssSS;
+
 int   XrdOssFile::AioFailure = 0;
 
 #ifdef _POSIX_ASYNCHRONOUS_IO
@@ -96,6 +99,13 @@ const int OSS_AIO_WRITE_DONE = SIGRTMAX;
 int XrdOssFile::Fsync(XrdSfsAio *aiop)
 {
 
+// Use the io_uring if we have one
+//
+   if (XrdOssUring::Ring && fd >= 0 && !cxobj)
+      {aiop->TIdent = tident;
+       if (!XrdOssUring::Ring->Fsync(aiop, fd)) return 0;
+      }
+
 #ifdef _POSIX_ASYNCHRONOUS_IO
    int rc;
 
@@ -148,6 +158,13 @@ int XrdOssFile::Fsync(XrdSfsAio *aiop)
 int XrdOssFile::Read(XrdSfsAio *aiop)
 {
 
+// Use the io_uring if we have one (compressed files need to be decoded)
+//
+   if (XrdOssUring::Ring && fd >= 0 && !cxobj)
+      {aiop->TIdent = tident;
+       if (!XrdOssUring::Ring->Read(aiop, fd)) return 0;
+      }
+
 #ifdef _POSIX_ASYNCHRONOUS_IO
    EPNAME("AioRead");
    int rc;
@@ -205,6 +222,16 @@ int XrdOssFile::Read(XrdSfsAio *aiop)
   
 int XrdOssFile::Write(XrdSfsAio *aiop)
 {
+
+// Use the io_uring if we have one and the write would not exceed the maximum
+//
+   if (XrdOssUring::Ring && fd >= 0 && !cxobj
+   &&  (!XrdOssSS->MaxSize || (long long)(aiop->sfsAio.aio_offset
+                            + aiop->sfsAio.aio_nbytes) <= XrdOssSS->MaxSize))
+      {aiop->TIdent = tident;
+       if (!XrdOssUring::Ring->Write(aiop, fd)) return 0;
+      }
+
 #ifdef _POSIX_ASYNCHRONOUS_IO
    EPNAME("AioWrite");
    int rc;
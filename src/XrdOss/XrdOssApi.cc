@@ -34,6 +34,7 @@
 #include <unistd.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <limits.h>
 #include <signal.h>
 #include <strings.h>
 #include <stdio.h>
@@ -41,9 +42,12 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/param.h>
+#include <sys/uio.h>
 #ifdef __solaris__
 #include <sys/vnode.h>
 #endif
+#include <algorithm>
+#include <vector>
 
 #include "XrdVersion.hh"
 
@@ -54,6 +58,7 @@
 #include "XrdOss/XrdOssError.hh"
 #include "XrdOss/XrdOssMio.hh"
 #include "XrdOss/XrdOssTrace.hh"
+#include "XrdOss/XrdOssUring.hh"
 #include "XrdOuc/XrdOucEnv.hh"
 #include "XrdOuc/XrdOucName2Name.hh"
 #include "XrdOuc/XrdOucPinLoader.hh"
@@ -374,13 +379,21 @@ int XrdOssSys::Stats(char *buff, int blen)
 {
    static const char statfmt1[] = "<stats id=\"oss\" v=\"2\">";
    static const char statfmt2[] = "</stats>";
+   static const char statfmtv[] = "<readv><calls>%lld</calls><segs>%lld</segs>"
+                       "<ios>%lld</ios><bytes>%lld</bytes><gap>%lld</gap></readv>";
    static const int  statflen = sizeof(statfmt1) + sizeof(statfmt2);
+   static const char statfmtu[] = "<uring><reqs>%lld</reqs><enter>%lld</enter>"
+                       "<full>%lld</full></uring>";
+   static const int  statvlen = sizeof(statfmtv) + 16*5;
+   static const int  statulen = sizeof(statfmtu) + 16*3;
+   long long cntCalls, cntSegs, cntIOs, cntBytes, cntGBytes;
    char *bp = buff;
    int n;
 
 // If only size wanted, return what size we need
 //
-   if (!buff) return statflen + getStats(0,0);
+   if (!buff) return statflen + getStats(0,0) + (rvMaxIO ? statvlen : 0)
+                                                + (AioURing ? statulen : 0);
 
 // Make sure we have enough space
 //
@@ -393,6 +406,30 @@ int XrdOssSys::Stats(char *buff, int blen)
    n = getStats(bp, blen);
    bp += n; blen -= n;
 
+// Generate vector read statistics if we are coalescing
+//
+   if (rvMaxIO && blen > statvlen)
+      {AtomicBeg(rvMutex);
+       cntCalls  = AtomicGet(rvCalls);
+       cntSegs   = AtomicGet(rvSegs);
+       cntIOs    = AtomicGet(rvIOs);
+       cntBytes  = AtomicGet(rvBytes);
+       cntGBytes = AtomicGet(rvGBytes);
+       AtomicEnd(rvMutex);
+       n = snprintf(bp, blen, statfmtv, cntCalls, cntSegs, cntIOs,
+                                        cntBytes, cntGBytes);
+       bp += n; blen -= n;
+      }
+
+// Generate io_uring statistics if we are using it
+//
+   XrdOssUring *urP = XrdOssUring::Ring;
+   if (urP && blen > statulen)
+      {n = snprintf(bp, blen, statfmtu, urP->numReqs, urP->numEnter,
+                                        urP->numFull);
+       bp += n; blen -= n;
+      }
+
 // Add trailer
 //
    if (blen >= (int)sizeof(statfmt2))
@@ -877,6 +914,12 @@ ssize_t XrdOssFile::ReadV(XrdOucIOVec *readV, int n)
    ssize_t rdsz, totBytes = 0;
    int i;
 
+// Coalesce the reads if so wanted
+//
+#ifdef XRDOSS_PREADV
+   if (XrdOssSS->rvMaxIO && n > 1) return ReadV_Merge(readV, n);
+#endif
+
 // For platforms that support fadvise, pre-advise what we will be reading
 //
 #if defined(__linux__) && defined(HAVE_ATOMICS)
@@ -937,6 +980,177 @@ ssize_t XrdOssFile::ReadV(XrdOucIOVec *readV, int n)
    return totBytes;
 }
 
+/******************************************************************************/
+/*                           R e a d V _ M e r g e                            */
+/******************************************************************************/
+
+/*
+  Function: Perform all the reads specified in the readV vector, merging
+            elements that are close to each other into a single preadv().
+
+  Input:    readV     - A description of the reads to perform.
+            readCount - The size of the readV vector.
+
+  Output:   Same as ReadV().
+
+  Notes:    The elements are sorted by offset. A group of elements is read
+            with one preadv() as long as the gap between consecutive elements
+            is at most rvGap bytes and the group spans at most rvMaxIO bytes.
+            Gaps are read into a shared buffer whose contents are discarded.
+            Overlapping elements start a new group. Should a merged read come
+            up short, its elements are read one by one so that the result is
+            the same as that of ReadV().
+*/
+
+#ifdef XRDOSS_PREADV
+namespace
+{
+struct XrdOssRVSeg
+      {long long offset;
+       int       size;
+       int       rvx;
+
+       bool operator<(const XrdOssRVSeg &rhs) const
+                     {return offset < rhs.offset
+                         || (offset == rhs.offset && rvx < rhs.rvx);
+                     }
+      };
+}
+
+ssize_t XrdOssFile::ReadV_Merge(XrdOucIOVec *readV, int n)
+{
+   EPNAME("ReadV");
+   std::vector<XrdOssRVSeg> seg(n);
+   std::vector<int>         grp;
+   struct iovec iov[IOV_MAX];
+   long long gBeg, gEnd, hole, gapBytes = 0;
+   long long begLst = -1, endLst = -1;
+   ssize_t rdsz, totBytes = 0;
+   int i, j, k, iovcnt, numIO = 0, nPR = 0, doPR = 0;
+   bool isSorted = true;
+
+// Copy the vector and sort it by offset unless it already is (the usual case)
+//
+   for (i = 0; i < n; i++)
+       {seg[i].offset = readV[i].offset;
+        seg[i].size   = readV[i].size;
+        seg[i].rvx    = i;
+        if (i && seg[i].offset < seg[i-1].offset) isSorted = false;
+       }
+   if (!isSorted) std::sort(seg.begin(), seg.end());
+
+// Plan the groups. Each entry in grp is the index of the first element of a
+// group; the last entry is n to make iteration easy.
+//
+   grp.reserve(n+1);
+   for (i = 0; i < n; i = j)
+       {grp.push_back(i);
+        gBeg = seg[i].offset; gEnd = gBeg + seg[i].size; iovcnt = 1;
+        for (j = i+1; j < n; j++)
+            {hole = seg[j].offset - gEnd;
+             if (hole < 0 || hole > XrdOssSS->rvGap
+             ||  seg[j].offset + seg[j].size - gBeg > XrdOssSS->rvMaxIO
+             ||  iovcnt + (hole ? 2 : 1) > IOV_MAX) break;
+             iovcnt += (hole ? 2 : 1);
+             gEnd = seg[j].offset + seg[j].size;
+            }
+       }
+   grp.push_back(n);
+
+// Pre-advise the first few groups just like ReadV() does for elements
+//
+#if defined(__linux__) && defined(HAVE_ATOMICS)
+   if (XrdOssSS->prDepth
+   && AtomicInc((XrdOssSS->prActive)) < XrdOssSS->prQSize && grp.size() > 3)
+      {int faBytes = 0;
+       doPR = 1;
+       for (nPR = 0; nPR < XrdOssSS->prDepth && faBytes < XrdOssSS->prBytes
+                  && nPR+1 < (int)grp.size(); nPR++)
+           {gBeg = XrdOssSS->prPMask & seg[grp[nPR]].offset;
+            k    = grp[nPR+1]-1;
+            gEnd = XrdOssSS->prPBits | (seg[k].offset + seg[k].size);
+            rdsz = gEnd - gBeg + 1;
+            if ((gBeg > endLst || gEnd < begLst) && rdsz < XrdOssSS->prBytes)
+               {posix_fadvise(fd, gBeg, rdsz, POSIX_FADV_WILLNEED);
+                TRACE(Debug,"fadvise(" <<fd <<',' <<gBeg <<',' <<rdsz <<')');
+                faBytes += rdsz;
+               }
+            begLst = gBeg; endLst = gEnd;
+           }
+      }
+#endif
+
+// Read each group
+//
+   for (int g = 0; g+1 < (int)grp.size() && totBytes >= 0; g++)
+       {i = grp[g]; j = grp[g+1];
+        gBeg = seg[i].offset;
+        gEnd = seg[j-1].offset + seg[j-1].size;
+        for (iovcnt = 0, k = i; k < j; k++)
+            {if (k > i && (hole = seg[k].offset - (seg[k-1].offset + seg[k-1].size)))
+                {iov[iovcnt].iov_base = XrdOssSS->rvSink;
+                 iov[iovcnt].iov_len  = hole;
+                 gapBytes += hole; iovcnt++;
+                }
+             iov[iovcnt].iov_base = readV[seg[k].rvx].data;
+             iov[iovcnt].iov_len  = seg[k].size;
+             iovcnt++;
+            }
+        do {rdsz = (iovcnt == 1 ? pread(fd, iov[0].iov_base, iov[0].iov_len, gBeg)
+                                : preadv(fd, iov, iovcnt, gBeg));
+           } while(rdsz < 0 && errno == EINTR);
+        numIO++;
+
+     // If the merged read failed or came up short, redo it element by element
+     //
+        if (rdsz != gEnd - gBeg)
+           {for (k = i; k < j; k++)
+                {do {rdsz = pread(fd, readV[seg[k].rvx].data, seg[k].size,
+                                      seg[k].offset);
+                    } while(rdsz < 0 && errno == EINTR);
+                 numIO++;
+                 if (rdsz < 0 || rdsz != seg[k].size)
+                    {totBytes = (rdsz < 0 ? -errno : -ESPIPE); break;}
+                }
+            if (totBytes < 0) break;
+           }
+
+     // Pre-advise the next group we have not yet done
+     //
+#if defined(__linux__) && defined(HAVE_ATOMICS)
+        if (doPR && nPR+1 < (int)grp.size())
+           {gBeg = XrdOssSS->prPMask & seg[grp[nPR]].offset;
+            k    = grp[nPR+1]-1;
+            gEnd = XrdOssSS->prPBits | (seg[k].offset + seg[k].size);
+            rdsz = gEnd - gBeg + 1;
+            if ((gBeg > endLst || gEnd < begLst) && rdsz <= XrdOssSS->prBytes)
+               {posix_fadvise(fd, gBeg, rdsz, POSIX_FADV_WILLNEED);
+                TRACE(Debug,"fadvise(" <<fd <<',' <<gBeg <<',' <<rdsz <<')');
+               }
+            begLst = gBeg; endLst = gEnd;
+            nPR++;
+           }
+#endif
+       }
+
+// Compute the number of bytes read and update statistics
+//
+   if (totBytes >= 0) for (i = 0; i < n; i++) totBytes += seg[i].size;
+#if defined(__linux__) && defined(HAVE_ATOMICS)
+   if (XrdOssSS->prDepth) AtomicDec((XrdOssSS->prActive));
+#endif
+
+   AtomicBeg(XrdOssSS->rvMutex);
+   AtomicInc(XrdOssSS->rvCalls);
+   AtomicAdd(XrdOssSS->rvSegs,   n);
+   AtomicAdd(XrdOssSS->rvIOs,    numIO);
+   AtomicAdd(XrdOssSS->rvBytes,  (totBytes > 0 ? totBytes : 0));
+   AtomicAdd(XrdOssSS->rvGBytes, gapBytes);
+   AtomicEnd(XrdOssSS->rvMutex);
+   return totBytes;
+}
+#endif
+
 /******************************************************************************/
 /*                               R e a d R a w                                */
 /******************************************************************************/
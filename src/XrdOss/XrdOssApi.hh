@@ -117,6 +117,7 @@ virtual ~XrdOssFile() {if (fd >= 0) Close();}
 
 private:
 int     Open_ufs(const char *, int, int, unsigned long long);
+ssize_t ReadV_Merge(XrdOucIOVec *readV, int n);
 
 static int      AioFailure;
 oocx_CXFile    *cxobj;
@@ -272,6 +273,18 @@ int               prActive;  //    preread activity count
 short             prDepth;   //    preread depth
 short             prQSize;   //    preread maximum allowed
 
+int               AioURing;  //    io_uring queue depth (0 -> posix aio)
+
+char             *rvSink;    // -> readv gap buffer (contents are discarded)
+int               rvGap;     //    readv largest gap read through
+int               rvMaxIO;   //    readv largest merged read (0 -> off)
+long long         rvCalls;   //    readv requests coalesced
+long long         rvSegs;    //    readv segments requested
+long long         rvIOs;     //    readv reads actually issued
+long long         rvBytes;   //    readv bytes requested
+long long         rvGBytes;  //    readv gap bytes read and discarded
+XrdSysMutex       rvMutex;   //    readv stats (only if no atomics)
+
 XrdVersionInfo   *myVersion; //    Compilation version set by constructor
    
          XrdOssSys();
@@ -336,6 +349,7 @@ void   ConfigStats(XrdSysError &Eroute);
 void   ConfigStats(dev_t Devnum, char *lP);
 int    ConfigXeq(char *, XrdOucStream &, XrdSysError &);
 void   List_Path(const char *, const char *, unsigned long long, XrdSysError &);
+int    xaio(XrdOucStream &Config, XrdSysError &Eroute);
 int    xalloc(XrdOucStream &Config, XrdSysError &Eroute);
 int    xcache(XrdOucStream &Config, XrdSysError &Eroute);
 int    xcachescan(XrdOucStream &Config, XrdSysError &Eroute);
@@ -346,6 +360,7 @@ int    xmemf(XrdOucStream &Config, XrdSysError &Eroute);
 int    xnml(XrdOucStream &Config, XrdSysError &Eroute);
 int    xpath(XrdOucStream &Config, XrdSysError &Eroute);
 int    xprerd(XrdOucStream &Config, XrdSysError &Eroute);
+int    xreadv(XrdOucStream &Config, XrdSysError &Eroute);
 int    xspace(XrdOucStream &Config, XrdSysError &Eroute, int *isCD=0);
 int    xspaceBuild(char *grp, char *fn, int isxa, XrdSysError &Eroute);
 int    xstg(XrdOucStream &Config, XrdSysError &Eroute);
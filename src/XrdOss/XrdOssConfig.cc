@@ -35,6 +35,7 @@
 #include <fcntl.h>
 #include <strings.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <sys/param.h>
 #include <sys/resource.h>
 #include <sys/stat.h>
@@ -52,6 +53,7 @@
 #include "XrdOss/XrdOssOpaque.hh"
 #include "XrdOss/XrdOssSpace.hh"
 #include "XrdOss/XrdOssTrace.hh"
+#include "XrdOss/XrdOssUring.hh"
 #include "XrdOuc/XrdOuca2x.hh"
 #include "XrdOuc/XrdOucEnv.hh"
 #include "XrdSys/XrdSysError.hh"
@@ -212,6 +214,11 @@ XrdOssSys::XrdOssSys()
    prActive      = 0;
    prDepth       = 0;
    prQSize       = 0;
+   AioURing      = 0;
+   rvSink        = 0;
+   rvGap         = 0;
+   rvMaxIO       = 0;
+   rvCalls = rvSegs = rvIOs = rvBytes = rvGBytes = 0;
    STT_Lib       = 0;
    STT_Parms     = 0;
    STT_Func      = 0;
@@ -306,6 +313,13 @@ int XrdOssSys::Configure(const char *configfn, XrdSysError &Eroute,
 //
    if (!NoGo) NoGo = !AioInit();
 
+// Use io_uring for async I/O if so wanted; otherwise we fall back to the above
+//
+   if (!NoGo && AioURing && !XrdOssUring::Start(AioURing))
+      {Eroute.Say("Config warning: io_uring unavailable; using default aio.");
+       AioURing = 0;
+      }
+
 // Initialize memory mapping setting to speed execution
 //
    if (!NoGo) ConfigMio(Eroute);
@@ -417,6 +431,18 @@ void XrdOssSys::Config_Display(XrdSysError &Eroute)
 
      Eroute.Say(buff);
 
+     if (AioURing)
+        {snprintf(buff, sizeof(buff), "       oss.aio          uring depth %d",
+                  AioURing);
+         Eroute.Say(buff);
+        }
+
+     if (rvMaxIO)
+        {snprintf(buff, sizeof(buff), "       oss.readv        on gap %d limit %d",
+                  rvGap, rvMaxIO);
+         Eroute.Say(buff);
+        }
+
      XrdOssMio::Display(Eroute);
 
      XrdOssCache::List("       oss.", Eroute);
@@ -945,6 +971,7 @@ int XrdOssSys::ConfigXeq(char *var, XrdOucStream &Config, XrdSysError &Eroute)
     int nosubs;
     XrdOucEnv *myEnv = 0;
 
+   TS_Xeq("aio",           xaio);
    TS_Xeq("alloc",         xalloc);
    TS_Xeq("cache",         xcache);
    TS_Xeq("cachescan",     xcachescan);
@@ -955,6 +982,7 @@ int XrdOssSys::ConfigXeq(char *var, XrdOucStream &Config, XrdSysError &Eroute)
    TS_Xeq("namelib",       xnml);
    TS_Xeq("path",          xpath);
    TS_Xeq("preread",       xprerd);
+   TS_Xeq("readv",         xreadv);
    TS_Xeq("space",         xspace);
    TS_Xeq("stagecmd",      xstg);
    TS_Xeq("statlib",       xstl);
@@ -1014,6 +1042,50 @@ int XrdOssSys::ConfigXeq(char *var, XrdOucStream &Config, XrdSysError &Eroute)
    return 0;
 }
 
+/******************************************************************************/
+/*                                  x a i o                                   */
+/******************************************************************************/
+
+/* Function: xaio
+
+   Purpose:  To parse the directive: aio {posix | uring} [depth <qd>]
+
+             posix    use posix aio, when available, for asynchronous I/O.
+                      This is the default.
+             uring    use a Linux io_uring for asynchronous I/O. Requests are
+                      submitted in batches and completed by a single thread.
+             <qd>     the io_uring queue depth; the maximum number of
+                      requests in flight. The default is 256 and the maximum
+                      is 4096. Requests beyond that are done synchronously.
+
+   Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdOssSys::xaio(XrdOucStream &Config, XrdSysError &Eroute)
+{
+    char *val;
+    int qd = 256, isUR;
+
+      if (!(val = Config.GetWord()))
+         {Eroute.Emsg("Config", "aio type not specified"); return 1;}
+
+           if (!strcmp(val, "posix")) isUR = 0;
+      else if (!strcmp(val, "uring")) isUR = 1;
+      else {Eroute.Emsg("Config","invalid aio type -",val); return 1;}
+
+      while((val = Config.GetWord()))
+           {if (!strcmp(val, "depth"))
+               {if (!(val = Config.GetWord()))
+                   {Eroute.Emsg("Config","aio depth not specified"); return 1;}
+                if (XrdOuca2x::a2i(Eroute,"aio depth",val,&qd,1,4096)) return 1;
+               }
+               else {Eroute.Emsg("Config","invalid aio option -",val); return 1;}
+           }
+
+      AioURing = (isUR ? qd : 0);
+      return 0;
+}
+
 /******************************************************************************/
 /*                                x a l l o c                                 */
 /******************************************************************************/
@@ -1429,6 +1501,84 @@ int XrdOssSys::xprerd(XrdOucStream &Config, XrdSysError &Eroute)
       return 0;
 }
   
+/******************************************************************************/
+/*                                x r e a d v                                 */
+/******************************************************************************/
+
+/* Function: xreadv
+
+   Purpose:  To parse the directive: readv {off | on} [gap <gsz>] [limit <msz>]
+
+             on       sorts the elements of a vector read by offset and reads
+                      elements that are close together using a single call.
+                      This is only supported where preadv() is available.
+                      The default is off.
+             <gsz>    the largest gap between two elements that is read
+                      through (the data in the gap is discarded). The default
+                      is 4K and the maximum is 1M. Zero only merges elements
+                      that are adjacent.
+             <msz>    the maximum number of bytes in a single merged read.
+                      The default is 1M and the maximum is 16M.
+
+   Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdOssSys::xreadv(XrdOucStream &Config, XrdSysError &Eroute)
+{
+    static const long long m01 =  1048576LL;
+    static const long long m16 = 16777216LL;
+    char *val;
+    long long gsz = 4096, msz = m01;
+    int isOn;
+
+      if (!(val = Config.GetWord()))
+         {Eroute.Emsg("Config", "readv argument not specified"); return 1;}
+
+           if (!strcmp(val, "on"))  isOn = 1;
+      else if (!strcmp(val, "off")) isOn = 0;
+      else {Eroute.Emsg("Config","invalid readv argument -",val); return 1;}
+
+      while((val = Config.GetWord()))
+           {     if (!strcmp(val, "gap"))
+                    {if (!(val = Config.GetWord()))
+                        {Eroute.Emsg("Config","readv gap not specified");
+                         return 1;
+                        }
+                     if (XrdOuca2x::a2sz(Eroute,"readv gap",val,&gsz,0,m01))
+                        return 1;
+                    }
+            else if (!strcmp(val, "limit"))
+                    {if (!(val = Config.GetWord()))
+                        {Eroute.Emsg("Config","readv limit not specified");
+                         return 1;
+                        }
+                     if (XrdOuca2x::a2sz(Eroute,"readv limit",val,&msz,
+                                         prPSize,m16)) return 1;
+                    }
+            else {Eroute.Emsg("Config","invalid readv option -",val); return 1;}
+         }
+
+#ifndef XRDOSS_PREADV
+      if (isOn)
+         {Eroute.Say("Config warning: readv coalescing not supported; "
+                     "directive ignored.");
+          isOn = 0;
+         }
+#endif
+
+// Allocate the buffer that receives the gaps. It is shared by all reads.
+//
+      if (rvSink) {free(rvSink); rvSink = 0;}
+      if (isOn && gsz && !(rvSink = (char *)malloc(gsz)))
+         {Eroute.Emsg("Config", ENOMEM, "allocate readv gap buffer");
+          return 1;
+         }
+
+      rvGap   = (isOn ? static_cast<int>(gsz) : 0);
+      rvMaxIO = (isOn ? static_cast<int>(msz) : 0);
+      return 0;
+}
+  
 /******************************************************************************/
 /*                                x s p a c e                                 */
 /******************************************************************************/
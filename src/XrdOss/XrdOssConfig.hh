@@ -43,6 +43,12 @@
 #define XrdOss_USRPRTY   0x00000001
 #define XrdOss_CacheFS   0x00000002
 
+// Vectored reads can be coalesced where preadv() is available
+//
+#if defined(__linux__) || defined(__FreeBSD__)
+#define XRDOSS_PREADV 1
+#endif
+
 // Small structure to hold dual paths
 //
 struct  OssDPath
@@ -0,0 +1,143 @@
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d O s s U r i n g . c c                         */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <errno.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include "XrdOss/XrdOssTrace.hh"
+#include "XrdOss/XrdOssUring.hh"
+#include "XrdSfs/XrdSfsAio.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysHeaders.hh"
+
+/******************************************************************************/
+/*                               G l o b a l s                                */
+/******************************************************************************/
+
+extern XrdOucTrace OssTrace;
+
+extern XrdSysError OssEroute;
+
+XrdOssUring *XrdOssUring::Ring = 0;
+
+/******************************************************************************/
+/*                                  D o n e                                   */
+/******************************************************************************/
+
+// Complete a request. Interrupted operations are redone synchronously.
+//
+void XrdOssUring::Done(unsigned long long udata, int rc)
+{
+   XrdSfsAio *aiop = (XrdSfsAio *)(udata & ~3ULL);
+
+   switch(udata & 3)
+         {case opRead:
+                  if (rc == -EAGAIN || rc == -EINTR)
+                     {do {rc = pread(aiop->sfsAio.aio_fildes,
+                                (void *)aiop->sfsAio.aio_buf,
+                                aiop->sfsAio.aio_nbytes,
+                                aiop->sfsAio.aio_offset);
+                         } while(rc < 0 && errno == EINTR);
+                      if (rc < 0) rc = -errno;
+                     }
+                  aiop->Result = rc;
+                  aiop->doneRead();
+                  break;
+          case opWrite:
+                  if (rc == -EAGAIN || rc == -EINTR)
+                     {do {rc = pwrite(aiop->sfsAio.aio_fildes,
+                                (const void *)aiop->sfsAio.aio_buf,
+                                aiop->sfsAio.aio_nbytes,
+                                aiop->sfsAio.aio_offset);
+                         } while(rc < 0 && errno == EINTR);
+                      if (rc < 0) rc = -errno;
+                     }
+                  aiop->Result = rc;
+                  aiop->doneWrite();
+                  break;
+          default:if (rc == -EAGAIN || rc == -EINTR)
+                     rc = (fsync(aiop->sfsAio.aio_fildes) ? -errno : 0);
+                  aiop->Result = rc;
+                  aiop->doneWrite();
+                  break;
+         }
+}
+
+/******************************************************************************/
+/*                                 E r r o r                                  */
+/******************************************************************************/
+
+void XrdOssUring::Error(const char *what, int eNum)
+{
+   OssEroute.Emsg("Uring", eNum, what);
+}
+
+/******************************************************************************/
+/*                                 S t a r t                                  */
+/******************************************************************************/
+
+XrdOssUring *XrdOssUring::Start(int qdepth)
+{
+   EPNAME("UringStart");
+   XrdOssUring *rP = new XrdOssUring;
+   const char *what;
+   int rc;
+
+// Create the ring and start the reaper
+//
+   if ((rc = rP->XrdSysIOUring::Start(qdepth, &what)))
+      {OssEroute.Emsg("Uring", rc, what);
+       delete rP;
+       return 0;
+      }
+   DEBUG("started io_uring; depth=" <<qdepth);
+
+// All done
+//
+   Ring = rP;
+   return rP;
+}
+
+/******************************************************************************/
+/*                                S u b m i t                                 */
+/******************************************************************************/
+
+int XrdOssUring::Submit(XrdSfsAio *aiop, int fd, Opc opc)
+{
+   Request req;
+
+// The low order two bits of the aio object address, which is at least word
+// aligned, hold the operation.
+//
+   aiop->sfsAio.aio_fildes = fd;
+   req.udata  = (unsigned long long)(uintptr_t)aiop | opc;
+   req.offset = aiop->sfsAio.aio_offset;
+   req.buff   = (void *)aiop->sfsAio.aio_buf;
+   req.blen   = static_cast<unsigned int>(aiop->sfsAio.aio_nbytes);
+   req.fd     = fd;
+   req.opc    = opc;
+   return XrdSysIOUring::Submit(&req);
+}
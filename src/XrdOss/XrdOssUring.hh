@@ -0,0 +1,68 @@
+#ifndef __XRDOSSURING_H__
+#define __XRDOSSURING_H__
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d O s s U r i n g . h h                         */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include "XrdSys/XrdSysIOUring.hh"
+
+/* XrdOssUring implements asynchronous I/O using a Linux io_uring. The ring
+   itself is driven by XrdSysIOUring; completions invoke the aio object's
+   doneRead() or doneWrite() method. The ring is used for all files so there
+   is only one, anchored in Ring.
+
+   The submission routines return 0 when the request was queued and a positive
+   value when the ring is full, in which case the caller should use another
+   method. When io_uring is not supported Start() always fails.
+*/
+
+class XrdSfsAio;
+
+class XrdOssUring : public XrdSysIOUring
+{
+public:
+
+static XrdOssUring *Ring;   // The ring in use, if any
+
+       int          Fsync(XrdSfsAio *aiop, int fd) {return Submit(aiop, fd, opFsync);}
+
+       int          Read (XrdSfsAio *aiop, int fd) {return Submit(aiop, fd, opRead);}
+
+static XrdOssUring *Start(int qdepth);
+
+       int          Write(XrdSfsAio *aiop, int fd) {return Submit(aiop, fd, opWrite);}
+
+protected:
+
+       void         Done(unsigned long long udata, int rc);
+
+       void         Error(const char *what, int eNum);
+
+private:
+                    XrdOssUring() {}
+                   ~XrdOssUring() {} // Only deleted if it fails to start
+
+       int          Submit(XrdSfsAio *aiop, int fd, Opc opc);
+};
+#endif
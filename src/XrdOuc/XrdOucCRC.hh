@@ -30,17 +30,38 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <sys/types.h>
+
 class XrdOucCRC
 {
 public:
 
+//-----------------------------------------------------------------------------
+//! Compute the CRC-32 (ISO 3309, as used by zlib) of a record.
+//-----------------------------------------------------------------------------
+
 static unsigned int CRC32(const unsigned char *rec, int reclen);
 
+//-----------------------------------------------------------------------------
+//! Compute the CRC-32C (Castagnoli) checksum of a buffer. The checksum may be
+//! computed piecewise by passing the previous result as prevcs.
+//!
+//! @param  data   - Pointer to the data.
+//! @param  count  - Number of bytes.
+//! @param  prevcs - The checksum of the preceeding data, zero at the start.
+//!
+//! @return The checksum.
+//-----------------------------------------------------------------------------
+
+static unsigned int Calc32C(const void *data, size_t count,
+                            unsigned int prevcs=0);
+
                     XrdOucCRC() {}
                    ~XrdOucCRC() {}
 
 private:
 
 static unsigned int crctable[256];
+static unsigned int crc32ctable[256];
 };
 #endif
@@ -33,15 +33,283 @@
 #include <errno.h>
 #include <dirent.h>
 #include <unistd.h>
+#if defined(__linux__) && defined(HAVE_FSTATAT)
+#include <sys/syscall.h>
+#define XRDOUCNSWALK_GETDENTS
+#endif
 
 #include "XrdOuc/XrdOucNSWalk.hh"
 #include "XrdOuc/XrdOucTList.hh"
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysHeaders.hh"
 #include "XrdSys/XrdSysPlatform.hh"
+#include "XrdSys/XrdSysPthread.hh"
 
 using namespace std;
 
+/******************************************************************************/
+/*                         L o c a l   C l a s s e s                          */
+/******************************************************************************/
+
+namespace
+{
+// Reads the names in a directory. On Linux the entries are fetched straight
+// from the directory file descriptor, many at a time, with getdents64().
+//
+class DirReader
+{
+public:
+
+const char *Next(int &rc);
+
+int         Open(const char *path, int dfd);
+
+            DirReader() : dP(0), bNext(0), bEnd(0), dFD(-1) {}
+           ~DirReader() {if (dP) closedir(dP);}
+
+private:
+#ifdef XRDOUCNSWALK_GETDENTS
+struct DEnt64 {unsigned long long d_ino;
+               long long          d_off;
+               unsigned short     d_reclen;
+               unsigned char      d_type;
+               char               d_name[1];
+              };
+char  dBuff[32768] __attribute__ ((aligned (8)));
+#endif
+DIR  *dP;
+int   bNext;
+int   bEnd;
+int   dFD;
+};
+
+const char *DirReader::Next(int &rc)
+{
+   rc = 0;
+#ifdef XRDOUCNSWALK_GETDENTS
+   if (dFD >= 0)
+      {DEnt64 *deP;
+       if (bNext >= bEnd)
+          {do {bEnd = syscall(SYS_getdents64, dFD, dBuff, sizeof(dBuff));}
+              while(bEnd < 0 && errno == EINTR);
+           bNext = 0;
+           if (bEnd <= 0) {if (bEnd < 0) rc = errno; return 0;}
+          }
+       deP = (DEnt64 *)(dBuff + bNext);
+       bNext += deP->d_reclen;
+       return deP->d_name;
+      }
+#endif
+   struct dirent *dp;
+
+   errno = 0;
+   if ((dp = readdir(dP))) return dp->d_name;
+   rc = errno;
+   return 0;
+}
+
+int DirReader::Open(const char *path, int dfd)
+{
+#ifdef XRDOUCNSWALK_GETDENTS
+   if (dfd >= 0) {dFD = dfd; return 0;}
+#endif
+   if (!(dP = opendir(path))) return errno;
+   return 0;
+}
+}
+
+/******************************************************************************/
+/*                     C l a s s   X r d O u c N S W a l k P a r              */
+/******************************************************************************/
+
+// Worker threads take directories from the pending list, index each with a
+// walker object of their own and queue the result for Index(). Subdirectories
+// found go back on the pending list. Workers stop taking directories while
+// qMax results are waiting, so memory use stays bounded however large the
+// tree is.
+//
+class XrdOucNSWalkPar
+{
+public:
+
+struct Result
+      {Result              *next;
+       XrdOucNSWalk::NSEnt *ents;
+       char                *dPath;
+       struct stat          dStat;
+       int                  rc;
+       bool                 isEmpty;
+       bool                 lkFail;
+
+                            Result() : next(0), ents(0), dPath(0), rc(0),
+                                       isEmpty(false), lkFail(false) {}
+                           ~Result() {XrdOucNSWalk::NSEnt *eP;
+                                      while((eP = ents))
+                                           {ents = eP->Next; delete eP;}
+                                      if (dPath) free(dPath);
+                                     }
+      };
+
+Result      *Get();
+
+static void *Start(void *pP) {((XrdOucNSWalkPar *)pP)->Work(); return 0;}
+
+void         Work();
+
+             XrdOucNSWalkPar(XrdOucNSWalk *wP, int nthr, int qmax);
+            ~XrdOucNSWalkPar();
+
+private:
+
+XrdSysCondVar wCV;
+XrdOucNSWalk *Walker;
+XrdOucTList  *Pend;
+Result       *First;
+Result       *Last;
+pthread_t    *Tids;
+int           nThr;
+int           nBusy;
+int           nDone;
+int           qMax;
+bool          Stop;
+};
+
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdOucNSWalkPar::XrdOucNSWalkPar(XrdOucNSWalk *wP, int nthr, int qmax)
+                : wCV(0), Walker(wP), First(0), Last(0), nThr(0),
+                  nBusy(0), nDone(0), qMax(qmax), Stop(false)
+{
+   int rc;
+
+// Take over the directories that remain to be indexed
+//
+   Pend = wP->DList; wP->DList = 0;
+
+// Start the workers, settling for fewer if need be
+//
+   Tids = new pthread_t[nthr];
+   for (int i = 0; i < nthr; i++)
+       {if ((rc = XrdSysThread::Run(&Tids[nThr], Start, (void *)this,
+                                    XRDSYSTHREAD_HOLD, "NSWalk")))
+           {wP->Emsg("Index", rc, "start namespace walker thread");
+            break;
+           }
+        nThr++;
+       }
+
+// Without workers the walk goes on in the caller's thread
+//
+   if (!nThr) {wP->DList = Pend; Pend = 0;}
+}
+
+/******************************************************************************/
+/*                            D e s t r u c t o r                             */
+/******************************************************************************/
+
+XrdOucNSWalkPar::~XrdOucNSWalkPar()
+{
+   XrdOucTList *tP;
+   Result *rP;
+
+// Tell the workers to stop and wait for them to do so
+//
+   wCV.Lock(); Stop = true; wCV.Broadcast(); wCV.UnLock();
+   for (int i = 0; i < nThr; i++) XrdSysThread::Join(Tids[i], 0);
+   delete [] Tids;
+
+// Discard whatever was not taken
+//
+   while((tP = Pend))  {Pend  = tP->next; delete tP;}
+   while((rP = First)) {First = rP->next; delete rP;}
+}
+
+/******************************************************************************/
+/*                                   G e t                                    */
+/******************************************************************************/
+
+// Returns the next indexed directory or null once the whole tree was walked.
+//
+XrdOucNSWalkPar::Result *XrdOucNSWalkPar::Get()
+{
+   Result *rP;
+
+   wCV.Lock();
+   while(!First && (Pend || nBusy) && nThr) wCV.Wait();
+   if ((rP = First))
+      {if (!(First = rP->next)) Last = 0;
+       nDone--;
+       wCV.Broadcast();
+      }
+   wCV.UnLock();
+   return rP;
+}
+
+/******************************************************************************/
+/*                                  W o r k                                   */
+/******************************************************************************/
+
+void XrdOucNSWalkPar::Work()
+{
+   XrdOucNSWalk wkr(Walker->eDest, "/", Walker->LKFn, Walker->Opts,
+                    Walker->XList);
+   XrdOucTList *tP, *dP;
+   Result *rP;
+   bool keep;
+
+// Our walker indexes just what we give it. It has the call back so that it
+// checks for empty directories, but the call itself is made by Index().
+//
+   delete wkr.DList; wkr.DList = 0;
+   wkr.edCB = Walker->edCB;
+   wkr.mPfx = Walker->mPfx;
+
+   wCV.Lock();
+   while(!Stop)
+        {if (!Pend || nDone >= qMax)
+            {if (!Pend && !nBusy) break;
+             wCV.Wait();
+             continue;
+            }
+         tP = Pend; Pend = tP->next; nBusy++;
+         wCV.UnLock();
+
+      // Index the directory as Index() does it for a single one
+      //
+         wkr.setPath(tP->text); delete tP;
+         rP = new Result;
+         if (wkr.LKFn && (rP->rc = wkr.LockFile())) rP->lkFail = true;
+            else {rP->rc = wkr.Build();
+                  if (wkr.LKfd >= 0) {close(wkr.LKfd); wkr.LKfd = -1;}
+                 }
+         *wkr.File   = '\0';
+         rP->ents    = wkr.DEnts; wkr.DEnts = 0;
+         rP->isEmpty = wkr.isEmpty != 0;
+         if (rP->isEmpty) rP->dStat = wkr.dStat;
+         keep = rP->ents || rP->lkFail || (rP->rc && !wkr.errOK)
+             || (wkr.edCB && rP->isEmpty);
+         if (keep) rP->dPath = strdup(wkr.DPath);
+            else {delete rP; rP = 0;}
+         dP = wkr.DList; wkr.DList = 0;
+
+      // Queue the result and the new directories
+      //
+         wCV.Lock();
+         while((tP = dP)) {dP = tP->next; tP->next = Pend; Pend = tP;}
+         if (rP)
+            {if (Last) Last->next = rP;
+                else   First      = rP;
+             Last = rP; nDone++;
+            }
+         nBusy--;
+         wCV.Broadcast();
+        }
+   wCV.Broadcast();
+   wCV.UnLock();
+}
+
 /******************************************************************************/
 /*                           C o n s t r u c t o r                            */
 /******************************************************************************/
@@ -62,14 +330,17 @@ XrdOucNSWalk::XrdOucNSWalk(XrdSysError *erp, const char *dpath,
    errOK= opts & skpErrs;
    DEnts= 0;
    edCB = 0;
+   Par  = 0;
+   nThr = 0;
+   qMax = 0;
 
 // Copy the exclude list if one exists
 //
-   if (!xlist) XList = 0;
-      else while(xlist)
-                {XList = new XrdOucTList(xlist->text,xlist->ival,XList);
-                 xlist = xlist->next;
-                }
+   XList = 0;
+   while(xlist)
+        {XList = new XrdOucTList(xlist->text,xlist->ival,XList);
+         xlist = xlist->next;
+        }
 }
 
 /******************************************************************************/
@@ -80,6 +351,8 @@ XrdOucNSWalk::~XrdOucNSWalk()
 {
    XrdOucTList *tP;
 
+   if (Par) delete Par;
+
    if (LKFn) free(LKFn);
 
    while((tP = DList)) {DList = tP->next; delete tP;}
@@ -96,9 +369,33 @@ XrdOucNSWalk::NSEnt *XrdOucNSWalk::Index(int &rc, const char **dPath)
    XrdOucTList *tP;
    NSEnt *eP;
 
-// Sequence the directory
+// Take the directories indexed by the workers when walking in parallel
 //
    rc = 0; *DPath = '\0';
+   if (!Par && nThr > 1 && (Opts & Recurse) && DList)
+      {Par = new XrdOucNSWalkPar(this, nThr, qMax);
+       if (DList) {delete Par; Par = 0; nThr = 0;}
+      }
+   if (Par)
+      {XrdOucNSWalkPar::Result *rP;
+       bool done;
+       while((rP = Par->Get()))
+            {setPath(rP->dPath);
+             DEnts = rP->ents; rP->ents = 0;
+             rc = rP->rc; isEmpty = rP->isEmpty; dStat = rP->dStat;
+             done = DEnts || rP->lkFail || (rc && !errOK);
+             delete rP;
+             if (done) break;
+             rc = 0;
+             if (edCB && isEmpty) edCB->isEmpty(&dStat, DPath, LKFn);
+            }
+       eP = DEnts; DEnts = 0;
+       if (dPath) *dPath = DPath;
+       return eP;
+      }
+
+// Sequence the directory
+//
    while((tP = DList))
         {setPath(tP->text);
          DList = tP->next; delete tP;
@@ -155,15 +452,14 @@ void XrdOucNSWalk::addEnt(XrdOucNSWalk::NSEnt *eP)
 int XrdOucNSWalk::Build()
 {
    struct Helper {XrdOucNSWalk::NSEnt *P;
-                  DIR                 *D;
                   int                  F;
-                                       Helper() : P(0), D(0), F(-1) {}
+                                       Helper() : P(0), F(-1) {}
                                       ~Helper() {if (P)   delete P;
-                                                 if (D)   closedir(D);
                                                  if (F>0) close(F);
                                                 }
                  } theEnt;
-   struct dirent  *dp;
+   DirReader       dRdr;
+   const char     *dName;
    int             rc = 0, getLI = Opts & retLink;
    int             nEnt = 0, xLKF = 0, chkED = (edCB != 0) && (LKFn != 0);
 
@@ -174,7 +470,7 @@ int XrdOucNSWalk::Build()
 // If we can optimize with a directory file descriptor, get one
 //
 #ifdef HAVE_FSTATAT
-   if ((DPfd = open(DPath, O_RDONLY)) < 0) rc = errno;
+   if ((DPfd = open(DPath, O_RDONLY | O_DIRECTORY)) < 0) rc = errno;
       else theEnt.F = DPfd;
 #else
    DPfd = -1;
@@ -182,21 +478,21 @@ int XrdOucNSWalk::Build()
 
 // Open the directory
 //
-   if (!(theEnt.D = opendir(DPath)))
-      return Emsg("Build", errno, "open directory", DPath);
+   if ((rc = dRdr.Open(DPath, DPfd)))
+      return Emsg("Build", rc, "open directory", DPath);
 
-// Process the entries
+// Process the entries. When links are returned the entry was lstat'ed so a
+// directory is never a symlink to one.
 //
-   errno = 0;
-   while((dp = readdir(theEnt.D)))
-        {if (!strcmp(dp->d_name, ".") || !strcmp(dp->d_name, "..")) continue;
-         strcpy(File, dp->d_name); nEnt++;
+   while((dName = dRdr.Next(rc)))
+        {if (dName[0] == '.' && (!dName[1] || (dName[1] == '.' && !dName[2])))
+            continue;
+         strcpy(File, dName); nEnt++;
          if (!theEnt.P) theEnt.P = new NSEnt();
          rc = getStat(theEnt.P, getLI);
          switch(theEnt.P->Type)
                {case NSEnt::isDir:
-                     if (Opts & Recurse && (!getLI || !isSymlink())
-                     &&  (!XList || !inXList(File)))
+                     if (Opts & Recurse && (!XList || !inXList(File)))
                         DList = new XrdOucTList(DPath, 0, DList);
                      if (!(Opts & retDir)) continue;
                      break;
@@ -217,7 +513,6 @@ int XrdOucNSWalk::Build()
                      if (!rc) rc = EINVAL;
                      break;
                }
-         errno = 0;
          if (rc) {if (errOK) continue; return rc;}
          addEnt(theEnt.P); theEnt.P = 0; 
         }
@@ -225,7 +520,7 @@ int XrdOucNSWalk::Build()
 // All done, check if we reached EOF or there is an error
 //
    *File = '\0';
-   if ((rc = errno) && !errOK)
+   if (rc && !errOK)
       return Emsg("Build", rc, "read directory", DPath);
 
 // Check if we need to do a callback for an empty directory
@@ -332,31 +627,6 @@ int XrdOucNSWalk::inXList(const char *dName)
    return 1;
 }
   
-/******************************************************************************/
-/*                             i s S y m l i n k                              */
-/******************************************************************************/
-  
-int XrdOucNSWalk::isSymlink()
-{
-   struct stat buf;
-   int rc;
-
-
-// The following code either uses fstatat() or regular stat()
-//
-#ifdef HAVE_FSTATAT
-do{rc = fstatat(DPfd, File, &buf, AT_SYMLINK_NOFOLLOW);
-#else
-do{rc = lstat(DPath, &buf);
-#endif
-  } while(rc && errno == EINTR);
-
-// Check for errors
-//
-   if (rc) return 0;
-   return (buf.st_mode & S_IFMT) == S_IFLNK;
-}
-
 /******************************************************************************/
 /*                              L o c k F i l e                               */
 /******************************************************************************/
@@ -36,6 +36,7 @@
 #include <sys/stat.h>
   
 
+class XrdOucNSWalkPar;
 class XrdOucTList;
 class XrdSysError;
 
@@ -101,6 +102,17 @@ void         setCallBack(CallBack *cbP=0) {edCB = cbP;}
 //
 void         setMsgOn(const char *pfx) {mPfx = pfx;}
 
+// A recursive walk may index directories ahead of Index() using several
+// threads, which pays off on file systems with many directories. Index() then
+// returns the directories in no particular order but otherwise behaves the
+// same; call backs are still made by the thread calling Index(). At most qmax
+// (default 64 per thread) indexed directories are held for Index() to take.
+// This must be set before the first call to Index(); nthr < 2 walks the tree
+// in the calling thread only.
+//
+void         setThreads(int nthr, int qmax=0)
+                       {nThr = nthr; qMax = (qmax > 0 ? qmax : nthr*64);}
+
 // The following are processing options passed to the constructor
 //
 static const int retDir =  0x0001; // Return directories (implies retStat)
@@ -130,6 +142,8 @@ static const int skpErrs=  0x8000; // Skip any entry causing an error
 //       as a directory entry if an empty directory call back has been set.
 
 private:
+friend class XrdOucNSWalkPar;
+
 void          addEnt(XrdOucNSWalk::NSEnt *eP);
 int           Build();
 int           Emsg(const char *pfx, int rc, const char *tx1, const char *tx2=0);
@@ -137,7 +151,6 @@ int           getLink(XrdOucNSWalk::NSEnt *eP);
 int           getStat(XrdOucNSWalk::NSEnt *eP, int doLstat=0);
 int           getStat();
 int           inXList(const char *dName);
-int           isSymlink();
 int           LockFile();
 void          setPath(char *newpath);
 
@@ -147,6 +160,7 @@ XrdOucTList  *XList;
 struct NSEnt *DEnts;
 struct stat   dStat;
 CallBack     *edCB;
+XrdOucNSWalkPar *Par;
 const char   *mPfx;
 char          DPath[1032];
 char         *File;
@@ -156,5 +170,7 @@ int           DPfd;
 int           Opts;
 int           errOK;
 int           isEmpty;
+int           nThr;
+int           qMax;
 };
 #endif
@@ -156,6 +156,7 @@ XrdSecgsiAuthzKey_t XrdSecProtocolgsi::AuthzKey = 0;
 int    XrdSecProtocolgsi::AuthzCertFmt = -1;
 int    XrdSecProtocolgsi::GMAPCacheTimeOut = -1;
 int    XrdSecProtocolgsi::AuthzCacheTimeOut = 43200;  // 12h, default
+int    XrdSecProtocolgsi::VfyCacheTimeOut = -1;  // Until chain or CRL expire
 String XrdSecProtocolgsi::SrvAllowedNames;
 int    XrdSecProtocolgsi::VOMSAttrOpt = 1;
 XrdSecgsiAuthz_t XrdSecProtocolgsi::VOMSFun = 0;
@@ -176,6 +177,7 @@ XrdSutCache  XrdSecProtocolgsi::cacheCert(8,13); // Server certificates info cac
 XrdSutCache  XrdSecProtocolgsi::cachePxy(8,13);  // Client proxies cache (Fibonacci-based sizes)
 XrdSutCache  XrdSecProtocolgsi::cacheGMAPFun; // Entries mapped by GMAPFun (default size 144)
 XrdSutCache  XrdSecProtocolgsi::cacheAuthzFun; // Entities filled by AuthzFun (default size 144)
+XrdSutCache  XrdSecProtocolgsi::cacheVfy; // Client chains already verified (default size 144)
 //
 // Services
 XrdOucGMap *XrdSecProtocolgsi::servGMap = 0; // Grid map service
@@ -188,6 +190,10 @@ GSIStack<XrdCryptoX509Crl>  XrdSecProtocolgsi::stackCRL; // Stack of CRL in use
 time_t XrdSecProtocolgsi::lastGMAPCheck = -1; // Time of last check
 XrdSysMutex XrdSecProtocolgsi::mutexGMAP;  // Mutex to control GMAP reloads
 //
+// Verified chains cache control vars
+time_t XrdSecProtocolgsi::lastVfyTrim = -1; // Time of last trim
+XrdSysMutex XrdSecProtocolgsi::mutexVfy;  // Mutex to control trims
+//
 // Running options / settings
 int  XrdSecProtocolgsi::Debug       = 0; // [CS] Debug level
 bool XrdSecProtocolgsi::Server      = 1; // [CS] If server mode 
@@ -509,6 +515,12 @@ char *XrdSecProtocolgsi::Init(gsiOptions opt, XrdOucErrInfo *erp)
    //
    // Server specific options
    if (Server) {
+      //
+      // Expiration of verified chains cache entries
+      if (opt.vfyto >= 0) {
+         VfyCacheTimeOut = opt.vfyto;
+         DEBUG("verified chains cache entries expire after "<<VfyCacheTimeOut<<" secs");
+      }
       //
       // List of supported / wanted crypto modules
       if (opt.clist)
@@ -2224,6 +2236,7 @@ void gsiOptions::Print(XrdOucTrace *t)
          if (authzfunparms) POPTS(t, " Authorization function parms: ignored (no authz function defined)");
       }
       POPTS(t, " Client proxy availability in XrdSecEntity.endorsement: "<< authzpxy);
+      POPTS(t, " Verified chains cache entries expiration (secs): "<< vfyto);
       POPTS(t, " VOMS option: "<< vomsat);
       if (vomsfun) {
          POPTS(t, " VOMS extraction function: " << vomsfun);
@@ -2469,6 +2482,7 @@ char *XrdSecProtocolgsiInit(const char mode,
       //              [-authzfun:<authz_function>]
       //              [-authzfunparms:<authz_function_init_parameters>]
       //              [-authzto:<authz_cache_entry_validity_in_secs>]
+      //              [-vfyto:<verified_chain_cache_entry_validity_in_secs>]
       //              [-gmapto:<grid_map_cache_entry_validity_in_secs>]
       //              [-gmapopt:<grid_map_check_option>]
       //              [-dlgpxy:<proxy_req_option>]
@@ -2502,6 +2516,7 @@ char *XrdSecProtocolgsiInit(const char mode,
       int ogmap = 1;
       int gmapto = 600;
       int authzto = -1;
+      int vfyto = -1;
       int dlgpxy = 0;
       int authzpxy = 0;
       int vomsat = 1;
@@ -2548,6 +2563,8 @@ char *XrdSecProtocolgsiInit(const char mode,
                authzfunparms = (const char *)(op+15);
             } else if (!strncmp(op, "-authzto:",9)) {
                authzto = atoi(op+9);
+            } else if (!strncmp(op, "-vfyto:",7)) {
+               vfyto = atoi(op+7);
             } else if (!strncmp(op, "-gmapto:",8)) {
                gmapto = atoi(op+8);
             } else if (!strncmp(op, "-dlgpxy:",8)) {
@@ -2586,6 +2603,7 @@ char *XrdSecProtocolgsiInit(const char mode,
       opts.ogmap = ogmap;
       opts.gmapto = gmapto;
       opts.authzto = authzto;
+      opts.vfyto = vfyto;
       opts.dlgpxy = dlgpxy;
       opts.authzpxy = authzpxy;
       opts.vomsat = vomsat;
@@ -3502,12 +3520,7 @@ int XrdSecProtocolgsi::ServerDoCert(XrdSutBuffer *br,  XrdSutBuffer **bm,
    //
    // Verify the chain
    x509ChainVerifyOpt_t vopt = {0,static_cast<int>(hs->TimeStamp),-1,hs->Crl};
-   XrdCryptoX509Chain::EX509ChainErr ecode = XrdCryptoX509Chain::kNone;
-   if (!(hs->Chain->Verify(ecode, &vopt))) {
-      cmsg = "certificate chain verification failed: ";
-      cmsg += hs->Chain->LastError();
-      return -1;
-   }
+   if (!VerifyChain(bck, &vopt, cmsg)) return -1;
 
    //
    // Check if there will be delegated proxies; these can be through
@@ -4193,6 +4206,136 @@ bool XrdSecProtocolgsi::VerifyCA(int opt, X509Chain *cca, XrdCryptoFactory *CF)
    return verified;
 }
 
+//_____________________________________________________________________________
+static bool VerifyChainCheck(XrdSutCacheEntry *e, void *a) {
+
+   // Check that the chain verified for this entry is still good at the time
+   // arg1; it must have been verified against the CRL with update time arg2
+   // (ignored if -1) not longer than arg3 secs (if > 0) before time arg4.
+   time_t ts_ref = (time_t)(*((XrdSutCacheArg_t *)a)).arg1;
+   long crl_stamp = (*((XrdSutCacheArg_t *)a)).arg2;
+   int crl_refresh = (*((XrdSutCacheArg_t *)a)).arg3;
+   time_t now = (time_t)(*((XrdSutCacheArg_t *)a)).arg4;
+
+   if (!e || e->status != kCE_ok ||
+       e->buf1.len != 3*(kXR_int32)sizeof(kXR_int32)) return false;
+
+   // Validity window of the chain and update time of the CRL used
+   kXR_int32 *vfy = (kXR_int32 *)(e->buf1.buf);
+   if (ts_ref < vfy[0] || ts_ref >= vfy[1]) return false;
+   if (crl_stamp != -1 && crl_stamp != vfy[2]) return false;
+   if (crl_refresh > 0 && (now - e->mtime) > crl_refresh) return false;
+
+   return true;
+}
+
+//_____________________________________________________________________________
+bool XrdSecProtocolgsi::VerifyChain(XrdSutBucket *bck,
+                                    x509ChainVerifyOpt_t *vopt, String &cmsg)
+{
+   // Verify hs->Chain, just completed with the certificates in bck.
+   // Successful verifications are cached using the fingerprint of bck and
+   // of the CA, so that logins with the same proxy do not repeat the
+   // signature checks until the chain or the CRL expire (or VfyCacheTimeOut
+   // elapses, if set; 0 disables the cache).
+   // Return true if the chain is good, false otherwise with a message in cmsg.
+   EPNAME("VerifyChain");
+
+   XrdCryptoX509Chain::EX509ChainErr ecode = XrdCryptoX509Chain::kNone;
+   time_t now = time(0);
+
+   //
+   // Entries must not be older than the CRL refresh time nor the timeout
+   int maxage = CRLRefresh;
+   if (VfyCacheTimeOut > 0 && (maxage <= 0 || VfyCacheTimeOut < maxage))
+      maxage = VfyCacheTimeOut;
+
+   //
+   // Remove the stale entries from time to time
+   mutexVfy.Lock();
+   if (lastVfyTrim < 0) lastVfyTrim = now;
+   if (now - lastVfyTrim > TimeSkew) {
+      XrdSutCacheArg_t targ = {now, -1, maxage, now};
+      int ntrim = cacheVfy.Trim(VerifyChainCheck, (void *) &targ);
+      DEBUG("trimmed "<<ntrim<<" entries from the verified chains cache");
+      lastVfyTrim = now;
+   }
+   mutexVfy.UnLock();
+
+   //
+   // The tag: fingerprint of the certificates sent by the client and of
+   // the CA they are verified against
+   String tag;
+   if (VfyCacheTimeOut != 0) {
+      XrdCryptoMsgDigest *md = sessionCF->MsgDigest("sha1");
+      XrdCryptoX509 *xca = hs->Chain->Begin();
+      if (md && xca && md->Update(bck->buffer, bck->size) == 0 &&
+          md->Final() == 0) {
+         tag = md->AsHexString();
+         tag += ':';
+         tag += xca->SubjectHash();
+      }
+      SafeDelete(md);
+   }
+
+   bool rdlock = false;
+   XrdSutCacheEntry *cent = 0;
+   XrdSutCERef ceref;
+   if (tag.length() > 0) {
+      long crlstamp = (vopt->crl) ? vopt->crl->LastUpdate() : 0;
+      XrdSutCacheArg_t arg = {vopt->when, crlstamp, maxage, now};
+      if ((cent = cacheVfy.Get(tag.c_str(), rdlock, VerifyChainCheck,
+                               (void *) &arg))) {
+         if (rdlock || cent->status != kCE_inactive) {
+            ceref.Set(&(cent->rwmtx));
+         } else {
+            // Could not lock the entry: verify without the cache
+            cent = 0;
+         }
+      }
+   }
+
+   //
+   // Verified already: only put the chain in order, as Verify would do
+   if (rdlock) {
+      DEBUG("chain "<<tag<<" found in the verified chains cache");
+      if (hs->Chain->Reorder() == 0) return true;
+      cmsg = "certificate chain verification failed: inconsistent chain";
+      return false;
+   }
+
+   //
+   // Full verification
+   if (!(hs->Chain->Verify(ecode, vopt))) {
+      cmsg = "certificate chain verification failed: ";
+      cmsg += hs->Chain->LastError();
+      if (cent) cent->status = kCE_allowed;
+      return false;
+   }
+
+   //
+   // Save the outcome: validity window of the whole chain and CRL used
+   if (cent) {
+      kXR_int32 vfy[3] = {0, 0x7fffffff, 0};
+      XrdCryptoX509 *xc = hs->Chain->Begin();
+      while (xc) {
+         if (xc->NotBefore() > vfy[0]) vfy[0] = xc->NotBefore();
+         if (xc->NotAfter() < vfy[1]) vfy[1] = xc->NotAfter();
+         xc = hs->Chain->Next();
+      }
+      if (vopt->crl) {
+         vfy[2] = vopt->crl->LastUpdate();
+         if (vopt->crl->NextUpdate() > 0 && vopt->crl->NextUpdate() < vfy[1])
+            vfy[1] = vopt->crl->NextUpdate();
+      }
+      cent->buf1.SetBuf((char *)vfy, sizeof(vfy));
+      cent->mtime = now;
+      cent->status = kCE_ok;
+   }
+
+   return true;
+}
+
 //_____________________________________________________________________________
 static bool GetCACheck(XrdSutCacheEntry *e, void *a) {
 
@@ -186,6 +186,8 @@ public:
    char  *authzfun;// [s] file with the function to fill entities [0]
    char  *authzfunparms;// [s] parameters for the function to fill entities [0]
    int    authzto; // [s] validity in secs of authz cache entries [-1 => unlimited]
+   int    vfyto;  // [s] validity in secs of verified chains cache entries
+                  //     [-1 => until chain or CRL expire; 0 => no caching]
    int    ogmap;  // [s] gridmap file checking option 
    int    dlgpxy; // [c] explicitely ask the creation of a delegated proxy 
                   // [s] ask client for proxies
@@ -206,6 +208,7 @@ public:
                   proxy = 0; valid = 0; deplen = 0; bits = 512;
                   gridmap = 0; gmapto = 600;
                   gmapfun = 0; gmapfunparms = 0; authzfun = 0; authzfunparms = 0; authzto = -1;
+                  vfyto = -1;
                   ogmap = 1; dlgpxy = 0; sigpxy = 1; srvnames = 0;
                   exppxy = 0; authzpxy = 0;
                   vomsat = 1; vomsfun = 0; vomsfunparms = 0; moninfo = 0; hashcomp = 1; }
@@ -332,6 +335,7 @@ private:
    static XrdSecgsiAuthzKey_t AuthzKey; 
    static int              AuthzCertFmt; 
    static int              AuthzCacheTimeOut;
+   static int              VfyCacheTimeOut;
    static int              PxyReqOpts;
    static int              AuthzPxyWhat;
    static int              AuthzPxyWhere;
@@ -355,6 +359,7 @@ private:
    static XrdSutCache   cachePxy;  // Client proxies cache; 
    static XrdSutCache   cacheGMAPFun; // Cache for entries mapped by GMAPFun
    static XrdSutCache   cacheAuthzFun; // Cache for entities filled by AuthzFun
+   static XrdSutCache   cacheVfy;  // Client chains already verified
    //
    // Services
    static XrdOucGMap      *servGMap;  // Grid mapping service 
@@ -367,6 +372,10 @@ private:
    static time_t           lastGMAPCheck; // time of last check on GMAP
    static XrdSysMutex      mutexGMAP;     // mutex to control GMAP reloads
    //
+   // Verified chains cache control vars
+   static time_t           lastVfyTrim;   // time of last trim of cacheVfy
+   static XrdSysMutex      mutexVfy;      // mutex to control cacheVfy trims
+   //
    // Running options / settings
    static int              Debug;          // [CS] Debug level
    static bool             Server;         // [CS] If server mode 
@@ -420,6 +429,8 @@ private:
                         XrdCryptoFactory *cryptof, gsiHSVars *hs = 0);
    static String  GetCApath(const char *cahash);
    static bool    VerifyCA(int opt, X509Chain *cca, XrdCryptoFactory *cf);
+   bool           VerifyChain(XrdSutBucket *bck, x509ChainVerifyOpt_t *vopt,
+                              String &cmsg);
    static int     VerifyCRL(XrdCryptoX509Crl *crl, XrdCryptoX509 *xca, XrdOucString crldir,
                            XrdCryptoFactory *CF, int hashalg);
    bool           ServerCertNameOK(const char *subject, String &e);
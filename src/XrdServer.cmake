@@ -30,6 +30,7 @@ add_library(
   XrdXrootd/XrdXrootdJob.cc             XrdXrootd/XrdXrootdJob.hh
   XrdXrootd/XrdXrootdLoadLib.cc
                                         XrdXrootd/XrdXrootdMonData.hh
+  XrdXrootd/XrdXrootdMonEmit.cc         XrdXrootd/XrdXrootdMonEmit.hh
   XrdXrootd/XrdXrootdMonFile.cc         XrdXrootd/XrdXrootdMonFile.hh
   XrdXrootd/XrdXrootdMonFMap.cc         XrdXrootd/XrdXrootdMonFMap.hh
   XrdXrootd/XrdXrootdMonitor.cc         XrdXrootd/XrdXrootdMonitor.hh
@@ -111,6 +112,7 @@ add_library(
   XrdOss/XrdOssReloc.cc
   XrdOss/XrdOssRename.cc
   XrdOss/XrdOssSpace.cc        XrdOss/XrdOssSpace.hh
+  XrdOss/XrdOssUring.cc        XrdOss/XrdOssUring.hh
   XrdOss/XrdOssStage.cc        XrdOss/XrdOssStage.hh
   XrdOss/XrdOssStat.cc         XrdOss/XrdOssStatInfo.hh
                                XrdOss/XrdOssUnlink.cc
@@ -147,6 +149,7 @@ add_library(
   XrdCms/XrdCmsResp.cc            XrdCms/XrdCmsResp.hh
   XrdCms/XrdCmsReq.cc             XrdCms/XrdCmsReq.hh
   XrdCms/XrdCmsRTable.cc          XrdCms/XrdCmsRTable.hh
+                                  XrdCms/XrdCmsSMask.hh
                                   XrdCms/XrdCmsTypes.hh
   XrdCms/XrdCmsUtils.cc           XrdCms/XrdCmsUtils.hh
                                   XrdCms/XrdCmsVnId.hh
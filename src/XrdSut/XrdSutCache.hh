@@ -48,8 +48,15 @@ typedef struct {
 
 class XrdSutCache {
 public:
-   XrdSutCache(int psize = 89, int size = 144, int load = 80) : table(psize, size, load) {}
-   virtual ~XrdSutCache() {}
+   XrdSutCache(int psize = 89, int size = 144, int load = 80) {
+      // The sizes apply to each shard: they only fix where a shard starts
+      // and it grows on its own as needed
+      for (int i = 0; i < nShards; i++)
+         shard[i].table = new XrdOucHash<XrdSutCacheEntry>(psize, size, load);
+   }
+   virtual ~XrdSutCache() {
+      for (int i = 0; i < nShards; i++) delete shard[i].table;
+   }
 
    XrdSutCacheEntry *Get(const char *tag) {
       // Get the entry with 'tag'.
@@ -59,11 +66,12 @@ public:
 
       XrdSutCacheEntry *cent = 0;
 
-      // Exclusive access to the table
-      XrdSysMutexHelper raii(mtx);
+      // Shared access to the shard: lookups of other threads go on
+      Shard_t &sh = shard[ShardOf(tag)];
+      XrdSysRWLockHelper raii(sh.lck);
 
       // Look for an entry
-      if (!(cent = table.Find(tag))) {
+      if (!(cent = sh.table->Find(tag))) {
          // none found
          return cent;
       }
@@ -90,23 +98,30 @@ public:
       rdlock = false;
       XrdSutCacheEntry *cent = 0;
 
-      // Exclusive access to the table
-      XrdSysMutexHelper raii(mtx);
+      // Shared access to the shard for the common case of an existing entry
+      Shard_t &sh = shard[ShardOf(tag)];
+      XrdSysRWLockHelper raii(sh.lck);
 
       // Look for an entry
-      if (!(cent = table.Find(tag))) {
-         // If none, create a new one and write-lock for validation
-         cent = new XrdSutCacheEntry(tag);
-         int status = 0;
-         cent->rwmtx.WriteLock( status );
-         if (status) {
-            // A problem occured: delete the entry and fail
-            delete cent;
-            return (XrdSutCacheEntry *)0;
+      if (!(cent = sh.table->Find(tag))) {
+         // Exclusive access to the shard to add one; someone may have been
+         // faster in the meantime, so look again
+         raii.UnLock();
+         raii.Lock(&sh.lck, 0);
+         if (!(cent = sh.table->Find(tag))) {
+            // If none, create a new one and write-lock for validation
+            cent = new XrdSutCacheEntry(tag);
+            int status = 0;
+            cent->rwmtx.WriteLock( status );
+            if (status) {
+               // A problem occured: delete the entry and fail
+               delete cent;
+               return (XrdSutCacheEntry *)0;
+            }
+            // Register it in the table
+            sh.table->Add(tag, cent);
+            return cent;
          }
-         // Register it in the table
-         table.Add(tag, cent);
-         return cent;
       }
 
       // We found an existing entry:
@@ -143,12 +158,73 @@ public:
       return cent;
    }
 
-   inline int Num() { return table.Num(); }
-   inline void Reset() { return table.Purge(); }
+   int Trim(XrdSutCacheGet_t condition, void *arg = 0) {
+      // Remove the entries for which condition applied with arguments 'arg'
+      // returns false. Entries currently locked by someone are left alone.
+      // Returns the number of entries removed.
+      TrimArgs_t targ = {condition, arg, 0};
+
+      // One shard at a time: lookups in the others are not held up
+      for (int i = 0; i < nShards; i++) {
+         XrdSysRWLockHelper raii(shard[i].lck, 0);
+         shard[i].table->Apply(TrimEnt, (void *) &targ);
+      }
+      return targ.ntrim;
+   }
+
+   inline int Num() {
+      int n = 0;
+      for (int i = 0; i < nShards; i++) {
+         XrdSysRWLockHelper raii(shard[i].lck);
+         n += shard[i].table->Num();
+      }
+      return n;
+   }
+   inline void Reset() {
+      for (int i = 0; i < nShards; i++) {
+         XrdSysRWLockHelper raii(shard[i].lck, 0);
+         shard[i].table->Purge();
+      }
+   }
 
 private:
-   XrdSysRecMutex         mtx;  // Protect access to table
-   XrdOucHash<XrdSutCacheEntry> table; // table with content
+   // The table is split in shards, each with its own read/write lock, so that
+   // lookups, which are by far the most common operation during an
+   // authentication burst, never wait for each other; adding an entry, which
+   // may also grow the table, or trimming only locks out the readers of one
+   // shard. An entry cannot be removed while its shard is read-locked, so the
+   // entry returned by Find stays valid until it is locked.
+   static const int nShards = 16;
+
+   typedef struct {
+      XrdSysRWLock                  lck;   // Protect access to table
+      XrdOucHash<XrdSutCacheEntry> *table; // table with content
+   } Shard_t;
+
+   static int ShardOf(const char *tag) {
+      // The tables pick their buckets from the low bits of the same hash:
+      // use the high ones of a multiplicative mix so shards fill evenly
+      unsigned long long h = XrdOucHashVal(tag);
+      return (int)((h * 0x9E3779B97F4A7C15ULL) >> 60) & (nShards - 1);
+   }
+
+   typedef struct {
+      XrdSutCacheGet_t  condition;
+      void             *arg;
+      int               ntrim;
+   } TrimArgs_t;
+
+   static int TrimEnt(const char *, XrdSutCacheEntry *cent, void *a) {
+      TrimArgs_t *targ = (TrimArgs_t *)a;
+      if (!cent->rwmtx.CondWriteLock()) return 0;
+      bool keep = (*(targ->condition))(cent, targ->arg);
+      cent->rwmtx.UnLock();
+      if (keep) return 0;
+      targ->ntrim++;
+      return -1;
+   }
+
+   Shard_t shard[nShards];
 };
 
 #endif
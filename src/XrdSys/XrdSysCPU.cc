@@ -0,0 +1,80 @@
+/******************************************************************************/
+/*                                                                            */
+/*                          X r d S y s C P U . c c                           */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include "XrdSys/XrdSysCPU.hh"
+
+#ifdef XRDSYS_CPU_X86
+#include <cpuid.h>
+#endif
+
+/******************************************************************************/
+/*                        S t a t i c   M e m b e r s                         */
+/******************************************************************************/
+
+int XrdSysCPU::offMask = 0;
+  
+/******************************************************************************/
+/*                              F e a t u r e s                               */
+/******************************************************************************/
+
+int XrdSysCPU::Features()
+{
+   static int hwFeats = Probe();
+
+   return hwFeats & ~offMask;
+}
+
+/******************************************************************************/
+/*                                 P r o b e                                  */
+/******************************************************************************/
+  
+int XrdSysCPU::Probe()
+{
+   int feats = 0;
+
+#ifdef XRDSYS_CPU_X86
+   unsigned int eax, ebx, ecx, edx;
+
+// Get the basic feature flags
+//
+   if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return 0;
+   if (ecx & bit_SSSE3)  feats |= SSSE3;
+   if (ecx & bit_SSE4_2) feats |= SSE42;
+   if (ecx & bit_PCLMUL) feats |= PCLMUL;
+
+// AVX2 is only usable if the OS saves the ymm registers on a context switch
+//
+   if ((ecx & bit_OSXSAVE) && (ecx & bit_AVX))
+      {unsigned int xcr0, xcr0h;
+       __asm__ ("xgetbv" : "=a" (xcr0), "=d" (xcr0h) : "c" (0));
+       if ((xcr0 & 0x06) == 0x06 && __get_cpuid_max(0, 0) >= 7)
+          {__cpuid_count(7, 0, eax, ebx, ecx, edx);
+           if (ebx & bit_AVX2) feats |= AVX2;
+          }
+      }
+#endif
+
+   return feats;
+}
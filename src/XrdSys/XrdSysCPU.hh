@@ -0,0 +1,86 @@
+#ifndef __XRDSYS_CPU_H__
+#define __XRDSYS_CPU_H__
+/******************************************************************************/
+/*                                                                            */
+/*                          X r d S y s C P U . h h                           */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+//-----------------------------------------------------------------------------
+//! XrdSysCPU reports instruction set extensions of the processor we run on so
+//! that hot loops (e.g. checksums) can select an accelerated implementation
+//! at run time. Kernels using these extensions are compiled with per function
+//! target attributes, which requires gcc 4.9 or clang on x86_64; otherwise
+//! XRDSYS_CPU_X86 is not defined and Has() always returns false.
+//-----------------------------------------------------------------------------
+
+#if defined(__x86_64__) && \
+   (defined(__clang__) || __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define XRDSYS_CPU_X86 1
+#endif
+
+class XrdSysCPU
+{
+public:
+
+enum Feature {SSSE3  = 0x0001,  //!< Supplemental SSE3 (pshufb)
+              SSE42  = 0x0002,  //!< SSE4.2 (crc32c instruction)
+              PCLMUL = 0x0004,  //!< Carry-less multiplication
+              AVX2   = 0x0008   //!< AVX2 with OS support for ymm state
+             };
+
+//-----------------------------------------------------------------------------
+//! Check whether all of the specified features are usable.
+//!
+//! @param  feats  - One or more Feature values or'd together.
+//!
+//! @return true if all features are available, false otherwise.
+//-----------------------------------------------------------------------------
+
+static bool Has(int feats) {return (Features() & feats) == feats;}
+
+//-----------------------------------------------------------------------------
+//! Return the set of usable features.
+//-----------------------------------------------------------------------------
+
+static int  Features();
+
+//-----------------------------------------------------------------------------
+//! Prevent the use of features even if the processor supports them. This is
+//! meant for testing and benchmarking the portable code paths.
+//!
+//! @param  feats  - One or more Feature values or'd together, zero to allow
+//!                  all features again.
+//-----------------------------------------------------------------------------
+
+static void Disable(int feats) {offMask = feats;}
+
+            XrdSysCPU() {}
+           ~XrdSysCPU() {}
+
+private:
+
+static int  Probe();
+
+static int  offMask;
+};
+#endif
@@ -0,0 +1,405 @@
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d S y s I O U r i n g . c c                       */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "XrdSys/XrdSysIOUring.hh"
+#include "XrdSys/XrdSysPthread.hh"
+#include "XrdSys/XrdSysTimer.hh"
+
+#ifdef HAVE_IO_URING
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+/******************************************************************************/
+/*                         L o c a l   C l a s s e s                          */
+/******************************************************************************/
+
+// The map holds the addresses of the shared ring structures
+//
+class XrdSysIOUringMap
+{
+public:
+unsigned int        *sqHead;
+unsigned int        *sqTail;
+unsigned int        *sqArray;
+unsigned int         sqMask;
+unsigned int         sqEnts;
+struct io_uring_sqe *sqes;
+unsigned int        *cqHead;
+unsigned int        *cqTail;
+unsigned int         cqMask;
+struct io_uring_cqe *cqes;
+
+void                *sqMem;
+size_t               sqLen;
+void                *cqMem;
+size_t               cqLen;
+size_t               sqeLen;
+
+     XrdSysIOUringMap() : sqes(0), sqMem(MAP_FAILED), cqMem(MAP_FAILED) {}
+    ~XrdSysIOUringMap() {if (sqes && (void *)sqes != MAP_FAILED) munmap(sqes, sqeLen);
+                         if (cqMem != MAP_FAILED && cqMem != sqMem) munmap(cqMem, cqLen);
+                         if (sqMem != MAP_FAILED) munmap(sqMem, sqLen);
+                        }
+};
+
+/******************************************************************************/
+/*                       S y s t e m   I n t e r f a c e                      */
+/******************************************************************************/
+
+namespace
+{
+int uringEnter(int fd, unsigned int nsub, unsigned int nwait, unsigned int flg)
+   {return syscall(__NR_io_uring_enter, fd, nsub, nwait, flg, (void *)0, 0);}
+
+int uringSetup(unsigned int ents, struct io_uring_params *pP)
+   {return syscall(__NR_io_uring_setup, ents, pP);}
+
+int uringRegister(int fd, unsigned int opc, void *arg, unsigned int nargs)
+   {return syscall(__NR_io_uring_register, fd, opc, arg, nargs);}
+}
+#else
+class XrdSysIOUringMap {};
+#endif
+
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdSysIOUring::XrdSysIOUring()
+              : numReqs(0), numEnter(0), numFull(0), rMap(0), ringFD(-1),
+                inFlight(0), maxFlight(0), toSubmit(0), inSubmit(0), sqNext(0)
+{}
+
+/******************************************************************************/
+/*                            D e s t r u c t o r                             */
+/******************************************************************************/
+
+// Only rings that failed to start are ever deleted.
+//
+XrdSysIOUring::~XrdSysIOUring()
+{
+   if (rMap) delete rMap;
+   if (ringFD >= 0) close(ringFD);
+}
+
+/******************************************************************************/
+/*                                  R e a p                                   */
+/******************************************************************************/
+
+void *XrdSysIOUring::Reap(void *carg)
+{
+   XrdSysIOUring *rP = (XrdSysIOUring *)carg;
+   rP->Reaper();
+   return (void *)0;
+}
+
+#ifdef HAVE_IO_URING
+/******************************************************************************/
+/*                                  F a i l                                   */
+/******************************************************************************/
+
+// Take back all requests that the kernel has not consumed and complete them
+// with the error. Upon entry subMutex must be held and inSubmit set; the lock
+// is dropped while Done() is called. Since only the submitter calls into the
+// kernel with requests, nothing between the kernel's head and our tail can be
+// consumed while we do this.
+//
+void XrdSysIOUring::Fail(int eNum)
+{
+   unsigned int head = __atomic_load_n(rMap->sqHead, __ATOMIC_ACQUIRE);
+   int n = static_cast<int>(sqNext - head);
+   unsigned long long *udata = new unsigned long long[n];
+
+   for (int i = 0; i < n; i++)
+       udata[i] = rMap->sqes[(head + i) & rMap->sqMask].user_data;
+   sqNext = head;
+   __atomic_store_n(rMap->sqTail, sqNext, __ATOMIC_RELEASE);
+   inFlight -= n; toSubmit = 0;
+
+   subMutex.UnLock();
+   for (int i = 0; i < n; i++) Done(udata[i], -eNum);
+   delete [] udata;
+   subMutex.Lock();
+}
+
+/******************************************************************************/
+/*                                 F l u s h                                  */
+/******************************************************************************/
+
+// Submit all queued requests. Upon entry subMutex must be held and inSubmit
+// must have been set by the caller. Requests queued by other threads while we
+// are in the kernel are picked up on the next iteration. The lock is held
+// upon return and inSubmit is cleared.
+//
+// When the kernel takes only part of a batch the rest is submitted right away.
+// When it takes nothing because it is short of resources we leave the retry
+// to the reaper, provided something is in flight whose completion wakes it
+// up. Otherwise we retry a few times with an increasing delay. Requests that
+// still can't be submitted, or that hit any other error, are failed back.
+//
+void XrdSysIOUring::Flush()
+{
+   static const int maxTries = 8;
+   int n, rc, eNum, tries = 0;
+
+   while((n = toSubmit))
+        {toSubmit = 0;
+         subMutex.UnLock();
+         do {rc = uringEnter(ringFD, n, 0, 0);} while(rc < 0 && errno == EINTR);
+         eNum = (rc < 0 ? errno : EAGAIN);
+         subMutex.Lock();
+         numEnter++;
+         if (rc > 0) {toSubmit += n - rc; tries = 0; continue;}
+         toSubmit += n;
+
+         if (eNum == EAGAIN || eNum == EBUSY)
+            {if (inFlight > toSubmit) break;
+             if (tries < maxTries)
+                {subMutex.UnLock();
+                 XrdSysTimer::Wait(1 << tries++);
+                 subMutex.Lock();
+                 continue;
+                }
+            }
+         Error("submit io_uring requests", eNum);
+         Fail(eNum);
+         tries = 0;
+        }
+   inSubmit = 0;
+}
+
+/******************************************************************************/
+/*                                R e a p e r                                 */
+/******************************************************************************/
+
+void XrdSysIOUring::Reaper()
+{
+   static const int maxReap = 64;
+   struct {__u64 udata; __s32 res;} done[maxReap];
+   struct io_uring_cqe *cqe;
+   unsigned int head, tail;
+   int i, n, rc;
+
+// Reap completions in batches. We update the head before calling back so
+// that the kernel can reuse the slots while we run the callbacks.
+//
+   do {head = *(rMap->cqHead);
+       tail = __atomic_load_n(rMap->cqTail, __ATOMIC_ACQUIRE);
+       if (head == tail)
+          {rc = uringEnter(ringFD, 0, 1, IORING_ENTER_GETEVENTS);
+           if (rc < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY)
+              {Error("wait for io_uring completions", errno);
+               XrdSysTimer::Wait(1000);
+              }
+           continue;
+          }
+
+       for (n = 0; head != tail && n < maxReap; n++, head++)
+           {cqe = &(rMap->cqes[head & rMap->cqMask]);
+            done[n].udata = cqe->user_data;
+            done[n].res   = cqe->res;
+           }
+       __atomic_store_n(rMap->cqHead, head, __ATOMIC_RELEASE);
+
+   // Account for the completed requests and submit anything left behind
+   // because the kernel could not take it earlier.
+   //
+       subMutex.Lock();
+       inFlight -= n;
+       if (toSubmit && !inSubmit) {inSubmit = 1; Flush();}
+       subMutex.UnLock();
+
+   // Complete each request
+   //
+       for (i = 0; i < n; i++) Done(done[i].udata, done[i].res);
+      } while(1);
+}
+
+/******************************************************************************/
+/*                                 S t a r t                                  */
+/******************************************************************************/
+
+int XrdSysIOUring::Start(int qdepth, const char **eWhat)
+{
+   static const int nProbe = 256;
+   struct io_uring_params parms;
+   struct io_uring_probe *probe;
+   XrdSysIOUringMap *mP;
+   pthread_t tid;
+   const char *what;
+   char *sq, *cq;
+   int rc;
+
+// Create the ring
+//
+   memset(&parms, 0, sizeof(parms));
+   if ((ringFD = uringSetup(qdepth, &parms)) < 0)
+      {rc = errno; what = "create io_uring"; goto Fatal;}
+   fcntl(ringFD, F_SETFD, FD_CLOEXEC);
+
+// Make sure the kernel supports the operations we need
+//
+   rc = sizeof(struct io_uring_probe) + nProbe*sizeof(struct io_uring_probe_op);
+   probe = (struct io_uring_probe *)calloc(1, rc);
+   rc = uringRegister(ringFD, IORING_REGISTER_PROBE, probe, nProbe);
+   if (rc < 0 || probe->last_op < IORING_OP_WRITE
+   ||  !(probe->ops[IORING_OP_READ ].flags & IO_URING_OP_SUPPORTED)
+   ||  !(probe->ops[IORING_OP_WRITE].flags & IO_URING_OP_SUPPORTED)
+   ||  !(probe->ops[IORING_OP_FSYNC].flags & IO_URING_OP_SUPPORTED))
+      {free(probe);
+       rc = ENOTSUP; what = "use io_uring read/write";
+       goto Fatal;
+      }
+   free(probe);
+
+// Map the submission and completion rings and the submission entries. Newer
+// kernels map both rings using a single mapping.
+//
+   rMap = mP = new XrdSysIOUringMap;
+   mP->sqLen  = parms.sq_off.array + parms.sq_entries * sizeof(unsigned int);
+   mP->cqLen  = parms.cq_off.cqes  + parms.cq_entries * sizeof(struct io_uring_cqe);
+   mP->sqeLen = parms.sq_entries * sizeof(struct io_uring_sqe);
+   if (parms.features & IORING_FEAT_SINGLE_MMAP)
+      {if (mP->cqLen > mP->sqLen) mP->sqLen = mP->cqLen;
+       mP->cqLen = mP->sqLen;
+      }
+   mP->sqMem = mmap(0, mP->sqLen, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE,
+                    ringFD, IORING_OFF_SQ_RING);
+   if (mP->sqMem != MAP_FAILED)
+      {if (parms.features & IORING_FEAT_SINGLE_MMAP) mP->cqMem = mP->sqMem;
+          else mP->cqMem = mmap(0, mP->cqLen, PROT_READ|PROT_WRITE,
+                                MAP_SHARED|MAP_POPULATE, ringFD, IORING_OFF_CQ_RING);
+      }
+   if (mP->cqMem != MAP_FAILED)
+      mP->sqes = (struct io_uring_sqe *)mmap(0, mP->sqeLen, PROT_READ|PROT_WRITE,
+                                MAP_SHARED|MAP_POPULATE, ringFD, IORING_OFF_SQES);
+   if (mP->sqMem == MAP_FAILED || mP->cqMem == MAP_FAILED
+   ||  (void *)mP->sqes == MAP_FAILED)
+      {rc = errno; what = "map io_uring"; goto Fatal;}
+
+// Locate the ring components
+//
+   sq = (char *)mP->sqMem; cq = (char *)mP->cqMem;
+   mP->sqHead  = (unsigned int *)(sq + parms.sq_off.head);
+   mP->sqTail  = (unsigned int *)(sq + parms.sq_off.tail);
+   mP->sqArray = (unsigned int *)(sq + parms.sq_off.array);
+   mP->sqMask  = *(unsigned int *)(sq + parms.sq_off.ring_mask);
+   mP->sqEnts  = parms.sq_entries;
+   mP->cqHead  = (unsigned int *)(cq + parms.cq_off.head);
+   mP->cqTail  = (unsigned int *)(cq + parms.cq_off.tail);
+   mP->cqMask  = *(unsigned int *)(cq + parms.cq_off.ring_mask);
+   mP->cqes    = (struct io_uring_cqe *)(cq + parms.cq_off.cqes);
+
+// We never allow more requests than the submission queue can hold. Since the
+// completion queue is at least as large, completions can never be dropped.
+//
+   maxFlight = static_cast<int>(mP->sqEnts);
+   sqNext    = *(mP->sqTail);
+
+// Start the reaper thread
+//
+   if ((rc = XrdSysThread::Run(&tid, XrdSysIOUring::Reap, (void *)this,
+                               0, "io_uring reaper")))
+      {what = "create io_uring reaper thread"; goto Fatal;}
+   return 0;
+
+// Undo whatever we have done so far
+//
+Fatal:
+   if (rMap) {delete rMap; rMap = 0;}
+   if (ringFD >= 0) {close(ringFD); ringFD = -1;}
+   if (eWhat) *eWhat = what;
+   return rc;
+}
+
+/******************************************************************************/
+/*                                S u b m i t                                 */
+/******************************************************************************/
+
+int XrdSysIOUring::Submit(const Request *reqs, int nreq)
+{
+   static const __u8 opCode[] = {IORING_OP_READ, IORING_OP_WRITE,
+                                 IORING_OP_FSYNC};
+   struct io_uring_sqe *sqe;
+   unsigned int idx;
+
+// Make sure we can take all of the requests. If not, the caller falls back.
+//
+   subMutex.Lock();
+   if (!rMap || inFlight + nreq > maxFlight)
+      {numFull++; subMutex.UnLock(); return 1;}
+
+// Fill out the submission entries
+//
+   for (int i = 0; i < nreq; i++)
+       {idx = sqNext & rMap->sqMask;
+        sqe = &(rMap->sqes[idx]);
+        memset(sqe, 0, sizeof(struct io_uring_sqe));
+        sqe->opcode    = opCode[reqs[i].opc];
+        sqe->fd        = reqs[i].fd;
+        if (reqs[i].opc != opFsync)
+           {sqe->off   = static_cast<__u64>(reqs[i].offset);
+            sqe->addr  = (__u64)(uintptr_t)reqs[i].buff;
+            sqe->len   = reqs[i].blen;
+           }
+        sqe->user_data = reqs[i].udata;
+        rMap->sqArray[idx] = idx;
+        sqNext++;
+       }
+   __atomic_store_n(rMap->sqTail, sqNext, __ATOMIC_RELEASE);
+   inFlight += nreq; toSubmit += nreq; numReqs += nreq;
+
+// If someone is already submitting, they will pick these requests up.
+// Otherwise, we become the submitter.
+//
+   if (!inSubmit) {inSubmit = 1; Flush();}
+   subMutex.UnLock();
+   return 0;
+}
+
+#else
+
+/******************************************************************************/
+/*                 S t u b s   f o r   N o   I O _ U R I N G                  */
+/******************************************************************************/
+
+void XrdSysIOUring::Reaper() {}
+
+int  XrdSysIOUring::Start(int qdepth, const char **eWhat)
+{
+   if (eWhat) *eWhat = "use io_uring";
+   return ENOTSUP;
+}
+
+int  XrdSysIOUring::Submit(const Request *reqs, int nreq) {numFull++; return 1;}
+#endif
@@ -0,0 +1,107 @@
+#ifndef __XRDSYSIOURING_HH__
+#define __XRDSYSIOURING_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d S y s I O U r i n g . h h                       */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include "XrdSys/XrdSysPthread.hh"
+
+/* XrdSysIOUring drives a Linux io_uring using the system calls directly.
+   Requests are placed in the submission queue and are submitted in batches:
+   whoever finds that no submission is in progress submits everything queued
+   so far, including requests added while it was in the kernel. A single
+   thread reaps completions and calls Done() with the request's user data and
+   result (a byte count or -errno).
+
+   Requests that the kernel refuses to take are failed back through Done()
+   with the error, possibly by the submitting thread. Temporary resource
+   shortages are retried first. Done() is never called with a lock held, so
+   it may submit new requests.
+
+   Derived classes supply Done() and Error(), the latter reports problems
+   with the ring itself. Once Start() succeeds the object must never be
+   deleted.
+*/
+
+class XrdSysIOUringMap;
+
+class XrdSysIOUring
+{
+public:
+
+enum Opc {opRead = 0, opWrite = 1, opFsync = 2};
+
+struct Request
+      {unsigned long long udata;    // Passed to Done()
+       long long          offset;   // Unused for opFsync
+       void              *buff;     // Unused for opFsync
+       unsigned int       blen;     // Unused for opFsync
+       int                fd;
+       Opc                opc;
+      };
+
+// Submit() queues all of the requests or none of them. It returns 0 when the
+// requests were queued and 1 when the ring can't take them, in which case the
+// caller should use another method.
+//
+       int          Submit(const Request *reqs, int nreq=1);
+
+// Start() creates the ring and its reaper thread. It returns 0 upon success
+// and an errno value otherwise; eWhat, if supplied, is set to the step that
+// failed.
+//
+       int          Start(int qdepth, const char **eWhat=0);
+
+// Statistical information (updated under the submission lock)
+//
+long long           numReqs;    // Number of requests queued
+long long           numEnter;   // Number of submission system calls
+long long           numFull;    // Number of times the ring was full
+
+                    XrdSysIOUring();
+virtual            ~XrdSysIOUring();
+
+protected:
+
+virtual void        Done(unsigned long long udata, int res) = 0;
+
+virtual void        Error(const char *what, int eNum) = 0;
+
+private:
+
+static void        *Reap(void *carg);
+       void         Reaper();
+       void         Fail(int eNum);
+       void         Flush();
+
+XrdSysMutex         subMutex;
+XrdSysIOUringMap   *rMap;
+int                 ringFD;
+int                 inFlight;   // subMutex: requests not yet reaped
+int                 maxFlight;  //           requests allowed in flight
+int                 toSubmit;   // subMutex: requests queued not submitted
+int                 inSubmit;   // subMutex: a thread is submitting
+unsigned int        sqNext;     // subMutex: our copy of the sq tail
+};
+#endif
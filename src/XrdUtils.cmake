@@ -24,6 +24,7 @@ add_library(
   #-----------------------------------------------------------------------------
   # XrdSys
   #-----------------------------------------------------------------------------
+  XrdSys/XrdSysCPU.cc           XrdSys/XrdSysCPU.hh
   XrdSys/XrdSysDNS.cc           XrdSys/XrdSysDNS.hh
   XrdSys/XrdSysDir.cc           XrdSys/XrdSysDir.hh
                                 XrdSys/XrdSysFD.hh
@@ -46,6 +47,7 @@ add_library(
                                 XrdSys/XrdSysIOEventsPollKQ.icc
                                 XrdSys/XrdSysIOEventsPollPoll.icc
                                 XrdSys/XrdSysIOEventsPollPort.icc
+  XrdSys/XrdSysIOUring.cc       XrdSys/XrdSysIOUring.hh
                                 XrdSys/XrdSysAtomics.hh
                                 XrdSys/XrdSysHeaders.hh
   XrdSys/XrdSysError.cc         XrdSys/XrdSysError.hh
@@ -179,7 +181,8 @@ add_library(
   XrdCks/XrdCksLoader.cc           XrdCks/XrdCksLoader.hh
   XrdCks/XrdCksManager.cc          XrdCks/XrdCksManager.hh
   XrdCks/XrdCksManOss.cc           XrdCks/XrdCksManOss.hh
-                                   XrdCks/XrdCksCalcadler32.hh
+  XrdCks/XrdCksCalcadler32.cc      XrdCks/XrdCksCalcadler32.hh
+                                   XrdCks/XrdCksCalccrc32C.hh
                                    XrdCks/XrdCksCalc.hh
                                    XrdCks/XrdCksData.hh
                                    XrdCks/XrdCks.hh
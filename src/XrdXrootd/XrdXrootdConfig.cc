@@ -1108,7 +1108,7 @@ int XrdXrootdProtocol::xlog(XrdOucStream &Config)
    Purpose:  Parse directive: monitor [all] [auth]  [flush [io] <sec>]
                                       [fstat <sec> [lfn] [ops] [ssq] [xfr <n>]
                                       [ident <sec>] [mbuff <sz>] [rbuff <sz>]
-                                      [rnums <cnt>] [window <sec>]
+                                      [queue <cnt>] [rnums <cnt>] [window <sec>]
                                       dest [Events] <host:port>
 
    Events: [files] [fstat] [info] [io] [iov] [redir] [user]
@@ -1127,6 +1127,9 @@ int XrdXrootdProtocol::xlog(XrdOucStream &Config)
          ident  <sec>       time (seconds, M, H) between identification records.
          mbuff  <sz>        size of message buffer for event trace monitoring.
          rbuff  <sz>        size of message buffer for redirection monitoring.
+         queue  <cnt>       maximum number of messages waiting to be sent by
+                            the emitter thread (default 1024). Zero sends
+                            messages synchronously.
          rnums  <cnt>       bumber of redirections monitoring streams.
          window <sec>       time (seconds, M, H) between timing marks.
          dest               specified routing information. Up to two dests
@@ -1152,6 +1155,7 @@ int XrdXrootdProtocol::xmon(XrdOucStream &Config)
     int i, monFlash = 0, monFlush=0, monMBval=0, monRBval=0, monWWval=0;
     int    monIdent = 3600, xmode=0, monMode[2] = {0, 0}, mrType, *flushDest;
     int    monRnums = 0, monFSint = 0, monFSopt = 0, monFSion = 0;
+    int    monQsize = -1;
     int    haveWord = 0;
 
     while(haveWord || (val = Config.GetWord()))
@@ -1209,6 +1213,14 @@ int XrdXrootdProtocol::xmon(XrdOucStream &Config)
                  if (XrdOuca2x::a2tm(eDest,"monitor ident",val,
                                            &monIdent,0)) return 1;
                 }
+          else if (!strcmp("queue", val))
+                {if (!(val = Config.GetWord()))
+                    {eDest.Emsg("Config", "monitor queue value not specified");
+                     return 1;
+                    }
+                 if (XrdOuca2x::a2i(eDest,"monitor queue",val, &monQsize,0,
+                                    1048576)) return 1;
+                }
           else if (!strcmp("rnums", val))
                 {if (!(val = Config.GetWord()))
                     {eDest.Emsg("Config", "monitor rnums value not specified");
@@ -1286,7 +1298,7 @@ int XrdXrootdProtocol::xmon(XrdOucStream &Config)
 //
    XrdXrootdMonitor::Defaults(monMBval, monRBval, monWWval,
                               monFlush, monFlash, monIdent, monRnums,
-                              monFSint, monFSopt, monFSion);
+                              monFSint, monFSopt, monFSion, monQsize);
 
    if (monDest[0]) monMode[0] |= (monMode[0] ? xmode : XROOTD_MON_FILE|xmode);
    if (monDest[1]) monMode[1] |= (monMode[1] ? xmode : XROOTD_MON_FILE|xmode);
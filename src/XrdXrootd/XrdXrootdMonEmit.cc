@@ -0,0 +1,237 @@
+/******************************************************************************/
+/*                                                                            */
+/*                   X r d X r o o t d M o n E m i t . c c                    */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/uio.h>
+
+#include "XrdNet/XrdNetMsg.hh"
+#include "XrdSys/XrdSysAtomics.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdXrootd/XrdXrootdMonEmit.hh"
+#include "XrdXrootd/XrdXrootdTrace.hh"
+
+/******************************************************************************/
+/*                               G l o b a l s                                */
+/******************************************************************************/
+
+extern XrdOucTrace       *XrdXrootdTrace;
+
+XrdXrootdMonEmit         *XrdXrootdMonEmit::Emitter = 0;
+
+/******************************************************************************/
+/*                     T h r e a d   I n t e r f a c e s                      */
+/******************************************************************************/
+
+void *XrdXrootdMonEmitter(void *carg)
+{
+   XrdXrootdMonEmit *eP = (XrdXrootdMonEmit *)carg;
+
+   eP->Drain();
+   return (void *)0;
+}
+
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdXrootdMonEmit::XrdXrootdMonEmit(XrdSysError *eP, int qsize,
+                                   XrdNetMsg  *dest1, int mode1,
+                                   XrdNetMsg  *dest2, int mode2)
+                 : numSent(0), numCall(0), qDepth(0), qDMax(0), numDrop(0),
+                   eDest(eP), Dest1(dest1), Dest2(dest2),
+                   Mode1(mode1), Mode2(mode2), qHead(0), qWake(0),
+                   qTail(0), qIdle(0)
+{
+   unsigned int i;
+
+// The queue size is a power of two and each slot starts out as free, that is,
+// its sequence number is the position that will be stored into it.
+//
+   qRing = new QSlot[qsize];
+   qMask = qsize - 1;
+   for (i = 0; i <= qMask; i++) {qRing[i].seq = i; qRing[i].data = 0;}
+}
+
+/******************************************************************************/
+/*                                 D r a i n                                  */
+/******************************************************************************/
+
+void XrdXrootdMonEmit::Drain()
+{
+#ifdef HAVE_ATOMICS
+   QSlot *sP;
+   int i, n;
+
+// Take whatever has been queued, send it, and wait when there is nothing left
+//
+   while(1)
+        {qDepth = static_cast<int>(AtomicGet(qTail) - qHead);
+         if (qDepth > qDMax) qDMax = qDepth;
+
+         for (n = 0; n < maxBatch; n++)
+             {sP = &qRing[qHead & qMask];
+              if (AtomicGet(sP->seq) != qHead+1) break;
+              bVec[n] = *sP;
+              AtomicCAS(sP->seq, qHead+1, qHead+qMask+1);
+              qHead++;
+             }
+
+         if (n)
+            {if (Dest1) Send(Dest1, Mode1, n);
+             if (Dest2) Send(Dest2, Mode2, n);
+             for (i = 0; i < n; i++) free(bVec[i].data);
+             continue;
+            }
+
+// Announce that we are about to wait and then recheck the queue as a datagram
+// may have arrived in the meantime. A producer that sees us idle clears the
+// flag and posts the semaphore, so if we can't clear it ourselves we must
+// consume that post.
+//
+         AtomicCAS(qIdle, 0, 1);
+         if (AtomicGet(qRing[qHead & qMask].seq) != qHead+1) qWake.Wait();
+            else if (!AtomicCAS(qIdle, 1, 0)) qWake.Wait();
+        }
+#endif
+}
+
+/******************************************************************************/
+/*                                 Q u e u e                                  */
+/******************************************************************************/
+
+bool XrdXrootdMonEmit::Queue(int monMode, const void *buff, int blen)
+{
+#ifdef HAVE_ATOMICS
+   QSlot *sP;
+   char  *data;
+   unsigned int pos;
+   int dif;
+
+// Copy the datagram as the caller reuses its buffer as soon as we return
+//
+   if (!(data = (char *)malloc(blen))) {AtomicInc(numDrop); return false;}
+   memcpy(data, buff, blen);
+
+// Claim the slot at the tail. The slot is free when its sequence equals our
+// position; when it is behind, the emitter has not drained it and the queue
+// is full. Otherwise another producer got there first and we try again.
+//
+   pos = AtomicGet(qTail);
+   while(1)
+        {sP  = &qRing[pos & qMask];
+         dif = static_cast<int>(AtomicGet(sP->seq) - pos);
+         if (!dif)
+            {if (AtomicCAS(qTail, pos, pos+1)) break;
+             pos = AtomicGet(qTail);
+            }
+            else if (dif < 0) {free(data); AtomicInc(numDrop); return false;}
+                    else pos = AtomicGet(qTail);
+        }
+
+// Fill the slot and publish it to the emitter
+//
+   sP->mode = monMode;
+   sP->blen = blen;
+   sP->data = data;
+   AtomicCAS(sP->seq, pos, pos+1);
+
+// Wake up the emitter if it is waiting for something to do
+//
+   if (AtomicGet(qIdle) && AtomicCAS(qIdle, 1, 0)) qWake.Post();
+   return true;
+#else
+   return false;
+#endif
+}
+
+/******************************************************************************/
+/*                                 S t a r t                                  */
+/******************************************************************************/
+
+XrdXrootdMonEmit *XrdXrootdMonEmit::Start(XrdSysError *eP, int qsize,
+                                          XrdNetMsg  *dest1, int mode1,
+                                          XrdNetMsg  *dest2, int mode2)
+{
+#ifdef HAVE_ATOMICS
+   XrdXrootdMonEmit *emP;
+   pthread_t tid;
+   int rc, qsz = 64;
+
+// Round the queue size up to a power of two
+//
+   while(qsz < qsize) qsz <<= 1;
+
+// Create the emitter and start its thread
+//
+   emP = new XrdXrootdMonEmit(eP, qsz, dest1, mode1, dest2, mode2);
+   if ((rc = XrdSysThread::Run(&tid, XrdXrootdMonEmitter, (void *)emP,
+                               0, "monitor emitter")))
+      {eP->Emsg("Monitor", rc, "create monitor emitter thread");
+       return 0; // The emitter object is leaked as it is never deleted
+      }
+
+// All done
+//
+   Emitter = emP;
+   return emP;
+#else
+   return 0;
+#endif
+}
+
+/******************************************************************************/
+/*                       P r i v a t e   M e t h o d s                        */
+/******************************************************************************/
+/******************************************************************************/
+/*                                  S e n d                                   */
+/******************************************************************************/
+
+void XrdXrootdMonEmit::Send(XrdNetMsg *dest, int mode, int n)
+{
+#ifndef NODEBUG
+   const char *TraceID = "MonEmit";
+#endif
+   struct iovec ioV[maxBatch];
+   int i, k = 0, rc;
+
+// Collect the datagrams that go to this destination
+//
+   for (i = 0; i < n; i++)
+       if (bVec[i].mode & mode)
+          {ioV[k].iov_base = bVec[i].data;
+           ioV[k].iov_len  = bVec[i].blen;
+           k++;
+          }
+   if (!k) return;
+
+// Send them off
+//
+   rc = dest->SendBatch(ioV, k);
+   numCall++;
+   if (rc > 0) numSent += rc;
+   TRACE(DEBUG, k <<" datagrams queued; " <<rc <<" sent");
+}
@@ -0,0 +1,97 @@
+#ifndef __XRDXROOTDMONEMIT_HH__
+#define __XRDXROOTDMONEMIT_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                   X r d X r o o t d M o n E m i t . h h                    */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include "XrdSys/XrdSysPthread.hh"
+
+/* XrdXrootdMonEmit sends monitoring datagrams on behalf of the threads that
+   produce them. Producers copy a finished datagram into a bounded lock-free
+   queue and return; a single emitter thread drains the queue and sends
+   whatever has accumulated to each destination with as few system calls as
+   possible (see XrdNetMsg::SendBatch()). When the queue is full the datagram
+   is dropped and counted; monitoring must never hold up a client request.
+
+   The emitter requires atomics. When they are not available Start() fails
+   and datagrams are sent synchronously, as before.
+*/
+
+class XrdNetMsg;
+class XrdSysError;
+
+class XrdXrootdMonEmit
+{
+public:
+
+static XrdXrootdMonEmit *Emitter;   // The emitter in use, if any
+
+       void              Drain();
+
+       bool              Queue(int monMode, const void *buff, int blen);
+
+static XrdXrootdMonEmit *Start(XrdSysError *eP, int qsize,
+                               XrdNetMsg  *dest1, int mode1,
+                               XrdNetMsg  *dest2, int mode2);
+
+// Statistical information (read without locks so values may lag)
+//
+long long                numSent;   // Emitter: datagrams sent
+long long                numCall;   // Emitter: batch send calls
+int                      qDepth;    // Emitter: queue depth at last drain
+int                      qDMax;     // Emitter: maximum queue depth
+long long                numDrop;   // Atomic:  datagrams dropped
+
+private:
+                         XrdXrootdMonEmit(XrdSysError *eP, int qsize,
+                                          XrdNetMsg  *dest1, int mode1,
+                                          XrdNetMsg  *dest2, int mode2);
+                        ~XrdXrootdMonEmit() {} // Never deleted
+
+       void              Send(XrdNetMsg *dest, int mode, int n);
+
+struct QSlot {unsigned int seq;     // Slot sequence (see Queue())
+              int          mode;    // Destination mode of the datagram
+              int          blen;    // Length of the datagram
+              char        *data;    // The datagram (malloc'd copy)
+             };
+
+static const int         maxBatch = 128; // Datagrams drained at a time
+
+XrdSysError             *eDest;
+XrdNetMsg               *Dest1;
+XrdNetMsg               *Dest2;
+int                      Mode1;
+int                      Mode2;
+QSlot                   *qRing;
+unsigned int             qMask;
+unsigned int             qHead;     // Emitter only
+XrdSysSemaphore          qWake;
+QSlot                    bVec[maxBatch];
+char                     pad1[64];
+unsigned int             qTail;     // Atomic: next slot to fill
+int                      qIdle;     // Atomic: emitter waiting on qWake
+char                     pad2[64];
+};
+#endif
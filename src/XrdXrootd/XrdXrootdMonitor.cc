@@ -43,10 +43,12 @@
 #include "XrdNet/XrdNetMsg.hh"
 #include "XrdOuc/XrdOucEnv.hh"
 #include "XrdOuc/XrdOucUtils.hh"
+#include "XrdSys/XrdSysAtomics.hh"
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysPlatform.hh"
 
 #include "Xrd/XrdScheduler.hh"
+#include "XrdXrootd/XrdXrootdMonEmit.hh"
 #include "XrdXrootd/XrdXrootdMonitor.hh"
 #include "XrdXrootd/XrdXrootdMonFile.hh"
 #include "XrdXrootd/XrdXrootdTrace.hh"
@@ -74,6 +76,9 @@ XrdXrootdMonitor::MonRdrBuff
 XrdXrootdMonitor::MonRdrBuff
                   *XrdXrootdMonitor::rdrMP      = 0;
 XrdSysMutex        XrdXrootdMonitor::rdrMutex;
+unsigned int       XrdXrootdMonitor::rdrNext    = 0;
+XrdXrootdMonEmit  *XrdXrootdMonitor::emitQ      = 0;
+int                XrdXrootdMonitor::emitQsz    = 1024;
 int                XrdXrootdMonitor::monBlen    = 0;
 int                XrdXrootdMonitor::lastEnt    = 0;
 int                XrdXrootdMonitor::lastRnt    = 0;
@@ -443,7 +448,7 @@ void XrdXrootdMonitor::Defaults(char *dest1, int mode1, char *dest2, int mode2)
 
 void XrdXrootdMonitor::Defaults(int msz,   int rsz,   int wsz,
                                 int flush, int flash, int idt, int rnm,
-                                int fsint, int fsopt, int fsion)
+                                int fsint, int fsopt, int fsion, int qsz)
 {
 
 // Set default window size and flush time
@@ -452,6 +457,7 @@ void XrdXrootdMonitor::Defaults(int msz,   int rsz,   int wsz,
    autoFlush  = (flush <= 0 ? 600 : flush);
    autoFlash  = (flash <= 0 ?   0 : flash);
    monIdent   = (idt   <  0 ?   0 : idt);
+   emitQsz    = (qsz   <  0 ? 1024 : qsz);
    rdrNum     = (rnm   <= 0 || rnm > rdrMax ? 3 : rnm);
    rdrWin     = (sizeWindow > 16777215 ? 16777215 : sizeWindow);
    rdrWin     = htonl(rdrWin);
@@ -530,14 +536,15 @@ void XrdXrootdMonitor::Dup(XrdXrootdMonTrace *mrec)
   
 XrdXrootdMonitor::MonRdrBuff *XrdXrootdMonitor::Fetch()
 {
-   MonRdrBuff *bP;
+   unsigned int n;
 
-// Get the next available stream and promote another one
+// Get the next available stream in round-robin fashion
 //
-   rdrMutex.Lock();
-   if ((bP = rdrMP)) rdrMP = rdrMP->Next;
-   rdrMutex.UnLock();
-   return bP;
+   if (!rdrMP) return 0;
+   AtomicBeg(rdrMutex);
+   n = AtomicInc(rdrNext);
+   AtomicEnd(rdrMutex);
+   return &rdrMon[n % rdrNum];
 }
 
 /******************************************************************************/
@@ -594,6 +601,12 @@ int XrdXrootdMonitor::Init(XrdScheduler *sp,    XrdSysError *errp,
           }
       }
 
+// Start the emitter thread unless datagrams are to be sent synchronously
+//
+   if (emitQsz > 0)
+      emitQ = XrdXrootdMonEmit::Start(eDest, emitQsz, InetDest1, monMode1,
+                                                      InetDest2, monMode2);
+
 // If there is a destination that is only collecting file events, then
 // allocate a global monitor object but don't start the timer just yet.
 //
@@ -667,9 +680,9 @@ kXR_unt32 XrdXrootdMonitor::GetDictID()
 
 // Assign a unique ID for this entry
 //
-   seqMutex.Lock();
-   mySeqID = monSeqID++;
-   seqMutex.UnLock();
+   AtomicBeg(seqMutex);
+   mySeqID = AtomicInc(monSeqID);
+   AtomicEnd(seqMutex);
 
 // Return the ID
 //
@@ -905,9 +918,9 @@ void XrdXrootdMonitor::fillHeader(XrdXrootdMonHeader *hdr,
 
 // Generate a new sequence number
 //
-   seqMutex.Lock();
-   myseq = 0x00ff & (seq++);
-   seqMutex.UnLock();
+   AtomicBeg(seqMutex);
+   myseq = 0x00ff & AtomicInc(seq);
+   AtomicEnd(seqMutex);
 
 // Fill in the header
 //
@@ -1053,6 +1066,16 @@ int XrdXrootdMonitor::Send(int monMode, void *buff, int blen)
     static XrdSysMutex sendMutex;
     int rc1, rc2;
 
+// When we have an emitter, it sends the datagram on our behalf. A datagram
+// that can't be queued is dropped, which the emitter counts.
+//
+    if (emitQ)
+       {if (!(monMode & (monMode1 | monMode2))) return 0;
+        return (emitQ->Queue(monMode, buff, blen) ? 0 : 1);
+       }
+
+// Send the datagram ourselves
+//
     sendMutex.Lock();
     if (monMode & monMode1 && InetDest1)
        {rc1  = InetDest1->Send((char *)buff, blen);
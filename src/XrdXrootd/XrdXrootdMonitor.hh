@@ -62,6 +62,7 @@
 
 class XrdScheduler;
 class XrdNetMsg;
+class XrdXrootdMonEmit;
 class XrdXrootdMonFile;
   
 /******************************************************************************/
@@ -111,7 +112,8 @@ inline void              Add_wr(kXR_unt32 dictid,
 static void              Defaults(char *dest1, int m1, char *dest2, int m2);
 static void              Defaults(int msz,     int rsz,     int wsz,
                                   int flush,   int flash,   int iDent, int rnm,
-                                  int fsint=0, int fsopt=0, int fsion=0);
+                                  int fsint=0, int fsopt=0, int fsion=0,
+                                  int qsz=-1);
 
 static void              Ident() {Send(-1, idRec, idLen);}
 
@@ -202,6 +204,7 @@ struct MonRdrBuff
       }                   rdrMon[rdrMax];
 static MonRdrBuff        *rdrMP;
 static XrdSysMutex        rdrMutex;
+static unsigned int       rdrNext;
 
 inline void              Add_io(kXR_unt32 duid, kXR_int32 blen, kXR_int64 offs)
                                {if (lastWindow != currWindow) Mark();
@@ -237,6 +240,8 @@ static XrdNetMsg         *InetDest1;
 static char              *Dest2;
 static int                monMode2;
 static XrdNetMsg         *InetDest2;
+static XrdXrootdMonEmit  *emitQ;
+static int                emitQsz;
        XrdXrootdMonBuff  *monBuff;
 static int                monBlen;
        int                nextEnt;
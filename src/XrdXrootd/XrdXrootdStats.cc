@@ -31,6 +31,7 @@
   
 #include "Xrd/XrdStats.hh"
 #include "XrdSfs/XrdSfsInterface.hh"
+#include "XrdXrootd/XrdXrootdMonEmit.hh"
 #include "XrdXrootd/XrdXrootdResponse.hh"
 #include "XrdXrootd/XrdXrootdStats.hh"
  
@@ -88,7 +89,9 @@ int XrdXrootdStats::Stats(char *buff, int blen, int do_sync)
    "<sig><ok>%d</ok><bad>%d</bad><ign>%d</ign></sig>"
    "<aio><num>%lld</num><max>%d</max><rej>%lld</rej></aio>"
    "<err>%d</err><rdr>%lld</rdr><dly>%d</dly>"
-   "<lgn><num>%d</num><af>%d</af><au>%d</au><ua>%d</ua></lgn></stats>";
+   "<lgn><num>%d</num><af>%d</af><au>%d</au><ua>%d</ua></lgn>"
+   "<mon><pkt>%lld</pkt><drop>%lld</drop><qd>%d</qd><qmax>%d</qmax></mon>"
+   "</stats>";
 //                                   1 2 3 4 5 6 7 8
    static const long long LLMax = 0x7fffffffffffffffLL;
    static const int       INMax = 0x7fffffff;
@@ -104,10 +107,22 @@ int XrdXrootdStats::Stats(char *buff, int blen, int do_sync)
                       INMax, INMax,
                       INMax, INMax, INMax,
                       LLMax, INMax, LLMax, INMax, LLMax, INMax,
-                      INMax, INMax, INMax, INMax);
+                      INMax, INMax, INMax, INMax,
+                      LLMax, LLMax, INMax, INMax);
        return len + (fsP ? fsP->getStats(0,0) : 0);
       }
 
+// Get the monitoring emitter statistics, if we have an emitter. These are
+// not locked and may lag a bit.
+//
+   XrdXrootdMonEmit *emP = XrdXrootdMonEmit::Emitter;
+   long long monSent = 0, monDrop = 0;
+   int       monQD   = 0, monQDM  = 0;
+
+   if (emP) {monSent = emP->numSent; monDrop = emP->numDrop;
+             monQD   = emP->qDepth;  monQDM  = emP->qDMax;
+            }
+
 // Format our statistics
 //
    statsMutex.Lock();
@@ -118,7 +133,8 @@ int XrdXrootdStats::Stats(char *buff, int blen, int do_sync)
                   putfCnt, miscCnt,
                   aokSCnt, badSCnt, ignSCnt,
                   AsyncNum, AsyncMax, AsyncRej, errorCnt, redirCnt, stallCnt,
-                  LoginAT, AuthBad, LoginAU, LoginUA);
+                  LoginAT, AuthBad, LoginAU, LoginUA,
+                  monSent, monDrop, monQD, monQDM);
    statsMutex.UnLock();
 
 // Now include filesystem statistics and return
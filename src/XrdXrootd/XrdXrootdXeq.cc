@@ -2180,6 +2180,12 @@ int XrdXrootdProtocol::do_ReadV()
    if (totSZ > 0x7fffffffLL)
       return Response.Send(kXR_NoMemory, "Total readv transfer is too large");
 
+// If all of the files allow it, send the data directly from the files using
+// sendfile(). This avoids copying it through the staging buffer.
+//
+   if (FTab && (k = do_ReadVsf(rdVec, rdVBreak, static_cast<int>(totSZ))) != 1)
+      return k;
+
 // Calculate the transfer unit which will be the smaller of the maximum
 // transfer unit and the actual amount we need to transfer.
 //
@@ -2270,6 +2276,89 @@ int XrdXrootdProtocol::do_ReadV()
    return (Quantum != Qleft ? Response.Send(argp->buff, Quantum-Qleft) : 0);
 }
 
+/******************************************************************************/
+/*                             d o _ R e a d V s f                            */
+/******************************************************************************/
+
+// Send the readv response as a single sendfile vector consisting of the
+// segment headers, taken from the request list in argp->buff, interleaved
+// with the file ranges. Returns 1 if sendfile cannot be used.
+  
+int XrdXrootdProtocol::do_ReadVsf(XrdOucIOVec *rdVec, int rdVecNum, int totSZ)
+{
+   const int hdrSZ = sizeof(readahead_list);
+   struct readahead_list *raVec = (readahead_list *)argp->buff;
+   XrdXrootdFile *vFile = 0;
+   XrdLink::sfVec *sfVec;
+   int rvMon = Monitor.InOut();
+   int ioMon = (rvMon > 1);
+   int currFH, i, k, rc, rdVBeg, rdVXfr, sfN = 1;
+   char vType = (ioMon ? XROOTD_MON_READU : XROOTD_MON_READV);
+// Sendfile is only worth it when segments are not too small. The response
+// must also be ours as a bridge would need to reframe the segments.
+//
+   if (!XrdLink::sfOK || !Response.isOurs()
+   ||  (totSZ - rdVecNum*hdrSZ)/rdVecNum < as_minsfsz) return 1;
+#ifdef __solaris__
+   if (rdVecNum*2+1 > XrdOucSFVec::sfMax) return 1;
+#endif
+
+// Make sure each file can be sent via sendfile and that no segment extends
+// past the end of its file (sendfile cannot report a short read).
+//
+   currFH = rdVec[0].info;
+   for (i = 0; i < rdVecNum; i++)
+       {if (!vFile || rdVec[i].info != currFH)
+           {currFH = rdVec[i].info;
+            if (!(vFile = FTab->Get(currFH)) || !vFile->sfEnabled
+            ||  vFile->fdNum < 0 || vFile->isMMapped) return 1;
+           }
+        if (rdVec[i].offset < 0
+        ||  rdVec[i].offset + rdVec[i].size > vFile->Stats.fSize) return 1;
+       }
+
+// Construct the sendfile vector. Element zero is reserved for the response
+// header. The segment headers are identical to the request elements.
+//
+   sfVec = new XrdLink::sfVec[rdVecNum*2+1];
+   rvSeq++;
+   rdVBeg = rdVXfr = 0; currFH = rdVec[0].info; vFile = FTab->Get(currFH);
+   for (i = 0; i <= rdVecNum; i++)
+       {if (i == rdVecNum || rdVec[i].info != currFH)
+           {vFile->Stats.rvOps(rdVXfr, i - rdVBeg);
+            if (rvMon)
+               {Monitor.Agent->Add_rv(vFile->Stats.FileID, htonl(rdVXfr),
+                                      htons(i - rdVBeg), rvSeq, vType);
+                if (ioMon) for (k = rdVBeg; k < i; k++)
+                    Monitor.Agent->Add_rd(vFile->Stats.FileID,
+                            htonl(rdVec[k].size), htonll(rdVec[k].offset));
+               }
+            if (i == rdVecNum) break;
+            rdVBeg = i; rdVXfr = 0; currFH = rdVec[i].info;
+            vFile = FTab->Get(currFH);
+           }
+        sfVec[sfN].buffer = (char *)&raVec[i];
+        sfVec[sfN].sendsz = hdrSZ;
+        sfVec[sfN].fdnum  = -1;
+        sfN++;
+        if (rdVec[i].size)
+           {sfVec[sfN].offset = static_cast<off_t>(rdVec[i].offset);
+            sfVec[sfN].sendsz = rdVec[i].size;
+            sfVec[sfN].fdnum  = vFile->fdNum;
+            sfN++;
+           }
+        rdVXfr += rdVec[i].size;
+        TRACEP(FS,"fh=" <<currFH <<" readV sf " <<rdVec[i].size <<'@'
+                        <<rdVec[i].offset);
+       }
+
+// Send off the whole response in one go
+//
+   rc = Response.Send(sfVec, sfN, totSZ);
+   delete [] sfVec;
+   return rc;
+}
+
 /******************************************************************************/
 /*                                 d o _ R m                                  */
 /******************************************************************************/
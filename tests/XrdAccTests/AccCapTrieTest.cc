@@ -0,0 +1,199 @@
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+#include <cppunit/extensions/HelperMacros.h>
+#include "XrdAcc/XrdAccCapability.hh"
+
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Declaration
+//------------------------------------------------------------------------------
+class AccCapTrieTest: public CppUnit::TestCase
+{
+  public:
+    CPPUNIT_TEST_SUITE( AccCapTrieTest );
+      CPPUNIT_TEST( FirstMatchTest );
+      CPPUNIT_TEST( RandomListTest );
+    CPPUNIT_TEST_SUITE_END();
+    void FirstMatchTest();
+    void RandomListTest();
+};
+CPPUNIT_TEST_SUITE_REGISTRATION( AccCapTrieTest );
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // A small alphabet of path components so that rules share prefixes, and
+  // prefixes that end in the middle of a component
+  //----------------------------------------------------------------------------
+  const char *comps[] = { "a", "ab", "abc", "b", "data", "dat", "store",
+                          "user", "x" };
+  const int   ncomps  = sizeof( comps ) / sizeof( comps[0] );
+
+  std::string RandomPath()
+  {
+    std::string path;
+    int depth = rand() % 5;
+    for( int i = 0; i < depth; ++i )
+    {
+      path += '/';
+      path += comps[rand() % ncomps];
+    }
+    if( path.empty() || rand() % 3 == 0 ) path += '/';
+    if( rand() % 4 == 0 ) path.erase( path.size() - 1 - rand() % path.size() / 2 );
+    return path.empty() ? std::string( "/" ) : path;
+  }
+
+  XrdAccCapability *NewCap( const std::string &path, int pp, int np )
+  {
+    XrdAccPrivCaps caps;
+    caps.pprivs = (XrdAccPrivs)pp;
+    caps.nprivs = (XrdAccPrivs)np;
+    return new XrdAccCapability( const_cast<char*>( path.c_str() ), caps );
+  }
+
+  XrdAccCapability *RandomCap( std::vector<std::string> &paths )
+  {
+    std::string path;
+    if( !paths.empty() && rand() % 5 == 0 )
+      path = paths[rand() % paths.size()];  // a duplicate
+    else
+      path = RandomPath();
+    paths.push_back( path );
+    return NewCap( path, rand() & XrdAccPriv_All,
+                   rand() % 4 ? 0 : rand() & XrdAccPriv_All );
+  }
+
+  //----------------------------------------------------------------------------
+  // Build a list of n rules; with templates, some entries refer to one of them
+  //----------------------------------------------------------------------------
+  XrdAccCapability *RandomList( int n, std::vector<std::string> &paths,
+                                std::vector<XrdAccCapability*> *tmpl = 0 )
+  {
+    XrdAccCapability *head = 0, *tail = 0, *cp;
+    for( int i = 0; i < n; ++i )
+    {
+      if( tmpl && !tmpl->empty() && rand() % 6 == 0 )
+        cp = new XrdAccCapability( (*tmpl)[rand() % tmpl->size()] );
+      else
+        cp = RandomCap( paths );
+      if( tail ) tail->Add( cp );
+      else head = cp;
+      tail = cp;
+    }
+    return head;
+  }
+
+  struct Result
+  {
+    int rc;
+    int pp;
+    int np;
+  };
+
+  Result Query( XrdAccCapability *list, const std::string &path )
+  {
+    XrdAccPrivCaps caps;
+    Result r;
+    r.rc = list->Privs( caps, path.c_str(), path.size() );
+    r.pp = caps.pprivs;
+    r.np = caps.nprivs;
+    return r;
+  }
+
+  //----------------------------------------------------------------------------
+  // Ask the list about every path before and after compiling it
+  //----------------------------------------------------------------------------
+  void Compare( XrdAccCapability *list, const std::vector<std::string> &paths )
+  {
+    std::vector<Result> linear;
+    for( size_t i = 0; i < paths.size(); ++i )
+      linear.push_back( Query( list, paths[i] ) );
+
+    list->Compile();
+
+    for( size_t i = 0; i < paths.size(); ++i )
+    {
+      Result r = Query( list, paths[i] );
+      std::string msg = "path " + paths[i];
+      CPPUNIT_ASSERT_EQUAL_MESSAGE( msg, linear[i].rc, r.rc );
+      CPPUNIT_ASSERT_EQUAL_MESSAGE( msg, linear[i].pp, r.pp );
+      CPPUNIT_ASSERT_EQUAL_MESSAGE( msg, linear[i].np, r.np );
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// The first rule in list order that is a prefix of the path applies, not the
+// longest one
+//------------------------------------------------------------------------------
+void AccCapTrieTest::FirstMatchTest()
+{
+  XrdAccCapability *list = NewCap( "/store/", XrdAccPriv_Read, 0 );
+  list->Add( NewCap( "/store/user/", XrdAccPriv_All, 0 ) );
+  list->Next()->Add( NewCap( "/store/user/", XrdAccPriv_Lookup, 0 ) );
+
+  std::vector<std::string> paths;
+  paths.push_back( "/store/user/file" );
+  paths.push_back( "/store" );
+  paths.push_back( "/other" );
+  Compare( list, paths );
+
+  Result r = Query( list, "/store/user/file" );
+  CPPUNIT_ASSERT_EQUAL( 1, r.rc );
+  CPPUNIT_ASSERT_EQUAL( (int)XrdAccPriv_Read, r.pp );
+  CPPUNIT_ASSERT_EQUAL( 0, Query( list, "/store" ).rc );
+  delete list;
+}
+
+//------------------------------------------------------------------------------
+// Random lists with templates, shared prefixes and duplicate paths
+//------------------------------------------------------------------------------
+void AccCapTrieTest::RandomListTest()
+{
+  srand( 1 );
+  for( int round = 0; round < 300; ++round )
+  {
+    std::vector<std::string>        paths;
+    std::vector<XrdAccCapability*>  tmpl;
+    int ntmpl = rand() % 3;
+    for( int i = 0; i < ntmpl; ++i )
+      tmpl.push_back( RandomList( 1 + rand() % 8, paths ) );
+    XrdAccCapability *list = RandomList( 1 + rand() % 40, paths, &tmpl );
+
+    // Besides the rule paths, ask about paths below and above them and
+    // about random ones
+    size_t nrules = paths.size();
+    for( size_t i = 0; i < nrules; ++i )
+    {
+      paths.push_back( paths[i] + "file" );
+      paths.push_back( paths[i] + "/" + comps[rand() % ncomps] );
+      if( paths[i].size() > 1 )
+        paths.push_back( paths[i].substr( 0, paths[i].size() - 1 ) );
+    }
+    for( int i = 0; i < 50; ++i )
+      paths.push_back( RandomPath() );
+
+    Compare( list, paths );
+
+    delete list;
+    for( size_t i = 0; i < tmpl.size(); ++i )
+      delete tmpl[i];
+  }
+}
@@ -0,0 +1,293 @@
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d A c c B e n c h . c c                         */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+// Authorization micro-benchmark. An authdb shaped like that of a large site
+// is generated: a default read-only list of datasets, a template for the
+// common areas, a VO group with one rule per physics group area and a few
+// rules for each of many users. The default authorization object is then
+// asked about a mix of paths by increasing numbers of threads. Finally, the
+// same paths are looked up in a list of all of the rules, once scanning the
+// list and once through the compiled prefix trie.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "XrdVersion.hh"
+
+#include "XrdBench.hh"
+
+#include "XrdAcc/XrdAccAuthorize.hh"
+#include "XrdAcc/XrdAccCapability.hh"
+#include "XrdNet/XrdNetAddr.hh"
+#include "XrdOuc/XrdOucEnv.hh"
+#include "XrdSec/XrdSecEntity.hh"
+#include "XrdSys/XrdSysLogger.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+extern XrdAccAuthorize *XrdAccDefaultAuthorizeObject(XrdSysLogger   *lp,
+                                                     const char     *cfn,
+                                                     const char     *parm,
+                                                     XrdVersionInfo &myVer);
+
+/******************************************************************************/
+/*                          L o c a l   S t a t i c s                         */
+/******************************************************************************/
+
+namespace
+{
+const char *MeMe = "xrdaccbench: ";
+int         nUsers = 2000;  // Users with their own rules
+int         nAreas = 2000;  // Group areas in the VO rule
+int         nSets  = 1000;  // Datasets readable by everyone
+int         nIters = 200000;
+int         nPaths = 4096;
+
+XrdAccAuthorize *Authorize;
+char           **pTab;
+int             *uTab;
+int              nGrant;
+
+XrdSysMutex cntMutex;
+
+/******************************************************************************/
+/*                               M a k e D B                                  */
+/******************************************************************************/
+
+bool MakeDB(const char *dbfn, const char *cfn)
+{
+   FILE *fP;
+   int i;
+
+   if (!(fP = fopen(cfn, "w"))) {perror(cfn); return false;}
+   fprintf(fP, "acc.authdb %s\nacc.audit none\n", dbfn);
+   fclose(fP);
+
+   if (!(fP = fopen(dbfn, "w"))) {perror(dbfn); return false;}
+
+   fprintf(fP, "t common /store/mc rl /store/data rl /store/temp/user rl\n");
+
+   fprintf(fP, "u *");
+   for (i = 0; i < nSets; i++)
+       fprintf(fP, " \\\n  /store/data/Run%04d/dataset%04d/ rl", i/10, i);
+   fprintf(fP, " \\\n  /store/public/ rl\n");
+
+   fprintf(fP, "g /vo");
+   for (i = 0; i < nAreas; i++)
+       fprintf(fP, " \\\n  /store/group/area%04d/ rwl", i);
+   fprintf(fP, " \\\n  common\n");
+
+   for (i = 0; i < nUsers; i++)
+       fprintf(fP, "u user%04d /store/user/user%04d/.sys/ rl-w "
+                   "/store/user/user%04d/ a /store/temp/user/user%04d/ a"
+                   " common\n", i, i, i, i);
+   fclose(fP);
+   return true;
+}
+
+/******************************************************************************/
+/*                             M a k e P a t h s                              */
+/******************************************************************************/
+
+// A fifth of the paths hit each kind of rule and a fifth hit none at all.
+//
+void MakePaths()
+{
+   char buff[256];
+   int i, n;
+
+   pTab = new char *[nPaths];
+   uTab = new int[nPaths];
+   for (i = 0; i < nPaths; i++)
+       {n = rand();
+        uTab[i] = n % nUsers;
+        switch(i % 5)
+              {case 0: snprintf(buff, sizeof(buff),
+                                "/store/data/Run%04d/dataset%04d/file%d.root",
+                                (n % nSets)/10, n % nSets, i);
+                       break;
+               case 1: snprintf(buff, sizeof(buff),
+                                "/store/group/area%04d/skim/file%d.root",
+                                n % nAreas, i);
+                       break;
+               case 2: snprintf(buff, sizeof(buff),
+                                "/store/user/user%04d/out/file%d.root",
+                                uTab[i], i);
+                       break;
+               case 3: snprintf(buff, sizeof(buff),
+                                "/store/mc/Sample%d/file%d.root", n % 100, i);
+                       break;
+               default: snprintf(buff, sizeof(buff),
+                                "/scratch/user%04d/file%d.root", uTab[i], i);
+                       break;
+              }
+        pTab[i] = strdup(buff);
+       }
+}
+
+/******************************************************************************/
+/*                                W o r k e r                                 */
+/******************************************************************************/
+
+void Worker(int tNum, int nThreads, void *arg)
+{
+   XrdNetAddr netAddr;
+   XrdSecEntity Entity("gsi");
+   char uName[16];
+   int i, k, granted = 0;
+
+   netAddr.Set("127.0.0.1", 1094);
+   Entity.addrInfo = &netAddr;
+   Entity.host = strdup("node01.example.org");
+   Entity.grps = strdup("/vo /vo/analysis");
+   Entity.vorg = strdup("vo");
+   Entity.name = uName;
+
+   for (i = 0; i < nIters; i++)
+       {k = (i * 7 + tNum * 131) % nPaths;
+        snprintf(uName, sizeof(uName), "user%04d", uTab[k]);
+        if (Authorize->Access(&Entity, pTab[k], AOP_Read)) granted++;
+       }
+
+   Entity.name = 0;
+   cntMutex.Lock(); nGrant += granted; cntMutex.UnLock();
+}
+
+/******************************************************************************/
+/*                               T i m e C a p s                              */
+/******************************************************************************/
+
+// Build one capability list out of the dataset and group area rules, as the
+// authdb would for a single identity, and time lookups of all the paths with
+// the list scanned from the front and with the compiled trie.
+//
+double TimeCaps(XrdAccCapability *caps)
+{
+   XrdAccPrivCaps privs;
+   double tBeg = XrdBench::Now();
+   int i, k;
+
+   for (i = 0; i < nIters; i++)
+       {k = (i * 7) % nPaths;
+        caps->Privs(privs, pTab[k], strlen(pTab[k]));
+       }
+   return (double)nIters / (XrdBench::Now() - tBeg);
+}
+
+void RunCaps()
+{
+   XrdAccCapability *caps = 0, *last = 0, *cP;
+   XrdAccPrivCaps privs;
+   char buff[128];
+   double linear, trie;
+   int i;
+
+   privs.pprivs = XrdAccPriv_Read;
+   for (i = 0; i < nSets + nAreas; i++)
+       {if (i < nSets)
+           snprintf(buff, sizeof(buff), "/store/data/Run%04d/dataset%04d/",
+                    i/10, i);
+           else snprintf(buff, sizeof(buff), "/store/group/area%04d/", i-nSets);
+        cP = new XrdAccCapability(buff, privs);
+        if (last) last->Add(cP);
+           else caps = cP;
+        last = cP;
+       }
+
+   linear = TimeCaps(caps);
+   caps->Compile();
+   trie   = TimeCaps(caps);
+
+   printf("\n%8s %14s %14s %8s\n", "rules", "linear/s", "trie/s", "speedup");
+   printf("%8d %14.0f %14.0f %7.1fx\n", nSets + nAreas, linear, trie,
+          trie/linear);
+   delete caps;
+}
+
+void Usage(int rc)
+{
+   fprintf(stderr, "Usage: xrdaccbench [-a <areas>] [-d <datasets>] "
+                   "[-n <iterations>] [-t <maxthreads>] [-u <users>]\n");
+   exit(rc);
+}
+}
+
+/******************************************************************************/
+/*                                  m a i n                                   */
+/******************************************************************************/
+
+int main(int argc, char **argv)
+{
+   static XrdVERSIONINFODEF(myVer, XrdAccBench, XrdVNUMBER, XrdVERSION);
+   XrdSysLogger logger;
+   char cfn[64], dbfn[64];
+   double rate, base = 0;
+   int c, n, maxThreads = 16, rc = 0;
+
+// Process the options
+//
+   while((c = getopt(argc, argv, "a:d:hn:t:u:")) != -1)
+        {switch(c)
+               {case 'a': nAreas = atoi(optarg); break;
+                case 'd': nSets = atoi(optarg); break;
+                case 'n': nIters = atoi(optarg); break;
+                case 't': maxThreads = atoi(optarg); break;
+                case 'u': nUsers = atoi(optarg); break;
+                case 'h': Usage(0);
+                default:  Usage(1);
+               }
+        }
+   if (nAreas <= 0 || nSets <= 0 || nIters <= 0 || maxThreads <= 0
+   ||  nUsers <= 0) Usage(1);
+
+// Generate the configuration and the authdb and load them
+//
+   snprintf(cfn,  sizeof(cfn),  "/tmp/xrdaccbench.%d.cf", getpid());
+   snprintf(dbfn, sizeof(dbfn), "/tmp/xrdaccbench.%d.db", getpid());
+   if (!MakeDB(dbfn, cfn)) return 1;
+   XrdOucEnv::Export("XRDINSTANCE", "xrootd anon@localhost");
+   Authorize = XrdAccDefaultAuthorizeObject(&logger, cfn, 0, myVer);
+   unlink(cfn); unlink(dbfn);
+   if (!Authorize) {fprintf(stderr, "%sunable to load authdb\n", MeMe); return 1;}
+   MakePaths();
+
+// Time authorization checks for increasing numbers of threads
+//
+   printf("%8s %14s %8s %8s\n", "threads", "access/s", "scale", "granted");
+   for (n = 1; n <= maxThreads; n *= 2)
+       {nGrant = 0;
+        rate = (double)nIters * n / XrdBench::RunThreads(MeMe, n, Worker);
+        if (n == 1) base = rate;
+        printf("%8d %14.0f %7.2fx %7.1f%%\n", n, rate, rate/base,
+               100.0*nGrant/((double)nIters*n));
+        if (!nGrant) rc = 1;
+       }
+
+// Compare the list scan with the trie
+//
+   RunCaps();
+   return rc;
+}
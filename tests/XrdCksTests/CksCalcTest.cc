@@ -0,0 +1,190 @@
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+#include <cppunit/extensions/HelperMacros.h>
+#include "XrdCks/XrdCksCalc.hh"
+#include "XrdCks/XrdCksCalcadler32.hh"
+#include "XrdCks/XrdCksCalccrc32.hh"
+#include "XrdCks/XrdCksCalccrc32C.hh"
+#include "XrdOuc/XrdOucCRC.hh"
+#include "XrdSys/XrdSysCPU.hh"
+
+#include <netinet/in.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sstream>
+
+//------------------------------------------------------------------------------
+// Declaration
+//------------------------------------------------------------------------------
+class CksCalcTest: public CppUnit::TestCase
+{
+  public:
+    CPPUNIT_TEST_SUITE( CksCalcTest );
+      CPPUNIT_TEST( CheckValueTest );
+      CPPUNIT_TEST( Adler32Test );
+      CPPUNIT_TEST( Crc32Test );
+      CPPUNIT_TEST( Crc32CTest );
+      CPPUNIT_TEST( ZCrc32Test );
+    CPPUNIT_TEST_SUITE_END();
+    void setUp();
+    void tearDown();
+    void CheckValueTest();
+    void Adler32Test();
+    void Crc32Test();
+    void Crc32CTest();
+    void ZCrc32Test();
+
+  private:
+    void CompareKernels( XrdCksCalc *calc, bool wholeOnly = false );
+    char *pBuffer;
+};
+CPPUNIT_TEST_SUITE_REGISTRATION( CksCalcTest );
+
+namespace
+{
+  const int BufferSize = 4096 + 16;
+
+  //----------------------------------------------------------------------------
+  // XrdOucCRC::CRC32 is not incremental, so wrap it for whole buffer use only
+  //----------------------------------------------------------------------------
+  class ZCrc32: public XrdCksCalc
+  {
+    public:
+      char       *Final() { return (char *)&Result; }
+      void        Init() { Result = 0; }
+      XrdCksCalc *New() { return new ZCrc32; }
+      void        Update( const char *Buff, int BLen )
+      {
+        Result = XrdOucCRC::CRC32( (const unsigned char *)Buff, BLen );
+      }
+      const char *Type( int &csSz ) { csSz = sizeof( Result ); return "zcrc32"; }
+
+      ZCrc32() { Init(); }
+      virtual ~ZCrc32() {}
+
+    private:
+      unsigned int Result;
+  };
+
+  //----------------------------------------------------------------------------
+  // Checksum a buffer in updates of at most chunk bytes
+  //----------------------------------------------------------------------------
+  unsigned int Calc( XrdCksCalc *calc, const char *buff, int blen, int chunk )
+  {
+    unsigned int result;
+    calc->Init();
+    while( blen > 0 )
+    {
+      int n = ( blen < chunk ? blen : chunk );
+      calc->Update( buff, n );
+      buff += n; blen -= n;
+    }
+    memcpy( &result, calc->Final(), sizeof( result ) );
+    return result;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Fill the buffer with something that is not too regular
+//------------------------------------------------------------------------------
+void CksCalcTest::setUp()
+{
+  pBuffer = new char[BufferSize];
+  srandom( 1 );
+  for( int i = 0; i < BufferSize; ++i )
+    pBuffer[i] = (char)random();
+}
+
+void CksCalcTest::tearDown()
+{
+  XrdSysCPU::Disable( 0 );
+  delete [] pBuffer;
+}
+
+//------------------------------------------------------------------------------
+// Standard check values with and without the accelerated kernels
+//------------------------------------------------------------------------------
+void CksCalcTest::CheckValueTest()
+{
+  XrdCksCalcadler32 adler;
+  XrdCksCalccrc32   crc32;
+  XrdCksCalccrc32C  crc32c;
+  ZCrc32            zcrc32;
+  const char       *check = "123456789";
+
+  for( int i = 0; i < 2; ++i )
+  {
+    XrdSysCPU::Disable( i ? ~0 : 0 );
+    CPPUNIT_ASSERT_EQUAL( 0x091e01deU, ntohl( Calc( &adler,  check, 9, 9 ) ) );
+    CPPUNIT_ASSERT_EQUAL( 0x377a6011U, ntohl( Calc( &crc32,  check, 9, 9 ) ) );
+    CPPUNIT_ASSERT_EQUAL( 0xe3069283U, ntohl( Calc( &crc32c, check, 9, 9 ) ) );
+    CPPUNIT_ASSERT_EQUAL( 0xcbf43926U, Calc( &zcrc32, check, 9, 9 ) );
+  }
+}
+
+//------------------------------------------------------------------------------
+// Compare the accelerated and the portable code paths for all buffer lengths
+// up to 1K, all alignments of the buffer and a few update sizes
+//------------------------------------------------------------------------------
+void CksCalcTest::CompareKernels( XrdCksCalc *calc, bool wholeOnly )
+{
+  static const int chunk[] = { 1, 7, 64, 100, 4096 };
+  static const int nChunk  = sizeof( chunk ) / sizeof( chunk[0] );
+
+  for( int i = 0; i < nChunk; ++i )
+    for( int off = 0; off < 16; ++off )
+      for( int blen = 0; blen <= 1024; ++blen )
+      {
+        if( chunk[i] < 64 && blen > 300 ) break;
+        if( wholeOnly && chunk[i] < blen ) continue;
+        XrdSysCPU::Disable( 0 );
+        unsigned int hw = Calc( calc, pBuffer + off, blen, chunk[i] );
+        XrdSysCPU::Disable( ~0 );
+        unsigned int sw = Calc( calc, pBuffer + off, blen, chunk[i] );
+        if( hw != sw )
+        {
+          std::ostringstream msg;
+          msg << "mismatch for " << blen << " bytes at offset " << off;
+          msg << " in " << chunk[i] << " byte chunks";
+          CPPUNIT_ASSERT_MESSAGE( msg.str(), hw == sw );
+        }
+      }
+}
+
+void CksCalcTest::Adler32Test()
+{
+  XrdCksCalcadler32 calc;
+  CompareKernels( &calc );
+}
+
+void CksCalcTest::Crc32Test()
+{
+  XrdCksCalccrc32 calc;
+  CompareKernels( &calc );
+}
+
+void CksCalcTest::Crc32CTest()
+{
+  XrdCksCalccrc32C calc;
+  CompareKernels( &calc );
+}
+
+void CksCalcTest::ZCrc32Test()
+{
+  ZCrc32 calc;
+  CompareKernels( &calc, true );
+}
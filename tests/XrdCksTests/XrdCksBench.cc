@@ -0,0 +1,167 @@
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d C k s B e n c h . c c                         */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+// Checksum kernel micro-benchmark. Each checksum is computed over a large
+// buffer with the accelerated kernels and again with the portable code and
+// the throughput of both is reported. CksCalcTest checks that they agree.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "XrdBench.hh"
+
+#include "XrdCks/XrdCksCalc.hh"
+#include "XrdCks/XrdCksCalcadler32.hh"
+#include "XrdCks/XrdCksCalccrc32.hh"
+#include "XrdCks/XrdCksCalccrc32C.hh"
+#include "XrdOuc/XrdOucCRC.hh"
+#include "XrdSys/XrdSysCPU.hh"
+
+/******************************************************************************/
+/*                           L o c a l   C l a s s                            */
+/******************************************************************************/
+
+// XrdOucCRC::CRC32 is not incremental, so wrap it for whole buffer use only.
+//
+class ZCrc32 : public XrdCksCalc
+{
+public:
+
+char       *Final() {return (char *)&Result;}
+void        Init() {Result = 0;}
+XrdCksCalc *New() {return new ZCrc32;}
+void        Update(const char *Buff, int BLen)
+                  {Result = XrdOucCRC::CRC32((const unsigned char *)Buff, BLen);}
+const char *Type(int &csSz) {csSz = sizeof(Result); return "zcrc32";}
+
+            ZCrc32() {Init();}
+virtual    ~ZCrc32() {}
+
+private:
+unsigned int Result;
+};
+
+/******************************************************************************/
+/*                          L o c a l   S t a t i c s                         */
+/******************************************************************************/
+  
+namespace
+{
+unsigned int Calc(XrdCksCalc *csP, const char *buff, int blen, int chunk)
+{
+   unsigned int result;
+   int n;
+
+   csP->Init();
+   while(blen > 0)
+        {n = (blen < chunk ? blen : chunk);
+         csP->Update(buff, n);
+         buff += n; blen -= n;
+        }
+   memcpy(&result, csP->Final(), sizeof(result));
+   return result;
+}
+
+/******************************************************************************/
+/*                                 T i m e I t                                */
+/******************************************************************************/
+
+double TimeIt(XrdCksCalc *csP, const char *buff, int blen, int chunk,
+              int iters, unsigned int &result)
+{
+   double tBeg = XrdBench::Now();
+   for (int i = 0; i < iters; i++) result = Calc(csP, buff, blen, chunk);
+   return (double)blen * iters / (XrdBench::Now() - tBeg) / (1024.0*1024.0);
+}
+
+void Usage(int rc)
+{
+   fprintf(stderr, "Usage: xrdcksbench [-c <chunk>] [-n <iterations>] "
+                   "[-s <size>]\n");
+   exit(rc);
+}
+}
+
+/******************************************************************************/
+/*                                  m a i n                                   */
+/******************************************************************************/
+  
+int main(int argc, char **argv)
+{
+   XrdCksCalcadler32 csAdler;
+   XrdCksCalccrc32   csCrc32;
+   XrdCksCalccrc32C  csCrc32C;
+   ZCrc32            csZcrc32;
+   XrdCksCalc *csTab[] = {&csAdler, &csCrc32, &csCrc32C, &csZcrc32};
+   const int csNum = sizeof(csTab)/sizeof(csTab[0]);
+   unsigned int hw, sw;
+   int  bSize = 64*1024*1024, chunk = 1024*1024, iters = 4;
+   int  c, csLen, i, feats = XrdSysCPU::Features();
+   char *buff;
+
+// Process the options
+//
+   while((c = getopt(argc, argv, "c:hn:s:")) != -1)
+        {switch(c)
+               {case 'c': chunk = atoi(optarg); break;
+                case 'n': iters = atoi(optarg); break;
+                case 's': bSize = atoi(optarg); break;
+                case 'h': Usage(0);
+                default:  Usage(1);
+               }
+        }
+   if (bSize <= 0 || chunk <= 0 || iters <= 0) Usage(1);
+
+   printf("CPU features:%s%s%s%s\n", (feats & XrdSysCPU::SSSE3  ? " ssse3"  : ""),
+                                    (feats & XrdSysCPU::SSE42  ? " sse4.2" : ""),
+                                    (feats & XrdSysCPU::PCLMUL ? " pclmul" : ""),
+                                    (feats & XrdSysCPU::AVX2   ? " avx2"   : ""));
+
+// Fill the buffer with something that is not too regular
+//
+   buff = (char *)malloc(bSize);
+   srandom(1);
+   for (i = 0; i < bSize; i++) buff[i] = (char)random();
+
+// Time each checksum with and without the accelerated kernels
+//
+   printf("%-8s %14s %14s %8s\n", "cks", "accel MB/s", "portable MB/s", "speedup");
+   for (i = 0; i < csNum; i++)
+       {int csChunk = (csTab[i] == &csZcrc32 ? bSize : chunk);
+        double hwRate, swRate;
+        XrdSysCPU::Disable(0);
+        hwRate = TimeIt(csTab[i], buff, bSize, csChunk, iters, hw);
+        XrdSysCPU::Disable(~0);
+        swRate = TimeIt(csTab[i], buff, bSize, csChunk, iters, sw);
+        printf("%-8s %14.1f %14.1f %7.1fx%s\n", csTab[i]->Type(csLen),
+               hwRate, swRate, hwRate/swRate, (hw == sw ? "" : " MISMATCH"));
+       }
+   XrdSysCPU::Disable(0);
+
+   free(buff);
+   return 0;
+}
@@ -0,0 +1,332 @@
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "CppUnitXrdHelpers.hh"
+#include "XProtocol/XProtocol.hh"
+#include "XrdCl/XrdClSIDManager.hh"
+#include "XrdCl/XrdClInQueue.hh"
+#include "XrdCl/XrdClMessage.hh"
+#include "XrdCl/XrdClDefaultEnv.hh"
+#include "XrdCl/XrdClLog.hh"
+#include "XrdCl/XrdClConstants.hh"
+#include <atomic>
+#include <cstring>
+#include <vector>
+#include <pthread.h>
+#include <sys/time.h>
+
+//------------------------------------------------------------------------------
+// Declaration
+//------------------------------------------------------------------------------
+class SIDContentionTest: public CppUnit::TestCase
+{
+  public:
+    CPPUNIT_TEST_SUITE( SIDContentionTest );
+      CPPUNIT_TEST( ConcurrentAllocationTest );
+      CPPUNIT_TEST( InQueueDispatchTest );
+      CPPUNIT_TEST( ContentionBenchmark );
+    CPPUNIT_TEST_SUITE_END();
+    void ConcurrentAllocationTest();
+    void InQueueDispatchTest();
+    void ContentionBenchmark();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( SIDContentionTest );
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // Handler taking exactly one response
+  //----------------------------------------------------------------------------
+  class OneShotHandler: public XrdCl::IncomingMsgHandler
+  {
+    public:
+      OneShotHandler( uint8_t sid[2], std::atomic<uint32_t> &processed ):
+        pProcessed( processed )
+      {
+        pSid = ((uint16_t)sid[1] << 8) | (uint16_t)sid[0];
+      }
+
+      virtual uint16_t Examine( XrdCl::Message * )
+      {
+        return Take | RemoveHandler;
+      }
+
+      virtual uint16_t GetSid() const
+      {
+        return pSid;
+      }
+
+      virtual void Process( XrdCl::Message *msg )
+      {
+        ++pProcessed;
+        delete msg;
+      }
+
+      virtual uint8_t OnStreamEvent( StreamEvent, uint16_t, XrdCl::Status )
+      {
+        return RemoveHandler;
+      }
+
+    private:
+      uint16_t               pSid;
+      std::atomic<uint32_t> &pProcessed;
+  };
+
+  //----------------------------------------------------------------------------
+  // Build a kXR_ok response for the given stream id
+  //----------------------------------------------------------------------------
+  XrdCl::Message *CreateResponse( uint8_t sid[2] )
+  {
+    XrdCl::Message *msg = new XrdCl::Message( 8 );
+    ServerResponseHeader *hdr = (ServerResponseHeader *)msg->GetBuffer();
+    hdr->streamid[0] = sid[0];
+    hdr->streamid[1] = sid[1];
+    hdr->status      = kXR_ok;
+    hdr->dlen        = 0;
+    return msg;
+  }
+
+  //----------------------------------------------------------------------------
+  // Shared state of the worker threads
+  //----------------------------------------------------------------------------
+  struct WorkerArgs
+  {
+    XrdCl::SIDManager     *sidMgr;
+    XrdCl::InQueue        *inQueue;
+    std::atomic<uint8_t>  *owned;
+    std::atomic<uint32_t>  processed;
+    std::atomic<uint32_t>  errors;
+    uint32_t               iterations;
+    uint32_t               batch;
+  };
+
+  //----------------------------------------------------------------------------
+  // Allocate a batch of SIDs, verify nobody else holds them, release them
+  //----------------------------------------------------------------------------
+  void *AllocWorker( void *arg )
+  {
+    WorkerArgs *args = (WorkerArgs*)arg;
+    uint8_t sids[64][2];
+
+    for( uint32_t i = 0; i < args->iterations; ++i )
+    {
+      for( uint32_t j = 0; j < args->batch; ++j )
+      {
+        if( !args->sidMgr->AllocateSID( sids[j] ).IsOK() )
+        {
+          ++args->errors;
+          return 0;
+        }
+        uint16_t sid; memcpy( &sid, sids[j], 2 );
+        if( args->owned[sid].exchange( 1 ) != 0 )
+          ++args->errors;
+      }
+
+      for( uint32_t j = 0; j < args->batch; ++j )
+      {
+        uint16_t sid; memcpy( &sid, sids[j], 2 );
+        args->owned[sid].store( 0 );
+        args->sidMgr->ReleaseSID( sids[j] );
+      }
+    }
+    return 0;
+  }
+
+  //----------------------------------------------------------------------------
+  // Simulate request/response round trips: allocate a SID, register a
+  // handler, deliver the response and release the SID
+  //----------------------------------------------------------------------------
+  void *DispatchWorker( void *arg )
+  {
+    WorkerArgs *args = (WorkerArgs*)arg;
+    uint8_t sid[2];
+
+    for( uint32_t i = 0; i < args->iterations; ++i )
+    {
+      if( !args->sidMgr->AllocateSID( sid ).IsOK() )
+      {
+        ++args->errors;
+        return 0;
+      }
+
+      OneShotHandler handler( sid, args->processed );
+      args->inQueue->AddMessageHandler( &handler, time(0) + 60 );
+      args->inQueue->AddMessage( CreateResponse( sid ) );
+      args->sidMgr->ReleaseSID( sid );
+    }
+    return 0;
+  }
+
+  //----------------------------------------------------------------------------
+  // Run the worker in the given number of threads, return ops/s
+  //----------------------------------------------------------------------------
+  double RunThreads( void *(*worker)(void*), WorkerArgs *args,
+                     uint32_t nThreads )
+  {
+    pthread_t threads[64];
+    timeval start, end;
+
+    gettimeofday( &start, 0 );
+    for( uint32_t i = 0; i < nThreads; ++i )
+      pthread_create( &threads[i], 0, worker, args );
+    for( uint32_t i = 0; i < nThreads; ++i )
+      pthread_join( threads[i], 0 );
+    gettimeofday( &end, 0 );
+
+    double elapsed = (end.tv_sec - start.tv_sec) +
+                     (end.tv_usec - start.tv_usec) / 1e6;
+    return (double)nThreads * args->iterations / elapsed;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Allocate and release SIDs from many threads
+//------------------------------------------------------------------------------
+void SIDContentionTest::ConcurrentAllocationTest()
+{
+  using namespace XrdCl;
+  SIDManager *manager = new SIDManager();
+  std::atomic<uint8_t> *owned = new std::atomic<uint8_t>[65536];
+  for( int i = 0; i < 65536; ++i )
+    owned[i].store( 0 );
+
+  WorkerArgs args;
+  args.sidMgr     = manager;
+  args.inQueue    = 0;
+  args.owned      = owned;
+  args.processed  = 0;
+  args.errors     = 0;
+  args.iterations = 10000;
+  args.batch      = 64;
+
+  RunThreads( AllocWorker, &args, 32 );
+
+  CPPUNIT_ASSERT( args.errors == 0 );
+  CPPUNIT_ASSERT( manager->GetNumberOfAllocatedSIDs() == 0 );
+
+  //----------------------------------------------------------------------------
+  // Only the ones in flight at the same time should have been carved out
+  //----------------------------------------------------------------------------
+  std::vector<uint16_t> sids;
+  uint8_t sid[2];
+  Status st;
+  while( (st = manager->AllocateSID( sid )).IsOK() )
+  {
+    uint16_t s; memcpy( &s, sid, 2 );
+    sids.push_back( s );
+  }
+  CPPUNIT_ASSERT( sids.size() == 65534 );
+  CPPUNIT_ASSERT( manager->GetNumberOfAllocatedSIDs() == 65534 );
+
+  delete [] owned;
+  delete manager;
+}
+
+//------------------------------------------------------------------------------
+// Every response must reach its handler exactly once
+//------------------------------------------------------------------------------
+void SIDContentionTest::InQueueDispatchTest()
+{
+  using namespace XrdCl;
+  SIDManager *manager = new SIDManager();
+  InQueue    *inQueue = new InQueue();
+
+  WorkerArgs args;
+  args.sidMgr     = manager;
+  args.inQueue    = inQueue;
+  args.owned      = 0;
+  args.processed  = 0;
+  args.errors     = 0;
+  args.iterations = 20000;
+  args.batch      = 0;
+
+  RunThreads( DispatchWorker, &args, 32 );
+
+  CPPUNIT_ASSERT( args.errors == 0 );
+  CPPUNIT_ASSERT( args.processed == 32 * args.iterations );
+  CPPUNIT_ASSERT( manager->GetNumberOfAllocatedSIDs() == 0 );
+
+  //----------------------------------------------------------------------------
+  // A response arriving before its handler must be picked up on registration
+  //----------------------------------------------------------------------------
+  uint8_t sid[2];
+  CPPUNIT_ASSERT_XRDST( manager->AllocateSID( sid ) );
+  args.processed = 0;
+  inQueue->AddMessage( CreateResponse( sid ) );
+  OneShotHandler handler( sid, args.processed );
+  inQueue->AddMessageHandler( &handler, time(0) + 60 );
+  CPPUNIT_ASSERT( args.processed == 1 );
+
+  //----------------------------------------------------------------------------
+  // Expired handlers must be reported and dropped
+  //----------------------------------------------------------------------------
+  OneShotHandler handler2( sid, args.processed );
+  inQueue->AddMessageHandler( &handler2, 1 );
+  inQueue->ReportTimeout();
+  inQueue->AddMessage( CreateResponse( sid ) );
+  CPPUNIT_ASSERT( args.processed == 1 );
+
+  OneShotHandler handler3( sid, args.processed );
+  inQueue->AddMessageHandler( &handler3, time(0) + 60 );
+  CPPUNIT_ASSERT( args.processed == 2 );
+
+  delete inQueue;
+  delete manager;
+}
+
+//------------------------------------------------------------------------------
+// Measure the SID allocation and dispatch rates for growing thread counts
+//------------------------------------------------------------------------------
+void SIDContentionTest::ContentionBenchmark()
+{
+  using namespace XrdCl;
+  Log *log = DefaultEnv::GetLog();
+  const uint32_t threads[] = { 1, 4, 16, 32, 64 };
+
+  for( size_t i = 0; i < sizeof(threads)/sizeof(threads[0]); ++i )
+  {
+    SIDManager *manager = new SIDManager();
+    InQueue    *inQueue = new InQueue();
+    std::atomic<uint8_t> *owned = new std::atomic<uint8_t>[65536];
+    for( int j = 0; j < 65536; ++j )
+      owned[j].store( 0 );
+
+    WorkerArgs args;
+    args.sidMgr     = manager;
+    args.inQueue    = inQueue;
+    args.owned      = owned;
+    args.processed  = 0;
+    args.errors     = 0;
+    args.iterations = 50000;
+    args.batch      = 1;
+
+    double allocRate    = RunThreads( AllocWorker, &args, threads[i] );
+    double dispatchRate = RunThreads( DispatchWorker, &args, threads[i] );
+
+    log->Info( UtilityMsg, "SID contention: %2d threads: %10.0f alloc/s, "
+               "%10.0f round trips/s", threads[i], allocRate, dispatchRate );
+
+    CPPUNIT_ASSERT( args.errors == 0 );
+    CPPUNIT_ASSERT( args.processed == threads[i] * args.iterations );
+
+    delete [] owned;
+    delete inQueue;
+    delete manager;
+  }
+}
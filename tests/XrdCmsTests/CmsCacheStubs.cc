@@ -0,0 +1,52 @@
+/******************************************************************************/
+/*                                                                            */
+/*                      C m s C a c h e S t u b s . c c                       */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+// The location cache only needs the following pieces of the cmsd. Requests
+// are never queued for a deferred response by the tests or the benchmark so
+// the request queue does nothing at all.
+
+#include "Xrd/XrdScheduler.hh"
+#include "XrdCms/XrdCmsRRQ.hh"
+#include "XrdOuc/XrdOucTrace.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysLogger.hh"
+
+namespace XrdCms
+{
+XrdSysLogger  Logger;
+XrdSysError   Say(&Logger, "cms_");
+XrdOucTrace   Trace(&Say);
+XrdScheduler *Sched = 0;
+XrdCmsRRQ     RRQ;
+}
+
+XrdCmsRRQSlot::XrdCmsRRQSlot() : Link(this) {}
+
+short XrdCmsRRQ::Add(short Snum, XrdCmsRRQInfo *ip) {return 0;}
+
+void  XrdCmsRRQ::Del(short Snum, const void *Key) {}
+
+int   XrdCmsRRQ::Ready(int Snum, const void *Key, SMask_t mask1, SMask_t mask2)
+                      {return 0;}
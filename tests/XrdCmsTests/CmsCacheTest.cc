@@ -0,0 +1,161 @@
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+#include <cppunit/extensions/HelperMacros.h>
+#include "XrdCms/XrdCmsCache.hh"
+#include "XrdCms/XrdCmsKey.hh"
+#include "XrdCms/XrdCmsSelect.hh"
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Declaration
+//------------------------------------------------------------------------------
+class CmsCacheTest: public CppUnit::TestCase
+{
+  public:
+    CPPUNIT_TEST_SUITE( CmsCacheTest );
+      CPPUNIT_TEST( ShardTest );
+      CPPUNIT_TEST( AddGetDelTest );
+    CPPUNIT_TEST_SUITE_END();
+    void ShardTest();
+    void AddGetDelTest();
+};
+CPPUNIT_TEST_SUITE_REGISTRATION( CmsCacheTest );
+
+namespace
+{
+  const int numServers = 8;
+
+  //----------------------------------------------------------------------------
+  // Paths shaped like those a redirector sees
+  //----------------------------------------------------------------------------
+  std::vector<std::string> MakePaths( const char *area, int n )
+  {
+    std::vector<std::string> paths;
+    char buff[128];
+    for( int i = 0; i < n; ++i )
+    {
+      snprintf( buff, sizeof( buff ), "/store/%s/run%d/file%d.root",
+                area, i % 37, i );
+      paths.push_back( buff );
+    }
+    return paths;
+  }
+
+  int ShardOf( const std::string &path )
+  {
+    XrdCmsKey key( const_cast<char*>( path.c_str() ), path.size() );
+    key.setHash();
+    return XrdCmsCache::ShardOf( key.Hash );
+  }
+
+  int GetFile( const std::string &path, SMask_t &hf )
+  {
+    XrdCmsSelect sel( 0, const_cast<char*>( path.c_str() ), path.size() );
+    int rc = XrdCms::Cache.GetFile( sel, ~SMask_t( 0 ) );
+    hf = sel.Vec.hf;
+    return rc;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Keys are spread over all of the shards
+//------------------------------------------------------------------------------
+void CmsCacheTest::ShardTest()
+{
+  const int nPaths = 64 * XrdCmsCache::numShards;
+  std::vector<std::string> paths = MakePaths( "shard", nPaths );
+  std::vector<int> count( XrdCmsCache::numShards, 0 );
+
+  for( int i = 0; i < nPaths; ++i )
+  {
+    int s = ShardOf( paths[i] );
+    CPPUNIT_ASSERT( s >= 0 && s < XrdCmsCache::numShards );
+    count[s]++;
+  }
+
+  for( int s = 0; s < XrdCmsCache::numShards; ++s )
+  {
+    CPPUNIT_ASSERT( count[s] > 64 / 2 );
+    CPPUNIT_ASSERT( count[s] < 64 * 2 );
+  }
+
+  // Only the high order bits of the hash pick the shard
+  CPPUNIT_ASSERT_EQUAL( 0, XrdCmsCache::ShardOf( 0x0fffffff ) );
+  CPPUNIT_ASSERT_EQUAL( XrdCmsCache::numShards - 1,
+                        XrdCmsCache::ShardOf( 0xf0000000 ) );
+}
+
+//------------------------------------------------------------------------------
+// Entries in every shard can be added, found and deleted
+//------------------------------------------------------------------------------
+void CmsCacheTest::AddGetDelTest()
+{
+  const int nPaths = 32 * XrdCmsCache::numShards;
+  std::vector<std::string> paths = MakePaths( "agd", nPaths );
+  std::vector<bool> used( XrdCmsCache::numShards, false );
+  SMask_t hf;
+  int i;
+
+  for( i = 0; i < numServers; ++i )
+    XrdCms::Cache.Bounce( SMask_t( 1 ) << i, i );
+
+  // A query adds the path, a server reporting it fills in its location
+  for( i = 0; i < nPaths; ++i )
+  {
+    char *path = const_cast<char*>( paths[i].c_str() );
+    int   plen = paths[i].size();
+    CPPUNIT_ASSERT_EQUAL( 0, GetFile( paths[i], hf ) );
+
+    XrdCmsSelect sel( 0, path, plen );
+    CPPUNIT_ASSERT_EQUAL( 1, XrdCms::Cache.AddFile( sel, 0 ) );
+    XrdCmsSelect have( XrdCmsSelect::Advisory, path, plen );
+    CPPUNIT_ASSERT_EQUAL( 1, XrdCms::Cache.AddFile( have,
+                                                    SMask_t( 1 ) << ( i % numServers ) ) );
+    used[ShardOf( paths[i] )] = true;
+  }
+
+  for( int s = 0; s < XrdCmsCache::numShards; ++s )
+    CPPUNIT_ASSERT( used[s] );
+
+  for( i = 0; i < nPaths; ++i )
+  {
+    CPPUNIT_ASSERT_EQUAL( 1, GetFile( paths[i], hf ) );
+    CPPUNIT_ASSERT( hf == SMask_t( 1 ) << ( i % numServers ) );
+  }
+
+  // Delete every other path; the rest must be unaffected
+  for( i = 0; i < nPaths; i += 2 )
+  {
+    XrdCmsSelect sel( 0, const_cast<char*>( paths[i].c_str() ), paths[i].size() );
+    CPPUNIT_ASSERT_EQUAL( 1, XrdCms::Cache.DelFile( sel,
+                                                    SMask_t( 1 ) << ( i % numServers ) ) );
+  }
+
+  for( i = 0; i < nPaths; ++i )
+  {
+    if( i & 1 )
+    {
+      CPPUNIT_ASSERT_EQUAL( 1, GetFile( paths[i], hf ) );
+      CPPUNIT_ASSERT( hf == SMask_t( 1 ) << ( i % numServers ) );
+    }
+    else
+      CPPUNIT_ASSERT_EQUAL( 0, GetFile( paths[i], hf ) );
+  }
+}
@@ -0,0 +1,192 @@
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+#include <cppunit/extensions/HelperMacros.h>
+#include "XrdCms/XrdCmsSMask.hh"
+
+#include <string>
+
+//------------------------------------------------------------------------------
+// Declaration
+//------------------------------------------------------------------------------
+class SMaskTest: public CppUnit::TestCase
+{
+  public:
+    CPPUNIT_TEST_SUITE( SMaskTest );
+      CPPUNIT_TEST( FirstTest );
+      CPPUNIT_TEST( SetClearTest );
+      CPPUNIT_TEST( ShiftTest );
+      CPPUNIT_TEST( HexTest );
+    CPPUNIT_TEST_SUITE_END();
+    void FirstTest();
+    void SetClearTest();
+    void ShiftTest();
+    void HexTest();
+};
+CPPUNIT_TEST_SUITE_REGISTRATION( SMaskTest );
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // Bits on either side of each word boundary
+  //----------------------------------------------------------------------------
+  const int edgeBits[] = { 0, 1, 62, 63, 64, 65, 127, 128, 191, 192, 254, 255 };
+  const int numEdges   = sizeof( edgeBits ) / sizeof( edgeBits[0] );
+
+  template<int nBits>
+  void CheckFirst()
+  {
+    typedef XrdCmsSMask<nBits> Mask;
+
+    CPPUNIT_ASSERT_EQUAL( -1, Mask( 0 ).First() );
+    CPPUNIT_ASSERT_EQUAL( 0, ( ~Mask( 0 ) ).First() );
+
+    for( int i = 0; i < numEdges && edgeBits[i] < nBits; ++i )
+    {
+      int b = edgeBits[i];
+      Mask m = Mask::Bit( b );
+      CPPUNIT_ASSERT_EQUAL( b, m.First() );
+      CPPUNIT_ASSERT_EQUAL( 1, m.Count() );
+      CPPUNIT_ASSERT( m.Test( b ) );
+      CPPUNIT_ASSERT( !m.Many() );
+
+      // The lowest bit wins whatever is set above it
+      m.Set( nBits - 1 );
+      CPPUNIT_ASSERT_EQUAL( b, m.First() );
+      CPPUNIT_ASSERT_EQUAL( b == nBits - 1 ? 1 : 2, m.Count() );
+      CPPUNIT_ASSERT( m.Many() == ( b != nBits - 1 ) );
+    }
+  }
+
+  template<int nBits>
+  void CheckSetClear()
+  {
+    typedef XrdCmsSMask<nBits> Mask;
+    Mask all = ~Mask( 0 ), m( 0 );
+
+    CPPUNIT_ASSERT_EQUAL( Mask::nWords * 64, all.Count() );
+    CPPUNIT_ASSERT( !m );
+    CPPUNIT_ASSERT( static_cast<bool>( all ) );
+
+    // Set every edge bit, then clear them one by one
+    int n = 0;
+    for( int i = 0; i < numEdges && edgeBits[i] < nBits; ++i, ++n )
+      m |= Mask::Bit( edgeBits[i] );
+    CPPUNIT_ASSERT_EQUAL( n, m.Count() );
+    CPPUNIT_ASSERT( ( m & all ) == m );
+    CPPUNIT_ASSERT( ( m ^ all ) == ( all & ~m ) );
+
+    for( int i = 0; i < n; ++i )
+    {
+      int b = edgeBits[i];
+      CPPUNIT_ASSERT_EQUAL( b, m.First() );
+      m &= ~Mask::Bit( b );
+      CPPUNIT_ASSERT( !m.Test( b ) );
+      CPPUNIT_ASSERT_EQUAL( n - i - 1, m.Count() );
+    }
+    CPPUNIT_ASSERT( m == Mask( 0 ) );
+
+    // Toggling a bit twice gives back the original set
+    m = Mask( 0x5ULL );
+    m ^= Mask::Bit( nBits - 1 );
+    CPPUNIT_ASSERT( m != Mask( 0x5ULL ) );
+    m ^= Mask::Bit( nBits - 1 );
+    CPPUNIT_ASSERT( m == Mask( 0x5ULL ) );
+
+    // A value only sets the low order word
+    m = Mask( ~0ULL );
+    CPPUNIT_ASSERT_EQUAL( 64, m.Count() );
+    CPPUNIT_ASSERT_EQUAL( nBits > 64, static_cast<bool>( m ^ ~Mask( 0 ) ) );
+  }
+
+  template<int nBits>
+  void CheckShift()
+  {
+    typedef XrdCmsSMask<nBits> Mask;
+
+    // Bits move across word boundaries in both directions
+    for( int i = 0; i < numEdges && edgeBits[i] < nBits; ++i )
+    {
+      int b = edgeBits[i];
+      if( b + 1 < nBits )
+      {
+        CPPUNIT_ASSERT( ( Mask::Bit( b ) << 1 ) == Mask::Bit( b + 1 ) );
+        CPPUNIT_ASSERT( ( Mask::Bit( b + 1 ) >> 1 ) == Mask::Bit( b ) );
+      }
+      if( b + 64 < nBits )
+      {
+        CPPUNIT_ASSERT( ( Mask::Bit( b ) << 64 ) == Mask::Bit( b + 64 ) );
+        CPPUNIT_ASSERT( ( Mask::Bit( b + 64 ) >> 64 ) == Mask::Bit( b ) );
+      }
+    }
+
+    // Bits shifted out are lost
+    CPPUNIT_ASSERT( !( Mask::Bit( nBits - 1 ) << 1 ) );
+    CPPUNIT_ASSERT( !( Mask::Bit( 0 ) >> 1 ) );
+    CPPUNIT_ASSERT( ( Mask::Bit( 0 ) << ( nBits - 1 ) ) == Mask::Bit( nBits - 1 ) );
+
+    // A full set shifted by 65 keeps all but 65 bits
+    Mask m = ~Mask( 0 );
+    m <<= 65;
+    CPPUNIT_ASSERT_EQUAL( Mask::nWords * 64 - 65 > 0 ? Mask::nWords * 64 - 65 : 0,
+                          m.Count() );
+    CPPUNIT_ASSERT_EQUAL( nBits > 65 ? 65 : -1, m.First() );
+  }
+}
+
+//------------------------------------------------------------------------------
+// First() finds the lowest bit in every word
+//------------------------------------------------------------------------------
+void SMaskTest::FirstTest()
+{
+  CheckFirst<64>();
+  CheckFirst<256>();
+}
+
+//------------------------------------------------------------------------------
+// Setting and clearing bits on either side of the word boundaries
+//------------------------------------------------------------------------------
+void SMaskTest::SetClearTest()
+{
+  CheckSetClear<64>();
+  CheckSetClear<256>();
+}
+
+//------------------------------------------------------------------------------
+// Shifts carry bits from one word into the next
+//------------------------------------------------------------------------------
+void SMaskTest::ShiftTest()
+{
+  CheckShift<64>();
+  CheckShift<256>();
+}
+
+//------------------------------------------------------------------------------
+// Hex() prints the most significant non-zero word first and pads the rest
+//------------------------------------------------------------------------------
+void SMaskTest::HexTest()
+{
+  char buff[256/4+1];
+
+  CPPUNIT_ASSERT_EQUAL( std::string( "0" ),
+                        std::string( XrdCmsSMask<64>( 0 ).Hex( buff, sizeof( buff ) ) ) );
+  CPPUNIT_ASSERT_EQUAL( std::string( "8000000000000000" ),
+                        std::string( XrdCmsSMask<64>::Bit( 63 ).Hex( buff, sizeof( buff ) ) ) );
+  CPPUNIT_ASSERT_EQUAL( std::string( "10000000000000000" ),
+                        std::string( XrdCmsSMask<256>::Bit( 64 ).Hex( buff, sizeof( buff ) ) ) );
+  CPPUNIT_ASSERT_EQUAL( std::string( "1" ),
+                        std::string( XrdCmsSMask<256>::Bit( 0 ).Hex( buff, sizeof( buff ) ) ) );
+}
@@ -0,0 +1,204 @@
+/******************************************************************************/
+/*                                                                            */
+/*                   X r d C m s C a c h e B e n c h . c c                    */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+// Location cache micro-benchmark. A recorded or synthesized trace of locate
+// requests is replayed by increasing numbers of threads the way a redirector
+// handles them and the lookup rate is reported.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "XrdBench.hh"
+
+#include "XrdCms/XrdCmsCache.hh"
+#include "XrdCms/XrdCmsSelect.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+/******************************************************************************/
+/*                         L o c a l   S t a t i c s                          */
+/******************************************************************************/
+
+namespace
+{
+const char *MeMe     = "xrdcmscachebench: ";
+int         nIters   = 200000;
+int         nServers = 32;
+
+struct Request
+{
+std::string path;
+int         opts;
+};
+
+std::vector<Request> Requests;
+
+XrdSysMutex missMutex;
+long long   nMiss;
+
+/******************************************************************************/
+/*                             L o a d T r a c e                              */
+/******************************************************************************/
+
+// A recorded trace has one request per line. The line is either just the path
+// or the request type ('r' or 'w') followed by a space and the path.
+//
+bool LoadTrace(const char *fn)
+{
+   char buff[4096], *bP;
+   FILE *fP;
+   Request req;
+   int n;
+
+   if (!(fP = fopen(fn, "r")))
+      {fprintf(stderr, "%sunable to open %s\n", MeMe, fn); return false;}
+
+   while(fgets(buff, sizeof(buff), fP))
+        {if ((n = strlen(buff)) && buff[n-1] == '\n') buff[--n] = 0;
+         if (!n || *buff == '#') continue;
+         bP = buff; req.opts = 0;
+         if ((*bP == 'r' || *bP == 'w') && bP[1] == ' ')
+            {if (*bP == 'w') req.opts = XrdCmsSelect::Write;
+             bP += 2;
+            }
+         req.path = bP;
+         Requests.push_back(req);
+        }
+   fclose(fP);
+
+   if (Requests.empty())
+      {fprintf(stderr, "%s%s holds no requests\n", MeMe, fn); return false;}
+   return true;
+}
+
+// Without a trace we synthesize one. A few directories are very popular, as
+// is usually the case, and one request in ten is for writing.
+//
+void MakeTrace(int nPaths)
+{
+   char buff[128];
+   Request req;
+
+   srand(1);
+   for (int i = 0; i < nPaths; i++)
+       {int dir = (rand() % 4 ? rand() % 16 : rand() % 1024);
+        snprintf(buff, sizeof(buff), "/store/data/run%d/file%d.root",
+                 dir, rand() % (nPaths/4 + 1));
+        req.path = buff;
+        req.opts = (rand() % 10 ? 0 : XrdCmsSelect::Write);
+        Requests.push_back(req);
+       }
+}
+
+/******************************************************************************/
+/*                                W o r k e r                                 */
+/******************************************************************************/
+
+// Each thread replays the trace, starting at its own offset: look up the path
+// and, if it is not known, add it and record the location reported by one of
+// the servers.
+//
+void Worker(int tNum, int nThreads, void *arg)
+{
+   SMask_t  allMask = ~SMask_t(0);
+   size_t   n = Requests.size(), k = (n / nThreads) * tNum;
+   long long myMiss = 0;
+
+   for (int i = 0; i < nIters; i++, k++)
+       {Request &req = Requests[k % n];
+        char *path = const_cast<char *>(req.path.c_str());
+        int   plen = req.path.size();
+        XrdCmsSelect Sel(req.opts, path, plen);
+        if (!XrdCms::Cache.GetFile(Sel, allMask))
+           {myMiss++;
+            XrdCms::Cache.AddFile(Sel, 0);
+            XrdCmsSelect Have(XrdCmsSelect::Advisory | req.opts, path, plen);
+            Have.Path.Hash = Sel.Path.Hash;
+            XrdCms::Cache.AddFile(Have, SMask_t(1) << (Sel.Path.Hash % nServers));
+           }
+       }
+
+   missMutex.Lock(); nMiss += myMiss; missMutex.UnLock();
+}
+
+void Usage(int rc)
+{
+   fprintf(stderr, "Usage: xrdcmscachebench [-n <iterations>] [-p <paths>] "
+                   "[-r <tracefile>] [-s <servers>] [-t <maxthreads>]\n");
+   exit(rc);
+}
+}
+
+/******************************************************************************/
+/*                                  m a i n                                   */
+/******************************************************************************/
+
+int main(int argc, char **argv)
+{
+   const char *traceFN = 0;
+   double rate, base = 0;
+   int c, n, nPaths = 100000, maxThreads = 16;
+
+// Process the options
+//
+   while((c = getopt(argc, argv, "hn:p:r:s:t:")) != -1)
+        {switch(c)
+               {case 'n': nIters = atoi(optarg); break;
+                case 'p': nPaths = atoi(optarg); break;
+                case 'r': traceFN = optarg; break;
+                case 's': nServers = atoi(optarg); break;
+                case 't': maxThreads = atoi(optarg); break;
+                case 'h': Usage(0);
+                default:  Usage(1);
+               }
+        }
+   if (nIters <= 0 || nPaths <= 0 || maxThreads <= 0
+   ||  nServers <= 0 || nServers > STMax) Usage(1);
+
+// Get the requests to replay
+//
+   if (traceFN) {if (!LoadTrace(traceFN)) return 1;}
+      else MakeTrace(nPaths);
+
+// Register the servers so that their locations are reported
+//
+   for (n = 0; n < nServers; n++) XrdCms::Cache.Bounce(SMask_t(1) << n, n);
+
+// Time the lookups for increasing numbers of threads. The first pass fills
+// the cache so the following ones mostly see hits.
+//
+   printf("%8s %14s %10s %8s\n", "threads", "lookups/s", "misses", "scale");
+   for (n = 1; n <= maxThreads; n *= 2)
+       {nMiss = 0;
+        rate = (double)nIters * n / XrdBench::RunThreads(MeMe, n, Worker);
+        if (n == 1) base = rate;
+        printf("%8d %14.0f %10lld %7.2fx\n", n, rate, nMiss, rate/base);
+       }
+   return 0;
+}
@@ -0,0 +1,160 @@
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+#include <cppunit/extensions/HelperMacros.h>
+#include "XrdFileCache/XrdFileCacheAccessPattern.hh"
+
+using namespace XrdFileCache;
+
+//------------------------------------------------------------------------------
+// Declaration
+//------------------------------------------------------------------------------
+class AccessPatternTest: public CppUnit::TestCase
+{
+  public:
+    CPPUNIT_TEST_SUITE( AccessPatternTest );
+      CPPUNIT_TEST( SequentialTest );
+      CPPUNIT_TEST( StridedTest );
+      CPPUNIT_TEST( WideStrideTest );
+      CPPUNIT_TEST( RandomTest );
+      CPPUNIT_TEST( IdleTest );
+    CPPUNIT_TEST_SUITE_END();
+    void SequentialTest();
+    void StridedTest();
+    void WideStrideTest();
+    void RandomTest();
+    void IdleTest();
+};
+CPPUNIT_TEST_SUITE_REGISTRATION( AccessPatternTest );
+
+namespace
+{
+  const int maxBlocks = 64;
+}
+
+//------------------------------------------------------------------------------
+// Reading block after block predicts the following blocks, with a window
+// that grows with every read
+//------------------------------------------------------------------------------
+void AccessPatternTest::SequentialTest()
+{
+  AccessPattern ap;
+  int lastWindow = 0;
+
+  for( int i = 0; i < 8; ++i )
+  {
+    ap.Observe( i, i );
+    if( i >= 2 )
+    {
+      CPPUNIT_ASSERT( ap.Window( maxBlocks ) > lastWindow );
+      lastWindow = ap.Window( maxBlocks );
+    }
+  }
+  CPPUNIT_ASSERT( ap.IsKnown() );
+  for( int n = 1; n <= ap.Window( maxBlocks ); ++n )
+    CPPUNIT_ASSERT_EQUAL( 7 + n, ap.Predict( n ) );
+
+  // Reads of several blocks predict the same contiguous blocks
+  AccessPattern wide;
+  for( int i = 0; i < 8; ++i )
+    wide.Observe( 3 * i, 3 * i + 2 );
+  CPPUNIT_ASSERT( wide.IsKnown() );
+  CPPUNIT_ASSERT( wide.Window( maxBlocks ) >= 3 );
+  for( int n = 1; n <= wide.Window( maxBlocks ); ++n )
+    CPPUNIT_ASSERT_EQUAL( 23 + n, wide.Predict( n ) );
+
+  // The window is capped
+  for( int i = 8; i < 40; ++i )
+    ap.Observe( i, i );
+  CPPUNIT_ASSERT_EQUAL( maxBlocks, ap.Window( maxBlocks ) );
+}
+
+//------------------------------------------------------------------------------
+// Single blocks read at a constant distance
+//------------------------------------------------------------------------------
+void AccessPatternTest::StridedTest()
+{
+  AccessPattern ap;
+
+  for( int i = 0; i < 8; ++i )
+    ap.Observe( 10 * i, 10 * i );
+  CPPUNIT_ASSERT( ap.IsKnown() );
+  CPPUNIT_ASSERT( ap.Window( maxBlocks ) > 1 );
+  for( int n = 1; n <= ap.Window( maxBlocks ); ++n )
+    CPPUNIT_ASSERT_EQUAL( 70 + 10 * n, ap.Predict( n ) );
+}
+
+//------------------------------------------------------------------------------
+// Accesses wider than a block read at a constant distance: all blocks of the
+// following accesses are predicted, and nothing in between
+//------------------------------------------------------------------------------
+void AccessPatternTest::WideStrideTest()
+{
+  AccessPattern ap;
+
+  // Blocks 0-2, 10-12, 20-22, ...
+  for( int i = 0; i < 8; ++i )
+    ap.Observe( 10 * i, 10 * i + 2 );
+  CPPUNIT_ASSERT( ap.IsKnown() );
+
+  int window = ap.Window( maxBlocks );
+  CPPUNIT_ASSERT( window >= 6 );
+  CPPUNIT_ASSERT_EQUAL( 0, window % 3 );
+
+  for( int n = 1; n <= window; ++n )
+  {
+    int access = ( n - 1 ) / 3 + 8;
+    CPPUNIT_ASSERT_EQUAL( 10 * access + ( n - 1 ) % 3, ap.Predict( n ) );
+  }
+}
+
+//------------------------------------------------------------------------------
+// Jumping around leaves nothing worth prefetching
+//------------------------------------------------------------------------------
+void AccessPatternTest::RandomTest()
+{
+  static const int blocks[] = { 500, 17, 260, 3, 900, 41, 777, 120, 64, 333 };
+  AccessPattern ap;
+
+  for( size_t i = 0; i < sizeof( blocks ) / sizeof( blocks[0] ); ++i )
+    ap.Observe( blocks[i], blocks[i] );
+  CPPUNIT_ASSERT( ap.IsKnown() );
+  CPPUNIT_ASSERT_EQUAL( 0, ap.Window( maxBlocks ) );
+}
+
+//------------------------------------------------------------------------------
+// A file that turns random has its window closed, which idles its prefetch,
+// and reopened once it is read in order again, which resumes it
+//------------------------------------------------------------------------------
+void AccessPatternTest::IdleTest()
+{
+  AccessPattern ap;
+
+  for( int i = 0; i < 8; ++i )
+    ap.Observe( i, i );
+  CPPUNIT_ASSERT( ap.Window( maxBlocks ) > 0 );
+
+  ap.Observe( 2, 2 );
+  ap.Observe( 100, 100 );
+  ap.Observe( 50, 50 );
+  ap.Observe( 400, 400 );
+  ap.Observe( 20, 20 );
+  CPPUNIT_ASSERT_EQUAL( 0, ap.Window( maxBlocks ) );
+
+  ap.Observe( 21, 21 );
+  CPPUNIT_ASSERT( ap.Window( maxBlocks ) > 0 );
+  CPPUNIT_ASSERT_EQUAL( 22, ap.Predict( 1 ) );
+}
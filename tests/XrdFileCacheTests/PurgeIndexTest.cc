@@ -0,0 +1,176 @@
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+#include <cppunit/extensions/HelperMacros.h>
+#include "XrdFileCache/XrdFileCachePurgeIndex.hh"
+#include "XrdSys/XrdSysTrace.hh"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace XrdFileCache;
+
+//------------------------------------------------------------------------------
+// Declaration
+//------------------------------------------------------------------------------
+class PurgeIndexTest: public CppUnit::TestCase
+{
+  public:
+    CPPUNIT_TEST_SUITE( PurgeIndexTest );
+      CPPUNIT_TEST( ReloadTest );
+      CPPUNIT_TEST( TornRecordTest );
+      CPPUNIT_TEST( CompactTest );
+    CPPUNIT_TEST_SUITE_END();
+    void setUp();
+    void tearDown();
+    void ReloadTest();
+    void TornRecordTest();
+    void CompactTest();
+
+  private:
+    std::string JournalPath();
+    XrdSysTrace  *pTrace;
+    char          pDir[64];
+};
+CPPUNIT_TEST_SUITE_REGISTRATION( PurgeIndexTest );
+
+//------------------------------------------------------------------------------
+// Set up a scratch directory for the journal
+//------------------------------------------------------------------------------
+void PurgeIndexTest::setUp()
+{
+  strcpy( pDir, "/tmp/PurgeIndexTest.XXXXXX" );
+  CPPUNIT_ASSERT( mkdtemp( pDir ) != 0 );
+  pTrace = new XrdSysTrace( "PurgeIndexTest" );
+}
+
+void PurgeIndexTest::tearDown()
+{
+  std::string path = JournalPath();
+  unlink( path.c_str() );
+  unlink( ( path + ".tmp" ).c_str() );
+  rmdir( pDir );
+  delete pTrace;
+}
+
+std::string PurgeIndexTest::JournalPath()
+{
+  return std::string( pDir ) + "/purge.journal";
+}
+
+//------------------------------------------------------------------------------
+// Updates and removals survive a reload in LRU order
+//------------------------------------------------------------------------------
+void PurgeIndexTest::ReloadTest()
+{
+  {
+    PurgeIndex idx( pTrace, JournalPath() );
+    CPPUNIT_ASSERT( !idx.Load() );
+    idx.Compact( true );
+    idx.Update( "/a.cinfo", 300, 30 );
+    idx.Update( "/b.cinfo", 100, 10 );
+    idx.Update( "/c.cinfo", 200, 20 );
+    idx.Update( "/b.cinfo", 400, 40 );
+    idx.Remove( "/c.cinfo" );
+  }
+
+  PurgeIndex idx( pTrace, JournalPath() );
+  CPPUNIT_ASSERT( idx.Load() );
+  CPPUNIT_ASSERT_EQUAL( (size_t) 2, idx.Size() );
+
+  std::vector<PurgeIndex::Entry> victims;
+  idx.GetOldest( 1000, victims );
+  CPPUNIT_ASSERT_EQUAL( (size_t) 2, victims.size() );
+  CPPUNIT_ASSERT_EQUAL( std::string( "/a.cinfo" ), victims[0].path );
+  CPPUNIT_ASSERT_EQUAL( 30LL, victims[0].nByte );
+  CPPUNIT_ASSERT_EQUAL( std::string( "/b.cinfo" ), victims[1].path );
+  CPPUNIT_ASSERT_EQUAL( 40LL, victims[1].nByte );
+}
+
+//------------------------------------------------------------------------------
+// A record torn in the middle is dropped and the records appended after the
+// reload are not glued onto it
+//------------------------------------------------------------------------------
+void PurgeIndexTest::TornRecordTest()
+{
+  {
+    PurgeIndex idx( pTrace, JournalPath() );
+    CPPUNIT_ASSERT( !idx.Load() );
+    idx.Compact( true );
+    idx.Update( "/a/b/file1.cinfo", 100, 10 );
+    idx.Update( "/a/b/file2.cinfo", 200, 20 );
+    idx.Remove( "/a/b/file1.cinfo" );
+  }
+
+  // Cut the journal in the middle of the removal
+  struct stat st;
+  CPPUNIT_ASSERT( stat( JournalPath().c_str(), &st ) == 0 );
+  off_t size = st.st_size - strlen( "le1.cinfo\n" );
+  CPPUNIT_ASSERT( truncate( JournalPath().c_str(), size ) == 0 );
+
+  {
+    PurgeIndex idx( pTrace, JournalPath() );
+    CPPUNIT_ASSERT( idx.Load() );
+    CPPUNIT_ASSERT_EQUAL( (size_t) 2, idx.Size() );
+    CPPUNIT_ASSERT( stat( JournalPath().c_str(), &st ) == 0 );
+    CPPUNIT_ASSERT( st.st_size < size );
+    idx.Update( "/x.cinfo", 300, 30 );
+  }
+
+  PurgeIndex idx( pTrace, JournalPath() );
+  CPPUNIT_ASSERT( idx.Load() );
+  CPPUNIT_ASSERT_EQUAL( (size_t) 3, idx.Size() );
+
+  std::vector<PurgeIndex::Entry> victims;
+  idx.GetOldest( 1000, victims );
+  CPPUNIT_ASSERT_EQUAL( (size_t) 3, victims.size() );
+  CPPUNIT_ASSERT_EQUAL( std::string( "/a/b/file1.cinfo" ), victims[0].path );
+  CPPUNIT_ASSERT_EQUAL( std::string( "/a/b/file2.cinfo" ), victims[1].path );
+  CPPUNIT_ASSERT_EQUAL( std::string( "/x.cinfo" ), victims[2].path );
+}
+
+//------------------------------------------------------------------------------
+// A compacted journal holds the same index
+//------------------------------------------------------------------------------
+void PurgeIndexTest::CompactTest()
+{
+  {
+    PurgeIndex idx( pTrace, JournalPath() );
+    CPPUNIT_ASSERT( !idx.Load() );
+    idx.Compact( true );
+    for( int i = 0; i < 100; ++i )
+    {
+      char path[32];
+      snprintf( path, sizeof( path ), "/f%d.cinfo", i % 10 );
+      idx.Update( path, 1000 + i, i );
+    }
+    idx.Compact( true );
+    idx.Remove( "/f0.cinfo" );
+  }
+
+  PurgeIndex idx( pTrace, JournalPath() );
+  CPPUNIT_ASSERT( idx.Load() );
+  CPPUNIT_ASSERT_EQUAL( (size_t) 9, idx.Size() );
+
+  std::vector<PurgeIndex::Entry> victims;
+  idx.GetOldest( 1, victims );
+  CPPUNIT_ASSERT_EQUAL( (size_t) 1, victims.size() );
+  CPPUNIT_ASSERT_EQUAL( std::string( "/f1.cinfo" ), victims[0].path );
+  CPPUNIT_ASSERT_EQUAL( 91LL, victims[0].nByte );
+}
@@ -0,0 +1,158 @@
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+#include <cppunit/extensions/HelperMacros.h>
+#include "XrdOfs/XrdOfsHandle.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+//------------------------------------------------------------------------------
+// Declaration
+//------------------------------------------------------------------------------
+class OfsHandleTest: public CppUnit::TestCase
+{
+  public:
+    CPPUNIT_TEST_SUITE( OfsHandleTest );
+      CPPUNIT_TEST( ShareTest );
+      CPPUNIT_TEST( HideTest );
+      CPPUNIT_TEST( ConcurrencyTest );
+    CPPUNIT_TEST_SUITE_END();
+    void ShareTest();
+    void HideTest();
+    void ConcurrencyTest();
+};
+CPPUNIT_TEST_SUITE_REGISTRATION( OfsHandleTest );
+
+//------------------------------------------------------------------------------
+// Opens of the same path in the same mode share the handle, r/o and r/w
+// opens do not
+//------------------------------------------------------------------------------
+void OfsHandleTest::ShareTest()
+{
+  XrdOfsHandle *h1, *h2, *h3;
+  int retc;
+
+  CPPUNIT_ASSERT_EQUAL( 0, XrdOfsHandle::Alloc( "/share/file", 0, &h1 ) );
+  CPPUNIT_ASSERT_EQUAL( std::string( "/share/file" ), std::string( h1->Name() ) );
+  CPPUNIT_ASSERT_EQUAL( 1, h1->Usage() );
+  h1->UnLock();
+
+  CPPUNIT_ASSERT_EQUAL( 0, XrdOfsHandle::Alloc( "/share/file", 0, &h2 ) );
+  CPPUNIT_ASSERT( h1 == h2 );
+  CPPUNIT_ASSERT_EQUAL( 2, h2->Usage() );
+  h2->UnLock();
+
+  CPPUNIT_ASSERT_EQUAL( 0, XrdOfsHandle::Alloc( "/share/file",
+                                                XrdOfsHandle::opRW, &h3 ) );
+  CPPUNIT_ASSERT( h3 != h1 );
+  CPPUNIT_ASSERT_EQUAL( 1, h3->Usage() );
+  CPPUNIT_ASSERT_EQUAL( 0, h3->Retire( retc ) );
+
+  h1->Lock();
+  CPPUNIT_ASSERT_EQUAL( 1, h1->Retire( retc ) );
+  h2->Lock();
+  CPPUNIT_ASSERT_EQUAL( 0, h2->Retire( retc ) );
+}
+
+//------------------------------------------------------------------------------
+// A hidden handle is no longer found by later opens
+//------------------------------------------------------------------------------
+void OfsHandleTest::HideTest()
+{
+  XrdOfsHandle *h1, *h2;
+  int retc;
+
+  CPPUNIT_ASSERT_EQUAL( 0, XrdOfsHandle::Alloc( "/hide/file", 0, &h1 ) );
+  h1->UnLock();
+  XrdOfsHandle::Hide( "/hide/file" );
+
+  CPPUNIT_ASSERT_EQUAL( 0, XrdOfsHandle::Alloc( "/hide/file", 0, &h2 ) );
+  CPPUNIT_ASSERT( h1 != h2 );
+  CPPUNIT_ASSERT_EQUAL( 1, h2->Usage() );
+  CPPUNIT_ASSERT_EQUAL( 0, h2->Retire( retc ) );
+
+  h1->Lock();
+  CPPUNIT_ASSERT_EQUAL( 0, h1->Retire( retc ) );
+}
+
+//------------------------------------------------------------------------------
+// Threads open and close their own files as well as files they all share;
+// every open must find the right file and every handle must be released
+//------------------------------------------------------------------------------
+namespace
+{
+  const int nThreads = 8;
+  const int nFiles   = 64;
+  const int nIters   = 20000;
+
+  struct ThreadArgs
+  {
+    int       tNum;
+    int       nBad;
+    pthread_t tid;
+  };
+
+  void *OpenClose( void *arg )
+  {
+    ThreadArgs   *args = (ThreadArgs*)arg;
+    XrdOfsHandle *hP;
+    char          path[64];
+    int           retc;
+
+    for( int i = 0; i < nIters; ++i )
+    {
+      if( i & 2 ) snprintf( path, sizeof( path ), "/shared/file%d", i % nFiles );
+      else snprintf( path, sizeof( path ), "/t%d/file%d", args->tNum, i % nFiles );
+      int opts = ( i & 1 ? XrdOfsHandle::opRW : 0 );
+      if( XrdOfsHandle::Alloc( path, opts, &hP ) ) { args->nBad++; continue; }
+      if( strcmp( hP->Name(), path ) ) args->nBad++;
+      hP->Retire( retc );
+    }
+    return 0;
+  }
+}
+
+void OfsHandleTest::ConcurrencyTest()
+{
+  ThreadArgs args[nThreads];
+
+  for( int i = 0; i < nThreads; ++i )
+  {
+    args[i].tNum = i;
+    args[i].nBad = 0;
+    CPPUNIT_ASSERT_EQUAL( 0, XrdSysThread::Run( &args[i].tid, OpenClose,
+                                                &args[i], XRDSYSTHREAD_HOLD,
+                                                "OfsHandleTest" ) );
+  }
+
+  int nBad = 0;
+  for( int i = 0; i < nThreads; ++i )
+  {
+    XrdSysThread::Join( args[i].tid, 0 );
+    nBad += args[i].nBad;
+  }
+  CPPUNIT_ASSERT_EQUAL( 0, nBad );
+
+  // Everything was closed, so a new open starts from scratch
+  XrdOfsHandle *hP;
+  int retc;
+  CPPUNIT_ASSERT_EQUAL( 0, XrdOfsHandle::Alloc( "/shared/file0", 0, &hP ) );
+  CPPUNIT_ASSERT_EQUAL( 1, hP->Usage() );
+  CPPUNIT_ASSERT_EQUAL( 0, hP->Retire( retc ) );
+}
@@ -0,0 +1,126 @@
+/******************************************************************************/
+/*                                                                            */
+/*                  X r d O f s H a n d l e B e n c h . c c                   */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+// File handle table micro-benchmark. Increasing numbers of threads open and
+// close files as fast as they can, as jobs opening many small files would,
+// and the open/close rate is reported to show how the tables scale.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "XrdBench.hh"
+
+#include "XrdOfs/XrdOfsHandle.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+/******************************************************************************/
+/*                          L o c a l   S t a t i c s                         */
+/******************************************************************************/
+  
+namespace
+{
+const char *MeMe = "xrdofshandlebench: ";
+int         nFiles = 64;   // Distinct files opened by each thread
+int         nIters = 200000;
+int         nErrs  = 0;
+
+XrdSysMutex errMutex;
+
+/******************************************************************************/
+/*                                W o r k e r                                 */
+/******************************************************************************/
+
+// Each thread repeatedly opens and closes its own set of files. Files
+// alternate between r/o and r/w handles.
+//
+void Worker(int tNum, int nThreads, void *arg)
+{
+   XrdOfsHandle *hP;
+   char **pTab = new char *[nFiles];
+   int i, retc, bad = 0;
+
+   for (i = 0; i < nFiles; i++)
+       {char buff[128];
+        snprintf(buff, sizeof(buff), "/store/t%d/file%d.root", tNum, i);
+        pTab[i] = strdup(buff);
+       }
+
+   for (i = 0; i < nIters; i++)
+       {const char *path = pTab[i % nFiles];
+        int opts = (i & 1 ? XrdOfsHandle::opRW : 0);
+        if (XrdOfsHandle::Alloc(path, opts, &hP)) {bad++; continue;}
+        hP->Retire(retc);
+       }
+
+   for (i = 0; i < nFiles; i++) free(pTab[i]);
+   delete [] pTab;
+
+   if (bad) {errMutex.Lock(); nErrs += bad; errMutex.UnLock();}
+}
+
+void Usage(int rc)
+{
+   fprintf(stderr, "Usage: xrdofshandlebench [-f <files>] [-n <iterations>] "
+                   "[-t <maxthreads>]\n");
+   exit(rc);
+}
+}
+
+/******************************************************************************/
+/*                                  m a i n                                   */
+/******************************************************************************/
+  
+int main(int argc, char **argv)
+{
+   double rate, base = 0;
+   int c, n, maxThreads = 16;
+
+// Process the options
+//
+   while((c = getopt(argc, argv, "f:hn:t:")) != -1)
+        {switch(c)
+               {case 'f': nFiles = atoi(optarg); break;
+                case 'n': nIters = atoi(optarg); break;
+                case 't': maxThreads = atoi(optarg); break;
+                case 'h': Usage(0);
+                default:  Usage(1);
+               }
+        }
+   if (nFiles <= 0 || nIters <= 0 || maxThreads <= 0) Usage(1);
+
+// Time open/close pairs for increasing numbers of threads
+//
+   printf("%8s %14s %8s\n", "threads", "open+close/s", "scale");
+   for (n = 1; n <= maxThreads; n *= 2)
+       {rate = (double)nIters * n / XrdBench::RunThreads(MeMe, n, Worker);
+        if (n == 1) base = rate;
+        printf("%8d %14.0f %7.2fx\n", n, rate, rate/base);
+       }
+
+   if (nErrs) {fprintf(stderr, "%s%d opens failed.\n", MeMe, nErrs); return 1;}
+   return 0;
+}
@@ -0,0 +1,116 @@
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+#include <cppunit/extensions/HelperMacros.h>
+#include "XrdSut/XrdSutCache.hh"
+
+#include <stdio.h>
+
+//------------------------------------------------------------------------------
+// Declaration
+//------------------------------------------------------------------------------
+class SutCacheTest: public CppUnit::TestCase
+{
+  public:
+    CPPUNIT_TEST_SUITE( SutCacheTest );
+      CPPUNIT_TEST( TrimTest );
+      CPPUNIT_TEST( TrimLockedTest );
+    CPPUNIT_TEST_SUITE_END();
+    void TrimTest();
+    void TrimLockedTest();
+};
+CPPUNIT_TEST_SUITE_REGISTRATION( SutCacheTest );
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // Keep the entries modified at or after the given time
+  //----------------------------------------------------------------------------
+  bool Recent( XrdSutCacheEntry *cent, void *arg )
+  {
+    return cent->mtime >= *static_cast<kXR_int32*>( arg );
+  }
+
+  bool Never( XrdSutCacheEntry *, void * )
+  {
+    return false;
+  }
+
+  void Fill( XrdSutCache &cache, int n )
+  {
+    char tag[32];
+    bool rdlock;
+    for( int i = 0; i < n; ++i )
+    {
+      snprintf( tag, sizeof( tag ), "entry%d", i );
+      XrdSutCacheEntry *cent = cache.Get( tag, rdlock );
+      CPPUNIT_ASSERT( cent && !rdlock );
+      cent->mtime = i;
+      cent->rwmtx.UnLock();
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Entries failing the condition go, the others stay
+//------------------------------------------------------------------------------
+void SutCacheTest::TrimTest()
+{
+  XrdSutCache cache;
+  kXR_int32 since = 600;
+  char tag[32];
+
+  Fill( cache, 1000 );
+  CPPUNIT_ASSERT_EQUAL( 1000, cache.Num() );
+  CPPUNIT_ASSERT_EQUAL( 600, cache.Trim( Recent, &since ) );
+  CPPUNIT_ASSERT_EQUAL( 400, cache.Num() );
+
+  for( int i = 0; i < 1000; ++i )
+  {
+    snprintf( tag, sizeof( tag ), "entry%d", i );
+    XrdSutCacheEntry *cent = cache.Get( tag );
+    CPPUNIT_ASSERT( ( cent != 0 ) == ( i >= since ) );
+    if( cent )
+    {
+      CPPUNIT_ASSERT_EQUAL( (kXR_int32)i, cent->mtime );
+      cent->rwmtx.UnLock();
+    }
+  }
+
+  // Nothing more to trim
+  CPPUNIT_ASSERT_EQUAL( 0, cache.Trim( Recent, &since ) );
+  CPPUNIT_ASSERT_EQUAL( 400, cache.Num() );
+}
+
+//------------------------------------------------------------------------------
+// Entries someone holds a lock on are left alone
+//------------------------------------------------------------------------------
+void SutCacheTest::TrimLockedTest()
+{
+  XrdSutCache cache;
+
+  Fill( cache, 100 );
+  XrdSutCacheEntry *held = cache.Get( "entry42" );
+  CPPUNIT_ASSERT( held );
+
+  CPPUNIT_ASSERT_EQUAL( 99, cache.Trim( Never ) );
+  CPPUNIT_ASSERT_EQUAL( 1, cache.Num() );
+  CPPUNIT_ASSERT_EQUAL( (kXR_int32)42, held->mtime );
+
+  held->rwmtx.UnLock();
+  CPPUNIT_ASSERT_EQUAL( 1, cache.Trim( Never ) );
+  CPPUNIT_ASSERT_EQUAL( 0, cache.Num() );
+}
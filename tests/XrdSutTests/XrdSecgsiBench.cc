@@ -0,0 +1,280 @@
+/******************************************************************************/
+/*                                                                            */
+/*                     X r d S e c g s i B e n c h . c c                      */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+// Login storm benchmark for the gsi security protocol. A client process logs
+// in over and over with the same proxy, as many jobs of one user would do,
+// and the server process reports the CPU it spent per login. Run it once with
+// the default options and once with "-vfyto:0" in the server options to see
+// what the verified chains cache saves.
+
+#include <dlfcn.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+#include "XrdBench.hh"
+
+#include "XrdNet/XrdNetAddr.hh"
+#include "XrdOuc/XrdOucErrInfo.hh"
+#include "XrdSec/XrdSecInterface.hh"
+
+/******************************************************************************/
+/*                       G l o b a l   V a r i a b l e s                      */
+/******************************************************************************/
+
+namespace
+{
+typedef char           *(*secInit_t)(const char, const char *, XrdOucErrInfo *);
+typedef XrdSecProtocol *(*secObj_t)(const char, const char *, XrdNetAddrInfo &,
+                                    const char *, XrdOucErrInfo *);
+
+const char *MeMe = "xrdsecgsibench: ";
+const char *Host = "localhost";
+
+secInit_t   secInit;
+secObj_t    secObj;
+
+/******************************************************************************/
+/*                       M e s s a g e   E x c h a n g e                      */
+/******************************************************************************/
+
+// Messages are a status code followed by the length and the bytes of a
+// credentials or parameters buffer.
+//
+bool Send(int fd, int code, const char *data, int dlen)
+{
+   int hdr[2] = {code, dlen};
+
+   if (write(fd, hdr, sizeof(hdr)) != (ssize_t)sizeof(hdr)
+   ||  (dlen > 0 && write(fd, data, dlen) != dlen)) return false;
+   return true;
+}
+
+bool ReadAll(int fd, char *buff, int blen)
+{
+   ssize_t n;
+
+   while(blen > 0)
+        {if ((n = read(fd, buff, blen)) <= 0)
+            {if (n < 0 && errno == EINTR) continue;
+             return false;
+            }
+         buff += n; blen -= n;
+        }
+   return true;
+}
+
+char *Recv(int fd, int &code, int &dlen)
+{
+   int hdr[2];
+   char *data;
+
+   if (!ReadAll(fd, (char *)hdr, sizeof(hdr))) return 0;
+   code = hdr[0]; dlen = hdr[1];
+   data = (char *)malloc(dlen+1);
+   if (dlen > 0 && !ReadAll(fd, data, dlen)) {free(data); return 0;}
+   data[dlen] = 0;
+   return data;
+}
+
+/******************************************************************************/
+/*                                C l i e n t                                 */
+/******************************************************************************/
+
+int Client(int fd, int logins)
+{
+   XrdOucErrInfo einfo;
+   XrdNetAddr    addr;
+   XrdSecProtocol *prot;
+   XrdSecCredentials *cred;
+   XrdSecParameters *parm;
+   char *token, *data;
+   int code, dlen;
+
+// Get the server token and initialize the client side
+//
+   if (!(token = Recv(fd, code, dlen))) return 1;
+   if (!secInit('c', 0, &einfo))
+      {fprintf(stderr, "%sclient init failed: %s\n", MeMe, einfo.getErrText());
+       return 1;
+      }
+   addr.Set(Host, 1094);
+
+// Log in as many times as wanted
+//
+   for (int i = 0; i < logins; i++)
+       {if (!(prot = secObj('c', Host, addr, token, &einfo)))
+           {fprintf(stderr, "%sno client protocol: %s\n", MeMe,
+                            einfo.getErrText());
+            return 1;
+           }
+        parm = 0;
+        do {cred = prot->getCredentials(parm, &einfo);
+            delete parm; parm = 0;
+            if (!cred)
+               {fprintf(stderr, "%sgetCredentials failed: %s\n", MeMe,
+                                einfo.getErrText());
+                return 1;
+               }
+            Send(fd, 0, cred->buffer, cred->size);
+            delete cred;
+            if (!(data = Recv(fd, code, dlen))) return 1;
+            if (code > 0) parm = new XrdSecParameters(data, dlen);
+               else free(data);
+           } while(code > 0);
+        prot->Delete();
+        if (code < 0) return 1;
+       }
+   return 0;
+}
+
+/******************************************************************************/
+/*                                S e r v e r                                 */
+/******************************************************************************/
+
+int Server(int fd, const char *parms, int logins)
+{
+   XrdOucErrInfo einfo;
+   XrdNetAddr    addr;
+   XrdSecProtocol *prot;
+   XrdSecCredentials *cred;
+   XrdSecParameters *parm;
+   double cpu0, cpu1, wall0, firstCPU = 0, restCPU = 0;
+   char *token, *data;
+   int code, dlen, rc;
+
+// Initialize the server side and pass the token to the client
+//
+   if (!(token = secInit('s', parms, &einfo)))
+      {fprintf(stderr, "%sserver init failed: %s\n", MeMe, einfo.getErrText());
+       return 1;
+      }
+   Send(fd, 0, token, strlen(token));
+   addr.Set(Host, 1094);
+
+// Serve the logins, timing each one
+//
+   wall0 = XrdBench::Now();
+   for (int i = 0; i < logins; i++)
+       {if (!(prot = secObj('s', Host, addr, 0, &einfo))) return 1;
+        cpu0 = XrdBench::CPUms();
+        do {if (!(data = Recv(fd, code, dlen))) return 1;
+            cred = new XrdSecCredentials(data, dlen);
+            parm = 0;
+            rc = prot->Authenticate(cred, &parm, &einfo);
+            delete cred;
+            if (rc > 0) Send(fd, 1, parm->buffer, parm->size);
+               else if (!rc) Send(fd, 0, 0, 0);
+                       else {fprintf(stderr, "%slogin %d failed: %s\n", MeMe,
+                                     i, einfo.getErrText());
+                             Send(fd, -1, 0, 0);
+                            }
+            delete parm;
+           } while(rc > 0);
+        cpu1 = XrdBench::CPUms();
+        prot->Delete();
+        if (rc < 0) return 1;
+        if (!i) firstCPU = cpu1 - cpu0;
+           else restCPU += cpu1 - cpu0;
+       }
+
+   printf("logins %d in %.1f ms; server CPU first %.3f ms, then %.3f ms "
+          "per login\n", logins, (XrdBench::Now() - wall0)*1000.0, firstCPU,
+          (logins > 1 ? restCPU/(logins-1) : 0.0));
+   return 0;
+}
+
+/******************************************************************************/
+/*                                 U s a g e                                  */
+/******************************************************************************/
+
+void Usage(int rc)
+{
+   fprintf(stderr, "Usage: xrdsecgsibench [-l <libXrdSecgsi>] [-n <logins>] "
+                   "-s '<server options>'\n\n"
+          "The client takes its proxy and CA directory from the usual "
+          "XrdSecGSI* envars;\nthe server certificate must be issued to "
+          "'%s'. For instance:\n\n"
+          "  XrdSecGSICADIR=/tmp/certs XrdSecGSIUSERPROXY=/tmp/x509up "
+          "xrdsecgsibench \\\n    -s '-certdir:/tmp/certs -cert:/tmp/host.pem "
+          "-key:/tmp/host.key -gmapopt:0'\n", Host);
+   exit(rc);
+}
+}
+
+/******************************************************************************/
+/*                                  m a i n                                   */
+/******************************************************************************/
+
+int main(int argc, char **argv)
+{
+   const char *lib = "libXrdSecgsi-4.so", *parms = 0;
+   void *libHandle;
+   int  c, logins = 1000, fds[2], rc, status;
+   pid_t pid;
+
+// Process the options
+//
+   while((c = getopt(argc, argv, "hl:n:s:")) != -1)
+        {switch(c)
+               {case 'l': lib = optarg; break;
+                case 'n': logins = atoi(optarg); break;
+                case 's': parms = optarg; break;
+                case 'h': Usage(0);
+                default:  Usage(1);
+               }
+        }
+   if (!parms || logins <= 0) Usage(1);
+
+// Load the protocol
+//
+   if (!(libHandle = dlopen(lib, RTLD_NOW))
+   ||  !(secInit = (secInit_t)dlsym(libHandle, "XrdSecProtocolgsiInit"))
+   ||  !(secObj  = (secObj_t) dlsym(libHandle, "XrdSecProtocolgsiObject")))
+      {fprintf(stderr, "%sunable to load %s: %s\n", MeMe, lib, dlerror());
+       return 1;
+      }
+
+// Client and server keep their settings in static members, so each must run
+// in its own process.
+//
+   if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds))
+      {perror("socketpair"); return 1;}
+   if ((pid = fork()) < 0) {perror("fork"); return 1;}
+   if (!pid)
+      {close(fds[0]);
+       _exit(Client(fds[1], logins));
+      }
+   close(fds[1]);
+   rc = Server(fds[0], parms, logins);
+   close(fds[0]);
+   if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status)
+   ||  WEXITSTATUS(status)) rc = 1;
+   return rc;
+}
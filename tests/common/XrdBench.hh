@@ -0,0 +1,106 @@
+#ifndef __XRDBENCH_HH__
+#define __XRDBENCH_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                           X r d B e n c h . h h                            */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+
+#include "XrdSys/XrdSysPthread.hh"
+
+/* Helpers shared by the micro-benchmarks under tests. The benchmarks are
+   standalone programs that are only built when ENABLE_BENCHMARKS is set; they
+   are neither installed nor run by ctest. Correctness checks belong in the
+   unit tests next to them.
+*/
+
+namespace XrdBench
+{
+// Wall clock time in seconds
+//
+inline double Now()
+{
+   struct timeval tv;
+   gettimeofday(&tv, 0);
+   return tv.tv_sec + tv.tv_usec/1000000.0;
+}
+
+// CPU time used by this process in milliseconds
+//
+inline double CPUms()
+{
+   struct rusage ru;
+
+   getrusage(RUSAGE_SELF, &ru);
+   return ru.ru_utime.tv_sec*1000.0 + ru.ru_utime.tv_usec/1000.0
+        + ru.ru_stime.tv_sec*1000.0 + ru.ru_stime.tv_usec/1000.0;
+}
+
+// Run work(tNum, nThreads, arg) in nThreads threads at once and return the
+// elapsed wall clock time in seconds. A thread that can't be started ends the
+// program.
+//
+typedef void (*Work_t)(int tNum, int nThreads, void *arg);
+
+struct ThrArgs
+{
+Work_t    work;
+void     *arg;
+int       tNum;
+int       nThreads;
+pthread_t tid;
+};
+
+inline void *Worker(void *parg)
+{
+   ThrArgs *aP = (ThrArgs *)parg;
+   aP->work(aP->tNum, aP->nThreads, aP->arg);
+   return (void *)0;
+}
+
+inline double RunThreads(const char *who, int nThreads, Work_t work, void *arg=0)
+{
+   ThrArgs *tArgs = new ThrArgs[nThreads];
+   double tBeg = Now();
+   int i;
+
+   for (i = 0; i < nThreads; i++)
+       {tArgs[i].work = work; tArgs[i].arg = arg;
+        tArgs[i].tNum = i;    tArgs[i].nThreads = nThreads;
+        if (XrdSysThread::Run(&tArgs[i].tid, Worker, &tArgs[i],
+                              XRDSYSTHREAD_HOLD, "bench"))
+           {fprintf(stderr, "%sunable to start thread %d\n", who, i);
+            exit(2);
+           }
+       }
+   for (i = 0; i < nThreads; i++) XrdSysThread::Join(tArgs[i].tid, 0);
+
+   delete [] tArgs;
+   return Now() - tBeg;
+}
+}
+#endif